@@ -0,0 +1,123 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <lol/Image.hpp>
+#include <lol/Transformable.hpp>
+#include <lol/buffers/VertexBuffer.hpp>
+#include <lol/util/ObjectManager.hpp>
+
+// Moving, rotating and scaling an object recalculates its transformation matrix every time
+static void BM_TransformableUpdate(benchmark::State& state)
+{
+	lol::Transformable transformable;
+	float angle = 0.0f;
+
+	for (auto _ : state)
+	{
+		transformable.Move(glm::vec3(0.01f, 0.0f, -0.01f));
+		transformable.Rotate(glm::vec3(0.0f, 1.0f, 0.0f), angle);
+		transformable.SetScale(glm::vec3(1.0f + angle * 0.001f));
+		angle += 0.01f;
+
+		benchmark::DoNotOptimize(transformable.GetPosition());
+	}
+
+	state.SetItemsProcessed(state.iterations() * 3);
+}
+BENCHMARK(BM_TransformableUpdate);
+
+// A typical vertex layout: position, normal, texture coordinates and a color
+static void BM_BufferLayout(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		lol::BufferLayout layout = {
+			lol::VertexAttribute(lol::Type::Float, 3, false),
+			lol::VertexAttribute(lol::Type::Float, 3, false),
+			lol::VertexAttribute(lol::Type::Float, 2, false),
+			lol::VertexAttribute(lol::Type::UByte, 4, true)
+		};
+
+		benchmark::DoNotOptimize(layout.GetStride());
+	}
+}
+BENCHMARK(BM_BufferLayout);
+
+// Looking up existing objects, with as many objects in the manager as the argument
+static void BM_ObjectManagerGet(benchmark::State& state)
+{
+	const unsigned int count = (unsigned int)state.range(0);
+
+	lol::ObjectManager manager;
+	for (unsigned int id = 0; id < count; id++)
+		manager.Create<int>(id, (int)id);
+
+	unsigned int id = 0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(manager.Get<int>(id));
+		id = (id + 7919) % count;
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ObjectManagerGet)->Arg(16)->Arg(1024)->Arg(65536);
+
+// Encodes a run length compressed 24 bit TGA, so decoding doesn't depend on any file
+static std::vector<unsigned char> MakeTGA(unsigned int width, unsigned int height)
+{
+	std::vector<unsigned char> file = {
+		0, 0, 10,							// No ID, no color map, run length encoded true color
+		0, 0, 0, 0, 0,						// Color map specification
+		0, 0, 0, 0,							// Origin
+		(unsigned char)(width & 0xFF), (unsigned char)(width >> 8),
+		(unsigned char)(height & 0xFF), (unsigned char)(height >> 8),
+		24, 0								// Bits per pixel, descriptor
+	};
+
+	// Alternate between runs of one color and literal packets, like a mix of flat and noisy areas
+	uint32_t seed = 12345;
+	size_t pixels = (size_t)width * height;
+	for (size_t written = 0; written < pixels; )
+	{
+		seed = seed * 1664525u + 1013904223u;
+		size_t length = std::min<size_t>(1 + (seed >> 25), pixels - written);
+
+		if (seed & 0x100)
+		{
+			file.push_back((unsigned char)(0x80 | (length - 1)));
+			file.insert(file.end(), { (unsigned char)seed, (unsigned char)(seed >> 8), (unsigned char)(seed >> 16) });
+		}
+		else
+		{
+			file.push_back((unsigned char)(length - 1));
+			for (size_t i = 0; i < length; i++)
+			{
+				seed = seed * 1664525u + 1013904223u;
+				file.insert(file.end(), { (unsigned char)(seed >> 8), (unsigned char)(seed >> 16), (unsigned char)(seed >> 24) });
+			}
+		}
+
+		written += length;
+	}
+
+	return file;
+}
+
+static void BM_ImageDecode(benchmark::State& state)
+{
+	const unsigned int size = (unsigned int)state.range(0);
+	std::vector<unsigned char> file = MakeTGA(size, size);
+
+	for (auto _ : state)
+	{
+		lol::Image image(file.data(), file.size());
+		benchmark::DoNotOptimize(image.GetPixels());
+	}
+
+	state.SetBytesProcessed(state.iterations() * (int64_t)size * size * 3);
+}
+BENCHMARK(BM_ImageDecode)->Arg(256)->Arg(1024)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include <lol/util/JobSystem.hpp>
+
+// Runs a benchmark once for every thread count from 1 up to the number of hardware threads
+static void ThreadCounts(benchmark::internal::Benchmark* benchmark)
+{
+	unsigned int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+	for (unsigned int threads = 1; threads <= hardwareThreads; threads *= 2)
+		benchmark->Arg(threads);
+
+	if ((hardwareThreads & (hardwareThreads - 1)) != 0)
+		benchmark->Arg(hardwareThreads);
+}
+
+// A compute bound loop, roughly what transforming a large batch of vertices costs
+static void BM_ParallelFor(benchmark::State& state)
+{
+	const size_t count = 1 << 20;
+	std::vector<float> values(count, 1.0f);
+
+	// The calling thread helps out while waiting, so it counts as one of the threads
+	lol::JobSystem jobs((unsigned int)state.range(0) - 1);
+
+	for (auto _ : state)
+	{
+		jobs.ParallelFor(0, count, [&](size_t first, size_t last)
+		{
+			for (size_t i = first; i < last; i++)
+				values[i] = std::sqrt(values[i] * 1.0001f + 0.5f) * std::sin(values[i]);
+		});
+
+		benchmark::DoNotOptimize(values.data());
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ParallelFor)->Apply(ThreadCounts)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// Scheduling overhead: many jobs that do almost nothing
+static void BM_ForkJoin(benchmark::State& state)
+{
+	const size_t count = 10000;
+	lol::JobSystem jobs((unsigned int)state.range(0) - 1);
+
+	for (auto _ : state)
+	{
+		lol::JobGroup group;
+		for (size_t i = 0; i < count; i++)
+			jobs.Run(group, []() { benchmark::ClobberMemory(); });
+
+		jobs.Wait(group);
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ForkJoin)->Apply(ThreadCounts)->UseRealTime()->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,317 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <lol/lol.hpp>
+#include <lol/util/HeadlessContext.hpp>
+
+static const char* vertexShader = R"(
+#version 330 core
+layout (location = 0) in vec2 position;
+
+uniform vec2 offset;
+uniform float scale;
+
+out vec2 uv;
+
+void main()
+{
+	uv = position + 0.5;
+	gl_Position = vec4(position * scale + offset, 0.0, 1.0);
+}
+)";
+
+static const char* fragmentShader = R"(
+#version 330 core
+in vec2 uv;
+
+uniform sampler2D image;
+
+out vec4 color;
+
+void main()
+{
+	color = texture(image, uv);
+}
+)";
+
+// Creates the context and a 720p render target the first time it's called, and binds the target.
+// Returns false if there's no OpenGL driver, the benchmarks skip themselves then.
+static bool MakeRenderTarget()
+{
+	static std::unique_ptr<lol::HeadlessContext> context;
+	static std::unique_ptr<lol::Framebuffer> target;
+	static bool failed = false;
+
+	if (failed)
+		return false;
+
+	if (context == nullptr)
+	{
+		try
+		{
+			context = std::make_unique<lol::HeadlessContext>();
+		}
+		catch (const lol::HeadlessContextException&)
+		{
+			failed = true;
+			return false;
+		}
+
+		target = std::make_unique<lol::Framebuffer>(1280, 720);
+		target->Attach(lol::FramebufferAttachment::Color0, std::make_shared<lol::Renderbuffer>(1280, 720, lol::TextureFormat::RGBA8));
+	}
+
+	target->Bind();
+	return true;
+}
+
+// A textured quad somewhere on the screen
+class SceneQuad : public lol::Drawable
+{
+public:
+	SceneQuad(const std::shared_ptr<lol::Shader>& quadShader, const std::shared_ptr<lol::VertexArray>& quadVAO, lol::Texture2D& texture, const glm::vec2& offset) :
+		texture(texture), offset(offset)
+	{
+		shader = quadShader;
+		vao = quadVAO;
+
+		offsetLocation = shader->GetUniformLocation("offset");
+		scaleLocation = shader->GetUniformLocation("scale");
+	}
+
+	void PreRender(const lol::CameraBase& camera) override
+	{
+		glActiveTexture(GL_TEXTURE0);
+		texture.Bind();
+		shader->SetUniform("offset", offset);
+		shader->SetUniform("scale", 0.05f);
+	}
+
+	void PreRecord(lol::CommandBuffer& commands, const lol::CameraBase& camera) override
+	{
+		commands.BindTexture(texture, 0);
+		commands.SetUniform(offsetLocation, offset);
+		commands.SetUniform(scaleLocation, 0.05f);
+	}
+
+private:
+	lol::Texture2D& texture;
+	glm::vec2 offset;
+	int offsetLocation, scaleLocation;
+};
+
+// N quads spread over the screen, sampling from M textures in turn
+class Scene
+{
+public:
+	Scene(size_t drawables, size_t textures)
+	{
+		shader = std::make_shared<lol::Shader>(vertexShader, fragmentShader);
+		shader->Bind();
+		shader->SetUniform("image", 0);
+
+		std::shared_ptr<lol::VertexBuffer> vertices = std::make_shared<lol::VertexBuffer>(std::vector<float>{ -0.5f, -0.5f, 0.5f, -0.5f, 0.5f, 0.5f, -0.5f, 0.5f });
+		vertices->SetLayout({ lol::VertexAttribute(lol::Type::Float, 2, false) });
+		std::shared_ptr<lol::ElementBuffer> elements = std::make_shared<lol::ElementBuffer>(std::vector<unsigned int>{ 0, 1, 2, 0, 2, 3 });
+		vao = std::make_shared<lol::VertexArray>(vertices, elements);
+
+		for (size_t i = 0; i < textures; i++)
+		{
+			lol::Image image(64, 64, lol::PixelFormat::RGBA);
+			std::fill(image.GetPixels(), image.GetPixels() + image.GetPitch() * 64, (unsigned char)(i * 37));
+			this->textures.push_back(std::make_unique<lol::Texture2D>(image, lol::TextureFormat::RGBA));
+		}
+
+		for (size_t i = 0; i < drawables; i++)
+		{
+			glm::vec2 offset((float)(i % 37) / 18.0f - 1.0f, (float)(i % 29) / 14.0f - 1.0f);
+			quads.push_back(std::make_unique<SceneQuad>(shader, vao, *this->textures[i % textures], offset));
+			drawableList.push_back(quads.back().get());
+		}
+	}
+
+	void Draw()
+	{
+		for (lol::Drawable* drawable : drawableList)
+			drawable->Draw(camera);
+	}
+
+public:
+	lol::OrthogonalCamera camera;
+	std::vector<lol::Drawable*> drawableList;
+
+private:
+	std::shared_ptr<lol::Shader> shader;
+	std::shared_ptr<lol::VertexArray> vao;
+	std::vector<std::unique_ptr<lol::Texture2D>> textures;
+	std::vector<std::unique_ptr<SceneQuad>> quads;
+};
+
+// Reports the RenderStats of the last frame as counters, so they end up next to the timings
+static void ReportFrameStats(benchmark::State& state)
+{
+	lol::FrameStats stats = lol::RenderStats::Get().GetLastFrame();
+	state.counters["draws"] = (double)stats[lol::RenderCounter::DrawCalls];
+	state.counters["binds"] = (double)(stats[lol::RenderCounter::ShaderBinds] + stats[lol::RenderCounter::VertexArrayBinds] + stats[lol::RenderCounter::TextureBinds]);
+	state.counters["uniforms"] = (double)stats[lol::RenderCounter::UniformUpdates];
+}
+
+static void SceneSizes(benchmark::internal::Benchmark* benchmark)
+{
+	benchmark->ArgNames({ "drawables", "textures" });
+	for (int drawables : { 100, 1000, 10000 })
+		for (int textures : { 1, 16 })
+			benchmark->Args({ drawables, textures });
+}
+
+static void BM_SetUniform(benchmark::State& state)
+{
+	if (!MakeRenderTarget())
+	{
+		state.SkipWithError("Couldn't create an OpenGL context");
+		return;
+	}
+
+	lol::Shader shader(vertexShader, fragmentShader);
+	shader.Bind();
+
+	glm::vec2 offset(0.0f);
+	for (auto _ : state)
+	{
+		shader.SetUniform("offset", offset);
+		offset.x += 0.001f;
+	}
+
+	glFinish();
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SetUniform);
+
+// CPU cost of submitting a frame of draws, the GPU catches up outside the measured time
+static void BM_SceneSubmit(benchmark::State& state)
+{
+	if (!MakeRenderTarget())
+	{
+		state.SkipWithError("Couldn't create an OpenGL context");
+		return;
+	}
+
+	Scene scene((size_t)state.range(0), (size_t)state.range(1));
+	lol::RenderStats::Get().NewFrame();
+
+	for (auto _ : state)
+	{
+		scene.Draw();
+
+		state.PauseTiming();
+		glFinish();
+		lol::RenderStats::Get().NewFrame();
+		state.ResumeTiming();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	ReportFrameStats(state);
+}
+BENCHMARK(BM_SceneSubmit)->Apply(SceneSizes)->Unit(benchmark::kMicrosecond);
+
+// Whole frames including the GPU work, reported as frames per second
+static void BM_SceneFrame(benchmark::State& state)
+{
+	if (!MakeRenderTarget())
+	{
+		state.SkipWithError("Couldn't create an OpenGL context");
+		return;
+	}
+
+	Scene scene((size_t)state.range(0), (size_t)state.range(1));
+
+	for (auto _ : state)
+	{
+		glClear(GL_COLOR_BUFFER_BIT);
+		scene.Draw();
+		glFinish();
+
+		lol::RenderStats::Get().NewFrame();
+	}
+
+	state.counters["fps"] = benchmark::Counter((double)state.iterations(), benchmark::Counter::kIsRate);
+	ReportFrameStats(state);
+}
+BENCHMARK(BM_SceneFrame)->Apply(SceneSizes)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// The same frames, recorded in parallel into a CommandQueue and replayed
+static void BM_SceneCommandQueue(benchmark::State& state)
+{
+	if (!MakeRenderTarget())
+	{
+		state.SkipWithError("Couldn't create an OpenGL context");
+		return;
+	}
+
+	Scene scene((size_t)state.range(0), (size_t)state.range(1));
+	lol::CommandQueue queue;
+
+	for (auto _ : state)
+	{
+		glClear(GL_COLOR_BUFFER_BIT);
+		queue.Record(scene.drawableList, scene.camera, lol::JobSystem::Default());
+		queue.Execute();
+		glFinish();
+
+		lol::RenderStats::Get().NewFrame();
+	}
+
+	state.counters["fps"] = benchmark::Counter((double)state.iterations(), benchmark::Counter::kIsRate);
+	ReportFrameStats(state);
+}
+BENCHMARK(BM_SceneCommandQueue)->Apply(SceneSizes)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// The same kind of scene as BM_SceneFrame, but every quad is a sprite of one SpriteBatch
+static void BM_SpriteBatch(benchmark::State& state)
+{
+	if (!MakeRenderTarget())
+	{
+		state.SkipWithError("Couldn't create an OpenGL context");
+		return;
+	}
+
+	size_t count = (size_t)state.range(0);
+	std::vector<std::unique_ptr<lol::Texture2D>> textures;
+	for (int64_t i = 0; i < state.range(1); i++)
+	{
+		lol::Image image(64, 64, lol::PixelFormat::RGBA);
+		std::fill(image.GetPixels(), image.GetPixels() + image.GetPitch() * 64, (unsigned char)(i * 37));
+		textures.push_back(std::make_unique<lol::Texture2D>(image, lol::TextureFormat::RGBA));
+	}
+
+	lol::OrthogonalCamera camera;
+	lol::SpriteBatch batch;
+
+	for (auto _ : state)
+	{
+		glClear(GL_COLOR_BUFFER_BIT);
+
+		batch.Begin(camera);
+		lol::Sprite sprite;
+		sprite.size = glm::vec2(0.01f);
+		for (size_t i = 0; i < count; i++)
+		{
+			sprite.position = glm::vec2((float)(i % 211) / 105.0f - 1.0f, (float)(i % 197) / 98.0f - 1.0f);
+			sprite.rotation = (float)i * 0.01f;
+			sprite.layer = (int)(i % 4);
+			batch.Draw(*textures[i % textures.size()], sprite);
+		}
+		batch.End();
+		glFinish();
+
+		lol::RenderStats::Get().NewFrame();
+	}
+
+	state.counters["fps"] = benchmark::Counter((double)state.iterations(), benchmark::Counter::kIsRate);
+	state.counters["sprites"] = benchmark::Counter((double)(state.iterations() * count), benchmark::Counter::kIsRate);
+	ReportFrameStats(state);
+}
+BENCHMARK(BM_SpriteBatch)->ArgNames({ "sprites", "textures" })->ArgsProduct({ { 10000, 100000 }, { 1, 16 } })->UseRealTime()->Unit(benchmark::kMillisecond);
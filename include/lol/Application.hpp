@@ -0,0 +1,114 @@
+#pragma once
+
+#include <assert.h>
+#include <chrono>
+
+#include <lol/LayerStack.hpp>
+#include <lol/util/NonCopyable.hpp>
+
+namespace lol
+{
+	class CameraBase;
+
+	/**
+	 * @brief Runs the frame loop of an application
+	 *
+	 * Layers are updated with a fixed timestep, independent of the frame rate. Each frame
+	 * the elapsed time is accumulated, and as many updates are run as fit into it. The
+	 * remainder is passed to OnRender() as an interpolation factor, so layers can blend
+	 * between the previous and the current simulation state.
+	 *
+	 * Windowing is left to the subclass, it connects the loop to its window through
+	 * BeginFrame(), EndFrame() and ShouldClose().
+	 *
+	 * Constructing an Application enables the DeletionQueue, every frame ends with its
+	 * NewFrame().
+	 */
+	class Application : public NonCopyable
+	{
+	public:
+		/**
+		 * @brief Construct a new Application
+		 *
+		 * @param timestep Length of one update in seconds, greater than 0
+		 */
+		Application(float timestep = 1.0f / 60.0f);
+		virtual ~Application();
+
+		/**
+		 * @brief Run frames until Stop() is called or ShouldClose() returns `true`
+		 */
+		void Run();
+
+		/**
+		 * @brief Run a single frame
+		 *
+		 * Useful if the platform owns the loop (e.g. a browser).
+		 */
+		void RunFrame();
+
+		/**
+		 * @brief Make Run() return after the current frame
+		 */
+		inline void Stop() { running = false; }
+
+		inline LayerStack& GetLayerStack() { return layers; }
+
+		/**
+		 * @brief Change the length of one update
+		 *
+		 * @param timestep Length of one update in seconds, greater than 0
+		 */
+		inline void SetTimestep(float timestep)
+		{
+			assert(timestep > 0.0f && "lol::Application::SetTimestep() timestep must be greater than 0");
+			this->timestep = timestep;
+		}
+
+		inline float GetTimestep() const { return timestep; }
+
+		/**
+		 * @brief Limit the time a single frame can account for
+		 *
+		 * Without a limit a long stall (e.g. a breakpoint) would be followed by a burst
+		 * of updates that takes even longer, and the application would never catch up.
+		 *
+		 * @param seconds The maximum time per frame, 0.25s by default
+		 */
+		inline void SetMaxFrameTime(float seconds) { maxFrameTime = seconds; }
+
+	protected:
+		/**
+		 * @brief Called at the start of every frame, e.g. to poll window events
+		 */
+		virtual void BeginFrame() {}
+
+		/**
+		 * @brief Called at the end of every frame, e.g. to swap buffers
+		 */
+		virtual void EndFrame() {}
+
+		/**
+		 * @brief Checked before every frame
+		 *
+		 * @return `true` to make Run() return
+		 */
+		virtual bool ShouldClose() { return false; }
+
+		/**
+		 * @brief Get the camera to render the layers with
+		 */
+		virtual CameraBase& GetCamera() = 0;
+
+	private:
+		LayerStack layers;
+
+		float timestep;
+		float maxFrameTime;
+		float accumulator;
+
+		bool running;
+		bool started;
+		std::chrono::steady_clock::time_point lastFrame;
+	};
+}
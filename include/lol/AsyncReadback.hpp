@@ -0,0 +1,151 @@
+#pragma once
+
+#include <functional>
+#include <future>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <lol/Image.hpp>
+#include <lol/util/NonCopyable.hpp>
+#include <lol/util/Enums.hpp>
+
+namespace lol
+{
+	class Framebuffer;
+	class ImageAllocator;
+
+	/**
+	 * @brief Pixels of a finished readback, only valid during the callback they're passed to
+	 *
+	 * Rows are tightly packed and in OpenGL order, so the first row is the bottom of the
+	 * framebuffer. That's the same order Texture2D expects when uploading an Image.
+	 */
+	struct ReadbackView
+	{
+		const uint8_t* pixels;		///< Mapped memory of the pixel pack buffer
+		size_t size;				///< Number of bytes
+		glm::uvec2 dimensions;		///< Width and height of the region that was read
+		PixelFormat format;
+		PixelType type;
+	};
+
+	/**
+	 * @brief Reads framebuffers back to the CPU without waiting for the GPU
+	 *
+	 * `glReadPixels()` into client memory blocks until all rendering into the framebuffer
+	 * has finished. Instead, Read() copies the pixels into one of a ring of pixel pack
+	 * buffers, which happens on the GPU, and puts a fence behind the copy. Poll() hands
+	 * out the readbacks whose fences have signaled, usually a frame or two later. In the
+	 * meantime the GPU can already work on the next frames.
+	 *
+	 * Readbacks complete in the order they were started. If Read() is called while all buffers
+	 * are in use, it waits for the oldest readback to finish first, so the ring size limits how
+	 * many frames the readbacks may lag behind.
+	 *
+	 * All functions have to be called on the thread owning the OpenGL context. Callbacks run
+	 * while their buffer is still mapped, so they must not call back into the AsyncReadback,
+	 * start new readbacks after Poll() or Finish() returned instead.
+	 *
+	 * If waiting for a readback fails or its buffer can't be mapped, it is dropped: its
+	 * callback is never called and the future from ReadImage() is broken.
+	 */
+	class AsyncReadback : public NonCopyable
+	{
+	public:
+		typedef std::function<void(const ReadbackView&)> Callback;
+
+		/**
+		 * @brief Construct a new AsyncReadback
+		 *
+		 * @param buffers 	Number of pixel pack buffers, i.e. how many readbacks can be in flight
+		 */
+		AsyncReadback(size_t buffers = 3);
+
+		/**
+		 * @brief Hand the buffers to the DeletionQueue
+		 *
+		 * Readbacks that haven't completed yet are dropped, their callbacks are never called and
+		 * their futures are broken. Call Finish() first to complete them.
+		 */
+		~AsyncReadback();
+
+		/**
+		 * @brief Start reading a framebuffer attachment
+		 *
+		 * Multisampled Framebuffers can't be read, resolve them with Framebuffer::ResolveTo() first.
+		 * Leaves the framebuffer bound as `GL_READ_FRAMEBUFFER`.
+		 *
+		 * @param framebuffer 	The Framebuffer to read from
+		 * @param callback 		Called by Poll() or Finish() with the pixels, once they arrived
+		 * @param attachment 	The color attachment to read
+		 * @param format 		Format of the pixels to read
+		 * @param type 			Datatype of the pixels to read
+		 */
+		void Read(Framebuffer& framebuffer, Callback callback, FramebufferAttachment attachment = FramebufferAttachment::Color0, PixelFormat format = PixelFormat::RGBA, PixelType type = PixelType::UByte);
+
+		/**
+		 * @brief Start reading a framebuffer attachment into an Image
+		 *
+		 * The future becomes ready during the Poll() or Finish() that completes the readback.
+		 * Don't wait on it before that, it would never become ready.
+		 *
+		 * @param framebuffer 	The Framebuffer to read from
+		 * @param attachment 	The color attachment to read
+		 * @param format 		Format of the pixels to read
+		 * @param type 			Datatype of the pixels to read
+		 * @param allocator 	Allocator for the pixels of the Image, or `nullptr` for ImageAllocator::Default()
+		 * @return 				A future for the Image, its rows are in OpenGL order (bottom first)
+		 */
+		std::future<Image> ReadImage(Framebuffer& framebuffer, FramebufferAttachment attachment = FramebufferAttachment::Color0, PixelFormat format = PixelFormat::RGBA, PixelType type = PixelType::UByte, ImageAllocator* allocator = nullptr);
+
+		/**
+		 * @brief Complete all readbacks that have arrived, without waiting
+		 *
+		 * Should be called once per frame.
+		 *
+		 * @return Number of completed (or dropped) readbacks
+		 */
+		size_t Poll();
+
+		/**
+		 * @brief Wait for all running readbacks and complete them
+		 *
+		 * @return Number of completed (or dropped) readbacks
+		 */
+		size_t Finish();
+
+		/**
+		 * @brief Get the number of readbacks that haven't completed yet
+		 */
+		inline size_t GetPending() const { return pending; }
+
+	private:
+		struct Slot
+		{
+			unsigned int buffer = 0;
+			size_t capacity = 0;
+			void* fence = nullptr;
+
+			size_t size = 0;
+			glm::uvec2 dimensions{ 0 };
+			PixelFormat format = PixelFormat::RGBA;
+			PixelType type = PixelType::UByte;
+			Callback callback;
+		};
+
+		/**
+		 * @brief Complete or drop the oldest readback
+		 *
+		 * @param wait 	Whether to block until it has arrived
+		 * @return 		`false` if it hasn't arrived yet and `wait` is false
+		 */
+		bool CompleteOldest(bool wait);
+
+	private:
+		std::vector<Slot> slots;
+		size_t next;
+		size_t pending;
+		bool completing;	///< Whether a callback is running
+	};
+}
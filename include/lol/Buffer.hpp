@@ -8,6 +8,9 @@
 
 namespace lol
 {
+	class ResidencyManager;
+	class VertexArray;
+
 	/**
 	 * @brief Represents a generic buffer object. The buffer is destroyed together with the object
 	 * 
@@ -29,6 +32,15 @@ namespace lol
 		 */
 		void Unmap();
 
+		/**
+		 * @brief Overwrite a part of the Buffer
+		 * 
+		 * @param data 		Data to write
+		 * @param bytes 	Number of bytes to write
+		 * @param offset 	Where to start writing in the Buffer
+		 */
+		void Update(const void* data, size_t bytes, size_t offset = 0);
+
 		/**
 		 * @brief Binds the Buffer
 		 * 
@@ -40,6 +52,13 @@ namespace lol
 		 */
 		void Unbind();
 
+		/**
+		 * @brief Get the size of the data store of the Buffer
+		 * 
+		 * @return Number of bytes
+		 */
+		inline size_t GetSize() const { return size; }
+
 	protected:
 		/**
 		 * @brief Construct a new Buffer object of the desired type
@@ -49,9 +68,26 @@ namespace lol
 		Buffer(BufferType target);
 		virtual ~Buffer();
 
+		/**
+		 * @brief Replace the storage of the Buffer
+		 * 
+		 * The Buffer keeps its ID, and stays tracked by its ResidencyManager with the new size.
+		 * 
+		 * @param data 	Data to put into the buffer, or `nullptr` to leave it uninitialized
+		 * @param bytes Size of the new storage in bytes
+		 * @param usage Hint OpenGL on how the buffer will be used
+		 */
+		void Reallocate(const void* data, size_t bytes, Usage usage);
+
 	protected:
 		unsigned int id;
 		BufferType type;
+		size_t size;
+
+	private:
+		friend class ResidencyManager;
+		friend class VertexArray;
+		ResidencyManager* residency;
 	};
 
 }
\ No newline at end of file
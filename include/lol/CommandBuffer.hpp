@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <lol/util/Enums.hpp>
+#include <lol/util/NonCopyable.hpp>
+
+namespace lol
+{
+	class Shader;
+	class VertexArray;
+	class Texture;
+	class Drawable;
+	class CameraBase;
+	class JobSystem;
+
+	/**
+	 * @brief A compact list of rendering commands that can be recorded on any thread
+	 *
+	 * Recording doesn't touch OpenGL at all, commands are only encoded into a linear block
+	 * of memory. Execute() then replays them on the thread owning the context. This allows
+	 * preparing a frame on many threads at once, e.g. one CommandBuffer per thread that are
+	 * executed one after another.
+	 *
+	 * Objects are referenced by pointer, so they must stay alive until the buffer was executed.
+	 * Uniforms are set by location, look those up with Shader::GetUniformLocation() beforehand.
+	 *
+	 * If the shader of a BindShader() isn't ready yet during replay, its fallback is bound
+	 * instead. Uniforms recorded for the shader are skipped while the fallback is bound, since
+	 * their locations belong to the other program, and once one was skipped so are the draws
+	 * up to the next BindShader(), they would use whatever values the fallback had last. So
+	 * the fallback only draws objects that record no uniforms. Without a ready fallback,
+	 * everything up to the next BindShader() is skipped, so Drawables with pending shaders
+	 * simply don't show up. VAOs are bound either way, as recording leaves out repeated binds.
+	 */
+	class CommandBuffer : public NonCopyable
+	{
+	public:
+		CommandBuffer();
+		CommandBuffer(CommandBuffer&& other) noexcept;
+		CommandBuffer& operator=(CommandBuffer&& other) noexcept;
+
+		/**
+		 * @brief Bind a shader program
+		 *
+		 * @param shader 	The shader to bind
+		 * @param fallback 	Shader to bind instead if `shader` isn't ready during replay, or `nullptr`
+		 */
+		void BindShader(Shader& shader, Shader* fallback = nullptr);
+		void BindVertexArray(VertexArray& vao);
+
+		/**
+		 * @brief Bind a texture to a texture unit
+		 *
+		 * @param texture 	The texture to bind
+		 * @param unit 		Index of the texture unit, starting at 0
+		 */
+		void BindTexture(Texture& texture, unsigned int unit);
+
+		void SetUniform(int location, int value);
+		void SetUniform(int location, float value);
+		void SetUniform(int location, const glm::vec2& value);
+		void SetUniform(int location, const glm::vec4& value);
+		void SetUniform(int location, const glm::mat4& value);
+
+		/**
+		 * @brief Draw a range of the bound VAO's indices
+		 *
+		 * @param mode 	How to assemble the vertices
+		 * @param count Number of indices to draw
+		 * @param first Index of the first index to draw
+		 * @param indexType Type of the indices in the bound VAO's element buffer
+		 */
+		void DrawElements(DrawMode mode, unsigned int count, unsigned int first = 0, Type indexType = Type::UInt);
+
+		/**
+		 * @brief Append all commands of another buffer
+		 *
+		 * @param other The buffer to copy the commands from
+		 */
+		void Append(const CommandBuffer& other);
+
+		/**
+		 * @brief Replay all commands, must be called on the thread owning the OpenGL context
+		 *
+		 * The buffer is left untouched and can be executed again.
+		 */
+		void Execute() const;
+
+		/**
+		 * @brief Remove all commands, but keep the memory for the next frame
+		 */
+		void Clear();
+
+		inline size_t GetCommandCount() const { return commandCount; }
+		inline size_t GetSize() const { return data.size(); }
+
+	private:
+		enum class CommandType : uint8_t
+		{
+			BindShader,
+			BindVertexArray,
+			BindTexture,
+			Uniform1i,
+			Uniform1f,
+			Uniform2f,
+			Uniform4f,
+			UniformMatrix4f,
+			DrawElements
+		};
+
+		template<typename Payload>
+		void Push(CommandType type, const Payload& payload);
+
+	private:
+		std::vector<uint8_t> data;
+		size_t commandCount;
+
+		// Used to drop redundant binds while recording
+		const Shader* lastShader;
+		const Shader* lastFallback;
+		const VertexArray* lastVAO;
+	};
+
+	/**
+	 * @brief Records Drawables into CommandBuffers on a JobSystem and replays them in order
+	 *
+	 * The Drawables are split into contiguous ranges that are recorded in parallel, each into
+	 * its own CommandBuffer. Execute() replays the buffers in range order, so the result is
+	 * the same as drawing the Drawables one after another.
+	 */
+	class CommandQueue : public NonCopyable
+	{
+	public:
+		CommandQueue();
+
+		/**
+		 * @brief Record a list of Drawables, replacing the previously recorded commands
+		 *
+		 * @param drawables The Drawables to record, see Drawable::Record()
+		 * @param camera 	The camera with which the objects are rendered
+		 * @param jobs 		The job system to record on
+		 */
+		void Record(const std::vector<Drawable*>& drawables, const CameraBase& camera, JobSystem& jobs);
+
+		/**
+		 * @brief Replay all recorded commands, must be called on the thread owning the OpenGL context
+		 */
+		void Execute() const;
+
+		/**
+		 * @brief Get the total number of recorded commands
+		 *
+		 * @return Number of commands over all buffers
+		 */
+		size_t GetCommandCount() const;
+
+	private:
+		std::vector<CommandBuffer> buffers;
+		size_t usedBuffers;
+	};
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <lol/util/BoundingBox.hpp>
+#include <lol/util/NonCopyable.hpp>
+
+#ifdef LOL_ENABLE_DEBUG_DRAW
+	/// Draw a line from `from` to `to`, see DebugDraw::Line()
+	#define LOL_DEBUG_LINE(...) ::lol::DebugDraw::Get().Line(__VA_ARGS__)
+	/// Draw the edges of a BoundingBox, see DebugDraw::Box()
+	#define LOL_DEBUG_BOX(...) ::lol::DebugDraw::Get().Box(__VA_ARGS__)
+	/// Draw a wireframe sphere, see DebugDraw::Sphere()
+	#define LOL_DEBUG_SPHERE(...) ::lol::DebugDraw::Get().Sphere(__VA_ARGS__)
+	/// Draw the view frustum of a camera, see DebugDraw::Frustum()
+	#define LOL_DEBUG_FRUSTUM(...) ::lol::DebugDraw::Get().Frustum(__VA_ARGS__)
+	/// Draw the local axes of a Transformable, see DebugDraw::Axes()
+	#define LOL_DEBUG_AXES(...) ::lol::DebugDraw::Get().Axes(__VA_ARGS__)
+	/// Draw everything added since the last flush, must be called on the thread owning the OpenGL context
+	#define LOL_DEBUG_FLUSH(camera) ::lol::DebugDraw::Get().Flush(camera)
+#else
+	#define LOL_DEBUG_LINE(...) ((void)0)
+	#define LOL_DEBUG_BOX(...) ((void)0)
+	#define LOL_DEBUG_SPHERE(...) ((void)0)
+	#define LOL_DEBUG_FRUSTUM(...) ((void)0)
+	#define LOL_DEBUG_AXES(...) ((void)0)
+	#define LOL_DEBUG_FLUSH(camera) ((void)0)
+#endif
+
+namespace lol
+{
+	class CameraBase;
+	class Shader;
+	class Transformable;
+	class VertexArray;
+	class VertexBuffer;
+
+	/**
+	 * @brief Collects lines for visualizing bounds, rays and cameras, and draws them in one go
+	 *
+	 * Shapes are turned into line segments right away and appended to a list, which Flush()
+	 * uploads into one streaming vertex buffer and draws with one `DrawMode::Lines` call per
+	 * depth test mode. Shapes can be added from any thread.
+	 *
+	 * The `LOL_DEBUG_*` macros only do something if `LOL_ENABLE_DEBUG_DRAW` is defined (see
+	 * the CMake option of the same name). Otherwise they compile to nothing, not even their
+	 * arguments are evaluated, so debug drawing can stay in release code.
+	 */
+	class DebugDraw : public NonCopyable
+	{
+	public:
+		/**
+		 * @brief Get the debug drawer shared by all threads
+		 */
+		static DebugDraw& Get();
+
+		/**
+		 * @brief Add a line
+		 *
+		 * @param from 		Start of the line
+		 * @param to 		End of the line
+		 * @param color 	Color of the line
+		 * @param depthTest Whether the line is hidden behind geometry, `false` draws it on top of everything
+		 */
+		void Line(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color = glm::vec4(1.0f), bool depthTest = true);
+
+		/**
+		 * @brief Add the 12 edges of a box
+		 *
+		 * @param box 		The box to draw
+		 * @param color 	Color of the lines
+		 * @param depthTest Whether the lines are hidden behind geometry
+		 */
+		void Box(const BoundingBox& box, const glm::vec4& color = glm::vec4(1.0f), bool depthTest = true);
+
+		/**
+		 * @brief Add a sphere, drawn as three circles around its axes
+		 *
+		 * @param center 	Center of the sphere
+		 * @param radius 	Radius of the sphere
+		 * @param color 	Color of the lines
+		 * @param depthTest Whether the lines are hidden behind geometry
+		 * @param segments 	Number of lines per circle
+		 */
+		void Sphere(const glm::vec3& center, float radius, const glm::vec4& color = glm::vec4(1.0f), bool depthTest = true, unsigned int segments = 32);
+
+		/**
+		 * @brief Add the edges of the volume a camera sees
+		 *
+		 * @param camera 	The camera whose view and projection span the frustum
+		 * @param color 	Color of the lines
+		 * @param depthTest Whether the lines are hidden behind geometry
+		 */
+		void Frustum(const CameraBase& camera, const glm::vec4& color = glm::vec4(1.0f), bool depthTest = true);
+
+		/**
+		 * @brief Add the local x, y and z axes of an object in red, green and blue
+		 *
+		 * @param object 	The object whose position, rotation and scale are shown
+		 * @param length 	Length of the axes before the object's scale is applied
+		 * @param depthTest Whether the lines are hidden behind geometry
+		 */
+		void Axes(const Transformable& object, float length = 1.0f, bool depthTest = true);
+
+		/**
+		 * @brief Draw all lines added since the last flush and remove them
+		 *
+		 * Must be called on the thread owning the OpenGL context. The depth test is left
+		 * enabled or disabled, whichever it was before.
+		 *
+		 * @param camera The camera to draw the lines with
+		 */
+		void Flush(const CameraBase& camera);
+
+		/**
+		 * @brief Remove all lines without drawing them
+		 */
+		void Clear();
+
+		/**
+		 * @brief Get the number of lines waiting for the next flush
+		 */
+		size_t GetLineCount();
+
+		/**
+		 * @brief Delete the shader and buffers
+		 *
+		 * Call this before destroying the OpenGL context, if anything was flushed, followed by
+		 * DeletionQueue::Flush(). They're created again by the next Flush().
+		 */
+		void ReleaseGpuResources();
+
+	private:
+		struct Vertex
+		{
+			glm::vec3 position;
+			uint8_t color[4];
+		};
+
+		DebugDraw();
+
+		/**
+		 * @brief Append a line to the list of its depth test mode, `mutex` has to be locked
+		 */
+		void Append(const glm::vec3& from, const glm::vec3& to, const uint8_t* color, bool depthTest);
+
+	private:
+		std::mutex mutex;
+		std::vector<Vertex> lines[2];		///< Vertices of the lines without and with depth test
+
+		std::vector<Vertex> vertices;
+		std::shared_ptr<Shader> shader;
+		std::shared_ptr<VertexBuffer> vertexBuffer;
+		std::shared_ptr<VertexArray> vao;
+	};
+}
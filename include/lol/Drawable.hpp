@@ -9,6 +9,7 @@ namespace lol
 {
 
 	class CameraBase;
+	class CommandBuffer;
 
 	/**
 	 * @brief A class that can be displayed on a screen.
@@ -27,26 +28,77 @@ namespace lol
 		 */
 		virtual void PreRender(const CameraBase& camera) { };
 
+		/**
+		 * @brief Called by Record() after the shader and VAO were recorded, and before the draw.
+		 * 
+		 * This is the recording counterpart of PreRender(). It may run on a worker thread, so
+		 * it must record its uniforms into the buffer instead of setting them directly.
+		 * 
+		 * @param commands 	The buffer to record into
+		 * @param camera 	The camera with which this object is rendered.
+		 */
+		virtual void PreRecord(CommandBuffer& commands, const CameraBase& camera) { };
+
 		/**
 		 * @brief Bind the shader and draw the VAO
 		 * 
+		 * If the shader is still compiling (or failed to compile) the fallback shader
+		 * is used instead. Without a fallback shader nothing is drawn.
+		 * 
 		 * @param camera The camera with which this object is rendered.
 		 */
 		void Draw(const CameraBase& camera);
 
+		/**
+		 * @brief Record the commands to draw this object, without touching OpenGL
+		 * 
+		 * Can be called from any thread, see CommandBuffer. Whether the shader is ready is
+		 * only decided during replay, which binds the fallback shader in its place if it
+		 * isn't. The uniforms recorded by PreRecord() can't be applied to the fallback, so if
+		 * it records any, the object isn't drawn until its own shader is ready.
+		 * 
+		 * @param commands 	The buffer to record into
+		 * @param camera 	The camera with which this object is rendered.
+		 */
+		void Record(CommandBuffer& commands, const CameraBase& camera);
+
 		/**
 		 * @brief The VAO can be rendered as a mesh, a set of lines, loops, strips etc
 		 */
 		void SetDrawMode(DrawMode type);
 
+		/**
+		 * @brief Set the shader used by Drawables whose own shader isn't ready
+		 *
+		 * PreRender() is called with the fallback shader in place of the Drawable's
+		 * own, so it should understand the same uniforms (or ignore them). Recorded
+		 * commands refer to the fallback too, so it has to stay alive until they
+		 * were executed.
+		 *
+		 * @param shader The fallback shader, or `nullptr` to skip those Drawables
+		 */
+		static void SetFallbackShader(const std::shared_ptr<Shader>& shader);
+
 	protected:
 		Drawable() {}
 
+	private:
+		/**
+		 * @brief Bind a ready shader and draw the VAO with it
+		 *
+		 * @param active 	The Drawable's own shader or the fallback shader
+		 * @param camera 	The camera with which this object is rendered.
+		 */
+		void DrawWith(const std::shared_ptr<Shader>& active, const CameraBase& camera);
+
 	protected:
 		std::shared_ptr<VertexArray> vao;
 		std::shared_ptr<Shader> shader;
 
 		DrawMode type = DrawMode::Triangles;
+
+	private:
+		static std::shared_ptr<Shader> fallbackShader;
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <lol/util/NonCopyable.hpp>
+#include <lol/util/Enums.hpp>
+
+namespace lol
+{
+	class Texture2D;
+
+	/**
+	 * @brief Storage for a Framebuffer attachment that is never sampled
+	 *
+	 * Unlike textures, renderbuffers can be multisampled. They're the usual choice
+	 * for depth buffers and for the color buffers of an MSAA target.
+	 */
+	class Renderbuffer : public NonCopyable
+	{
+	public:
+		/**
+		 * @brief Construct a new Renderbuffer
+		 *
+		 * @param width 	Width of the renderbuffer
+		 * @param height 	Height of the renderbuffer
+		 * @param format 	Internal format, e.g. TextureFormat::RGBA8 or TextureFormat::Depth24Stencil8
+		 * @param samples 	Number of samples per pixel, 0 for a renderbuffer that isn't multisampled
+		 */
+		Renderbuffer(unsigned int width, unsigned int height, TextureFormat format, unsigned int samples = 0);
+		~Renderbuffer();
+
+		/**
+		 * @brief Change the size of the renderbuffer
+		 *
+		 * The contents are undefined afterwards. Does nothing if the size doesn't change.
+		 *
+		 * @param width 	New width of the renderbuffer
+		 * @param height 	New height of the renderbuffer
+		 */
+		void Resize(unsigned int width, unsigned int height);
+
+		/**
+		 * @brief Bind the renderbuffer
+		 */
+		void Bind();
+
+		/**
+		 * @brief Unbind the renderbuffer
+		 */
+		void Unbind();
+
+		inline const glm::uvec2& GetDimensions() const { return size; }
+		inline TextureFormat GetFormat() const { return format; }
+		inline unsigned int GetSamples() const { return samples; }
+
+	private:
+		friend class Framebuffer;
+
+		unsigned int id;
+		glm::uvec2 size;
+		TextureFormat format;
+		unsigned int samples;
+	};
+
+	/**
+	 * @brief A render target made up of Texture2D and Renderbuffer attachments
+	 *
+	 * Rendering goes into the Framebuffer while it is bound. Attachments are shared pointers,
+	 * so the same texture can be rendered into and then sampled by other objects. All
+	 * attachments need the same number of samples, textures count as 0 samples.
+	 *
+	 * Fragment shader output `location = i` is written to FramebufferAttachment::Color<i>,
+	 * outputs without a matching attachment are discarded.
+	 *
+	 * A Framebuffer is meant to be kept around and reused every frame. Resize() only
+	 * reallocates if the size actually changed.
+	 *
+	 * Textures are created with mipmaps, but rendering only writes their base level. Call
+	 * Texture::GenerateMipmaps() before sampling them minified. Attached textures shouldn't be
+	 * tracked by a ResidencyManager, restoring an evicted texture gives it a new ID.
+	 */
+	class Framebuffer : public NonCopyable
+	{
+	public:
+		/**
+		 * @brief Construct a new Framebuffer without any attachments
+		 *
+		 * @param width 	Width of the render target
+		 * @param height 	Height of the render target
+		 */
+		Framebuffer(unsigned int width, unsigned int height);
+		~Framebuffer();
+
+		/**
+		 * @brief Attach a texture, replacing whatever was attached there before
+		 *
+		 * The texture is resized to the size of the Framebuffer if needed.
+		 *
+		 * @param attachment 	Where to attach the texture
+		 * @param texture 		The texture to render into
+		 */
+		void Attach(FramebufferAttachment attachment, const std::shared_ptr<Texture2D>& texture);
+
+		/**
+		 * @brief Attach a renderbuffer, replacing whatever was attached there before
+		 *
+		 * The renderbuffer is resized to the size of the Framebuffer if needed.
+		 *
+		 * @param attachment 	Where to attach the renderbuffer
+		 * @param renderbuffer 	The renderbuffer to render into
+		 */
+		void Attach(FramebufferAttachment attachment, const std::shared_ptr<Renderbuffer>& renderbuffer);
+
+		/**
+		 * @brief Remove an attachment
+		 *
+		 * @param attachment The attachment to remove
+		 */
+		void Detach(FramebufferAttachment attachment);
+
+		/**
+		 * @brief Get an attached texture
+		 *
+		 * @param attachment 	The attachment to look up
+		 * @return 				The texture, or `nullptr` if there is none or it's a renderbuffer
+		 */
+		std::shared_ptr<Texture2D> GetTexture(FramebufferAttachment attachment) const;
+
+		/**
+		 * @brief Get an attached renderbuffer
+		 *
+		 * @param attachment 	The attachment to look up
+		 * @return 				The renderbuffer, or `nullptr` if there is none or it's a texture
+		 */
+		std::shared_ptr<Renderbuffer> GetRenderbuffer(FramebufferAttachment attachment) const;
+
+		/**
+		 * @brief Change the size of the Framebuffer and all of its attachments
+		 *
+		 * The contents are undefined afterwards. Does nothing if the size doesn't change.
+		 *
+		 * @param width 	New width
+		 * @param height 	New height
+		 */
+		void Resize(unsigned int width, unsigned int height);
+
+		/**
+		 * @brief Check whether the Framebuffer can be rendered into
+		 *
+		 * @return `false` if e.g. the attachments have different sample counts
+		 */
+		bool IsComplete();
+
+		/**
+		 * @brief Bind the Framebuffer and set the viewport to cover it
+		 */
+		void Bind();
+
+		/**
+		 * @brief Bind the default framebuffer again
+		 *
+		 * The viewport isn't changed back.
+		 */
+		void Unbind();
+
+		/**
+		 * @brief Copy the contents into another Framebuffer, resolving multisampled attachments
+		 *
+		 * Both Framebuffers need the same size if this one is multisampled. Afterwards this
+		 * Framebuffer is bound as `GL_READ_FRAMEBUFFER` and the target as `GL_DRAW_FRAMEBUFFER`.
+		 *
+		 * @param target 	The Framebuffer to copy into
+		 * @param source 	The color attachment to read from, it's written to all color attachments of the target
+		 * @param depth 	Whether to copy the depth buffer as well
+		 */
+		void ResolveTo(Framebuffer& target, FramebufferAttachment source = FramebufferAttachment::Color0, bool depth = false);
+
+		inline const glm::uvec2& GetDimensions() const { return size; }
+
+	private:
+		friend class AsyncReadback;
+
+		struct Slot
+		{
+			FramebufferAttachment attachment;
+			std::shared_ptr<Texture2D> texture;
+			std::shared_ptr<Renderbuffer> renderbuffer;
+		};
+
+		Slot& GetSlot(FramebufferAttachment attachment);
+		void UpdateDrawBuffers();
+
+	private:
+		unsigned int id;
+		glm::uvec2 size;
+		std::vector<Slot> slots;
+	};
+}
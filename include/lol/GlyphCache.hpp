@@ -0,0 +1,209 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <lol/util/BoundingBox.hpp>
+#include <lol/util/NonCopyable.hpp>
+#include <lol/util/SkylinePacker.hpp>
+
+namespace lol
+{
+	class Texture2D;
+
+	/**
+	 * @brief A rasterized glyph as handed out by a GlyphSource
+	 */
+	struct GlyphBitmap
+	{
+		unsigned int width = 0;				///< Width of the bitmap in pixels, 0 for glyphs without an outline (e.g. spaces)
+		unsigned int height = 0;			///< Height of the bitmap in pixels
+		std::vector<uint8_t> coverage;		///< One byte of coverage per pixel, rows from top to bottom
+		glm::vec2 bearing = glm::vec2(0.0f);	///< Offset from the pen position to the top left corner of the bitmap, y pointing up
+		float advance = 0.0f;				///< How far the pen moves after this glyph
+	};
+
+	/**
+	 * @brief Rasterizes the glyphs of a font
+	 *
+	 * lol doesn't read font files itself. Implement this interface on top of a
+	 * font library like FreeType or stb_truetype to use a font with a GlyphCache.
+	 * All metrics are in pixels at the size given by GetSize().
+	 */
+	class GlyphSource
+	{
+	public:
+		virtual ~GlyphSource() {}
+
+		/**
+		 * @brief Get the size the glyphs are rasterized at
+		 *
+		 * Text drawn at this size maps the distance fields 1:1 to pixels. About 32 to 64
+		 * pixels give sharp text from small labels to large headlines.
+		 *
+		 * @return The em size in pixels
+		 */
+		virtual float GetSize() const = 0;
+
+		/**
+		 * @brief Get the distance between the baselines of two lines
+		 */
+		virtual float GetLineHeight() const = 0;
+
+		/**
+		 * @brief Rasterize a glyph
+		 *
+		 * @param codepoint 	Unicode codepoint of the glyph
+		 * @param bitmap 		Receives the coverage and metrics of the glyph
+		 * @return 				`false` if the font has no glyph for the codepoint
+		 */
+		virtual bool Rasterize(uint32_t codepoint, GlyphBitmap& bitmap) = 0;
+
+		/**
+		 * @brief Get the kerning between two glyphs, added to the advance of the left one
+		 */
+		virtual float GetKerning(uint32_t left, uint32_t right) const { return 0.0f; }
+	};
+
+	/**
+	 * @brief A glyph stored in a GlyphCache
+	 */
+	struct Glyph
+	{
+		unsigned int page;		///< Page of the cache storing the distance field
+		Rect bounds;			///< Quad covering the distance field relative to the pen position, in pixels at GlyphSource::GetSize()
+		Rect uv;				///< Area of the distance field on the page in texture coordinates
+		float advance;			///< How far the pen moves after this glyph
+		bool empty;				///< Whether there is nothing to draw, e.g. for spaces or missing glyphs
+	};
+
+	/**
+	 * @brief Rasterizes glyphs on demand and keeps them as signed distance fields
+	 *
+	 * Glyphs are requested from the GlyphSource the first time they are used, turned into
+	 * signed distance fields and packed into single channel pages. A distance field can be
+	 * drawn sharply at any size, so one cache serves all sizes of a font.
+	 *
+	 * Once `maxPages` pages are full, the least recently used page is cleared and its glyphs
+	 * are rasterized again when they are needed next. Every clear increases the generation
+	 * of the page, which tells users of the cache that their glyphs have moved (see Text).
+	 * Pages used since the last NewFrame() are never cleared, if a single frame needs more
+	 * glyphs than fit into `maxPages` pages, additional pages are created.
+	 *
+	 * The distance is stored as `0.5 + distance / (2 * spread)`, so 0.5 is the outline and
+	 * larger values are inside of the glyph.
+	 */
+	class GlyphCache : public NonCopyable
+	{
+	public:
+		/**
+		 * @brief Construct a new, empty GlyphCache
+		 *
+		 * @param source 	The font to rasterize glyphs from
+		 * @param pageSize 	Width and height of each page
+		 * @param maxPages 	Number of pages to keep before reusing the least recently used one
+		 * @param spread 	Distance from the outline in pixels that the distance fields cover
+		 */
+		GlyphCache(const std::shared_ptr<GlyphSource>& source, unsigned int pageSize = 1024, unsigned int maxPages = 4, unsigned int spread = 4);
+		~GlyphCache();
+
+		/**
+		 * @brief Get a glyph, rasterizing it if it isn't cached
+		 *
+		 * The reference stays valid until a page is cleared, i.e. until the next
+		 * call of GetGlyph() that needs to rasterize.
+		 *
+		 * @param codepoint 	Unicode codepoint of the glyph
+		 * @return 				The cached glyph
+		 */
+		const Glyph& GetGlyph(uint32_t codepoint);
+
+		/**
+		 * @brief Mark a page as used in this frame, so it isn't cleared
+		 */
+		void Touch(unsigned int page);
+
+		/**
+		 * @brief Start a new frame for the least recently used bookkeeping
+		 *
+		 * TextRenderer calls this for the fonts it draws with, only call it yourself when
+		 * laying out text without a TextRenderer, once per frame before the first layout.
+		 */
+		void NewFrame();
+
+		/**
+		 * @brief Regenerate the mipmaps of all pages that got new glyphs since the last call
+		 */
+		void UpdateMipmaps();
+
+		inline float GetKerning(uint32_t left, uint32_t right) const { return source->GetKerning(left, right); }
+		inline float GetSize() const { return source->GetSize(); }
+		inline float GetLineHeight() const { return source->GetLineHeight(); }
+		inline unsigned int GetSpread() const { return spread; }
+
+		/**
+		 * @brief Get a page of the cache
+		 *
+		 * @param index Index of the page (see Glyph::page)
+		 * @return 		The Texture2D storing the page
+		 */
+		inline const std::shared_ptr<Texture2D>& GetPage(unsigned int index) const { return pages[index].texture; }
+
+		/**
+		 * @brief Get how often a page was cleared
+		 *
+		 * Glyphs looked up while the page had an older generation are no longer valid.
+		 */
+		inline uint64_t GetGeneration(unsigned int page) const { return pages[page].generation; }
+
+		inline size_t GetPageCount() const { return pages.size(); }
+		inline size_t GetGlyphCount() const { return glyphs.size(); }
+
+	private:
+		struct Page
+		{
+			std::shared_ptr<Texture2D> texture;
+			SkylinePacker packer;
+			std::vector<uint32_t> codepoints;	///< Glyphs stored on this page
+			uint64_t generation;
+			uint64_t lastUsed;					///< Frame the page was last touched in
+			bool dirty;
+		};
+
+		/**
+		 * @brief Find space for a distance field, clearing or creating a page if needed
+		 */
+		unsigned int Allocate(unsigned int width, unsigned int height, glm::uvec2& position);
+
+		/**
+		 * @brief Remove all glyphs from a page and clear its texture
+		 */
+		void Clear(Page& page);
+
+		/**
+		 * @brief Turn the coverage of a bitmap into a distance field, with a border of `spread` pixels
+		 *
+		 * The rows of the result are bottom to top, as Texture2D expects them.
+		 */
+		void GenerateDistanceField(const GlyphBitmap& bitmap);
+
+	private:
+		std::shared_ptr<GlyphSource> source;
+		unsigned int pageSize;
+		unsigned int maxPages;
+		unsigned int spread;
+
+		std::vector<Page> pages;
+		std::unordered_map<uint32_t, Glyph> glyphs;
+		uint64_t frame;
+
+		GlyphBitmap rasterized;
+		std::vector<uint8_t> field;
+		std::vector<float> inner, outer, scratch;
+		std::vector<int> hull;
+	};
+}
@@ -5,6 +5,7 @@
 #include <glm/glm.hpp>
 #include <lol/util/Enums.hpp>
 #include <lol/util/NonCopyable.hpp>
+#include <lol/util/ImageAllocator.hpp>
 
 namespace lol
 {
@@ -13,6 +14,9 @@ namespace lol
 	 * 
 	 * This class is used to store image pixel- and metadata as well as load
 	 * image files from disk. It has no OpenGL equivalent
+	 * 
+	 * Rows of pixels are stored `pitch` bytes apart, which can be larger than the
+	 * width of a row if the rows are aligned. Images can't be copied, but they can be moved.
 	 */
 	class Image : public NonCopyable
 	{
@@ -31,8 +35,10 @@ namespace lol
 		 * @param height 		Height of the image
 		 * @param pixelFormat 	Pixel format of the image (i.e. what color channels exist)
 		 * @param pixelType 	Pixel type of the image	(i.e. what datatype each component has)
+		 * @param rowAlignment 	Alignment of each row in bytes, a power of two. Use e.g. 64 to align rows to cache lines
+		 * @param allocator 	Allocator to get the pixel memory from, or `nullptr` to use ImageAllocator::Default()
 		 */
-		Image(unsigned int width, unsigned int height, PixelFormat pixelFormat = PixelFormat::RGB, PixelType pixelType = PixelType::UByte);
+		Image(unsigned int width, unsigned int height, PixelFormat pixelFormat = PixelFormat::RGB, PixelType pixelType = PixelType::UByte, size_t rowAlignment = 1, ImageAllocator* allocator = nullptr);
 
 		/**
 		 * @brief Load an Image from disk.
@@ -45,6 +51,21 @@ namespace lol
 
 		Image(unsigned char* buffer, size_t len);
 
+		/**
+		 * @brief Take over the pixeldata of another Image
+		 * 
+		 * @param other The Image to move from. It will be empty afterwards
+		 */
+		Image(Image&& other) noexcept;
+
+		/**
+		 * @brief Take over the pixeldata of another Image
+		 * 
+		 * @param other The Image to move from. It will be empty afterwards
+		 * @return 		This Image
+		 */
+		Image& operator=(Image&& other) noexcept;
+
 		~Image();
 
 		/**
@@ -61,6 +82,28 @@ namespace lol
 		 */
 		inline uint8_t* GetPixels() const { return pixels; }
 
+		/**
+		 * @brief Get a row of pixels
+		 * 
+		 * @param y Index of the row
+		 * @return 	A pointer to the first pixel of the row
+		 */
+		inline uint8_t* GetRow(unsigned int y) const { return pixels + y * pitch; }
+
+		/**
+		 * @brief Get the distance between two rows
+		 * 
+		 * @return Number of bytes from the start of one row to the start of the next
+		 */
+		inline size_t GetPitch() const { return pitch; }
+
+		/**
+		 * @brief Whether the rows are stored without any gaps inbetween
+		 * 
+		 * @return `true` if the pitch is equal to the size of a row
+		 */
+		inline bool IsTightlyPacked() const { return pitch == size.x * SizeOf(format, type); }
+
 		/**
 		 * @brief Get the format of the Image
 		 * 
@@ -75,9 +118,24 @@ namespace lol
 		 */
 		inline PixelType GetPixelType() const { return type; }
 
+	private:
+		/**
+		 * @brief Fill in the metadata of an Image that was loaded by stb_image
+		 */
+		void FromLoaded(int width, int height, int channels);
+
+		/**
+		 * @brief Release the pixeldata and reset the Image to an empty state
+		 */
+		void Release();
+
 	private:
 		glm::uvec2 size;
 		uint8_t* pixels;
+		size_t pitch;
+		size_t alignment;
+
+		ImageAllocator* allocator;	///< Allocator that owns the pixels, `nullptr` if they are owned by stb_image
 
 		PixelFormat format;
 		PixelType type;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 namespace lol
 {
@@ -15,13 +16,60 @@ namespace lol
 		virtual void OnAttach() {}
 		virtual void OnDetach() {}
 
+		/**
+		 * @brief Advance the simulation by one fixed timestep
+		 *
+		 * Layers that don't depend on each other are updated in parallel on worker
+		 * threads, so this must not make any OpenGL calls.
+		 *
+		 * The default calls OnUpdate(), so layers written against the old signature
+		 * keep working.
+		 *
+		 * @param timestep Length of the step in seconds
+		 */
+		virtual void OnUpdate(float timestep) { OnUpdate(); }
+
+		/**
+		 * @brief Deprecated, override OnUpdate(float) instead
+		 *
+		 * Called by the default OnUpdate(float), on a worker thread like it.
+		 */
 		virtual void OnUpdate() {}
+
+		/**
+		 * @brief Render the layer, always called on the thread owning the OpenGL context
+		 *
+		 * The default calls OnRender(CameraBase&), so layers written against the old
+		 * signature keep working.
+		 *
+		 * @param camera 		The camera to render with
+		 * @param interpolation How far the current time is between the last and the next update, in [0, 1)
+		 */
+		virtual void OnRender(CameraBase& camera, float interpolation) { OnRender(camera); }
+
+		/**
+		 * @brief Deprecated, override OnRender(CameraBase&, float) instead
+		 *
+		 * Called by the default OnRender(CameraBase&, float).
+		 */
 		virtual void OnRender(CameraBase& camera) {}
 
+		/**
+		 * @brief Make sure another layer is updated before this one
+		 *
+		 * Dependencies only matter while both layers are in the same LayerStack.
+		 *
+		 * @param layer The layer this one depends on, it must outlive this layer
+		 */
+		void DependsOn(Layer& layer);
+
+		inline const std::vector<Layer*>& GetDependencies() const { return dependencies; }
+
 		inline const std::string& GetDebugName() { return debugName; }
 
 	private:
 		std::string debugName;
+		std::vector<Layer*> dependencies;
 	};
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <lol/Layer.hpp>
+#include <lol/util/NonCopyable.hpp>
+
+namespace lol
+{
+	class CameraBase;
+
+	/**
+	 * @brief Owns an ordered list of layers and drives their updates and rendering
+	 *
+	 * Updates are grouped into waves: a layer is updated in the first wave after all of
+	 * the layers it depends on. All layers of a wave are updated in parallel. Rendering
+	 * happens on the calling thread in the order the layers were pushed.
+	 */
+	class LayerStack : public NonCopyable
+	{
+	public:
+		LayerStack();
+
+		/**
+		 * @brief Detaches all layers
+		 */
+		~LayerStack();
+
+		/**
+		 * @brief Add a layer to the top of the stack and attach it
+		 *
+		 * @param layer The layer to add
+		 */
+		void PushLayer(const std::shared_ptr<Layer>& layer);
+
+		/**
+		 * @brief Detach a layer and remove it from the stack
+		 *
+		 * @param layer The layer to remove
+		 */
+		void RemoveLayer(const std::shared_ptr<Layer>& layer);
+
+		/**
+		 * @brief Detach and remove all layers, starting at the top
+		 */
+		void Clear();
+
+		/**
+		 * @brief Update all layers, independent layers in parallel
+		 *
+		 * If a layer throws, the exception is rethrown here once the current wave finished.
+		 *
+		 * @param timestep Length of the step in seconds
+		 */
+		void Update(float timestep);
+
+		/**
+		 * @brief Render all layers from bottom to top
+		 *
+		 * @param camera 		The camera to render with
+		 * @param interpolation How far the current time is between the last and the next update
+		 */
+		void Render(CameraBase& camera, float interpolation);
+
+		inline size_t Size() const { return layers.size(); }
+
+		inline std::vector<std::shared_ptr<Layer>>::iterator begin() { return layers.begin(); }
+		inline std::vector<std::shared_ptr<Layer>>::iterator end() { return layers.end(); }
+
+	private:
+		/**
+		 * @brief Sort the layers into waves that can be updated in parallel
+		 */
+		void Schedule();
+
+	private:
+		std::vector<std::shared_ptr<Layer>> layers;
+		std::vector<std::vector<Layer*>> waves;
+	};
+}
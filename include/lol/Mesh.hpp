@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <lol/util/BoundingBox.hpp>
+#include <lol/util/Enums.hpp>
+#include <lol/util/NonCopyable.hpp>
+#include <lol/util/VertexQuantizer.hpp>
+
+namespace lol
+{
+	class VertexArray;
+
+	constexpr uint32_t MeshFileMagic = 0x4D4C4F4C;		///< "LOLM" read as a little endian integer
+	constexpr uint32_t MeshFileVersion = 1;
+	constexpr uint32_t MeshFileAlignment = 64;			///< Alignment of the vertex and index data within the file
+
+	/**
+	 * @brief Header at the start of a mesh file
+	 *
+	 * A mesh file is laid out as
+	 *
+	 * | Section 			| Size 									|
+	 * |--------------------|---------------------------------------|
+	 * | MeshFileHeader 	| 96 bytes 								|
+	 * | MeshFileAttribute 	| 48 bytes per attribute 				|
+	 * | MeshFileSubmesh 	| 40 bytes per submesh 					|
+	 * | Vertices 			| `vertexCount * vertexStride` bytes 	|
+	 * | Indices 			| `indexCount` indices of `indexType` 	|
+	 *
+	 * The vertices and indices start at multiples of MeshFileAlignment, so they can be
+	 * uploaded straight from a mapping of the file. All values are little endian.
+	 */
+	struct MeshFileHeader
+	{
+		uint32_t magic;				///< MeshFileMagic
+		uint32_t version;			///< MeshFileVersion
+		uint32_t attributeCount;
+		uint32_t submeshCount;
+		uint32_t indexType;			///< Type::UShort or Type::UInt
+		uint32_t vertexStride;		///< Size of a vertex in bytes
+		uint32_t vertexCount;
+		uint32_t indexCount;
+		uint64_t vertexOffset;		///< Offset of the vertices from the start of the file
+		uint64_t vertexBytes;
+		uint64_t indexOffset;		///< Offset of the indices from the start of the file
+		uint64_t indexBytes;
+		BoundingBox bounds;			///< Bounds of the dequantized positions of all submeshes
+		uint32_t reserved[2];
+	};
+
+	/**
+	 * @brief A vertex attribute as stored in a mesh file
+	 */
+	struct MeshFileAttribute
+	{
+		uint32_t type;					///< Type of the components
+		uint32_t components;
+		uint32_t normalized;			///< 1 if the components are normalized, 0 otherwise
+		uint32_t offset;				///< Offset of the attribute within a vertex
+		float dequantizeScale[4];		///< See Dequantization
+		float dequantizeOffset[4];
+	};
+
+	/**
+	 * @brief A range of indices drawn on its own, e.g. with a different material
+	 */
+	struct Submesh
+	{
+		uint32_t firstIndex;
+		uint32_t indexCount;
+		int32_t baseVertex;		///< Added to every index of the submesh
+		uint32_t reserved;
+		BoundingBox bounds;		///< Bounds of the dequantized positions of the submesh
+	};
+
+	typedef Submesh MeshFileSubmesh;
+
+	static_assert(sizeof(MeshFileHeader) == 96, "lol::MeshFileHeader must match the file format");
+	static_assert(sizeof(MeshFileAttribute) == 48, "lol::MeshFileAttribute must match the file format");
+	static_assert(sizeof(MeshFileSubmesh) == 40, "lol::MeshFileSubmesh must match the file format");
+
+	/**
+	 * @brief A mesh in memory, as written to a mesh file by Mesh::Write()
+	 *
+	 * The first attribute of the vertices has to be the position, its dequantized
+	 * values are what the bounds are computed from.
+	 */
+	struct MeshData
+	{
+		QuantizedVertices vertices;
+		std::vector<uint32_t> indices;
+		std::vector<Submesh> submeshes;
+		BoundingBox bounds;
+	};
+
+	/**
+	 * @brief A mesh loaded from a mesh file
+	 *
+	 * The file is mapped into memory and its vertices and indices are handed to OpenGL
+	 * straight from the mapping, nothing is parsed or copied on the way. Mesh files are
+	 * created from other formats by the converters in lol/util/MeshConverter.hpp.
+	 *
+	 * Quantized attributes keep their quantization, GetDequantization() returns the
+	 * parameters the shader needs (see VertexQuantizer).
+	 */
+	class Mesh : public NonCopyable
+	{
+	public:
+		/**
+		 * @brief Load a mesh file
+		 *
+		 * @param path 	Path of the mesh file
+		 * @param usage Hint OpenGL on how the buffers will be used
+		 * @throws FileMappingException if the file can't be opened
+		 * @throws MeshFileException if the file isn't a valid mesh file, or an index refers to a vertex that doesn't exist
+		 */
+		Mesh(const std::string& path, Usage usage = Usage::StaticDraw);
+
+		/**
+		 * @brief Write a mesh file
+		 *
+		 * Indices are stored as Type::UShort if all vertices can be indexed with them.
+		 *
+		 * @param mesh 	The mesh to write
+		 * @param path 	Path of the mesh file
+		 * @throws MeshFileException if the file can't be written
+		 */
+		static void Write(const MeshData& mesh, const std::string& path);
+
+		/**
+		 * @brief Draw a submesh with the currently bound shader
+		 *
+		 * @param submesh 	Index of the submesh
+		 * @param mode 		How to assemble the vertices
+		 */
+		void Draw(size_t submesh, DrawMode mode = DrawMode::Triangles);
+
+		/**
+		 * @brief Draw all submeshes with the currently bound shader
+		 *
+		 * @param mode How to assemble the vertices
+		 */
+		void Draw(DrawMode mode = DrawMode::Triangles);
+
+		/**
+		 * @brief Get the VAO of the mesh, e.g. to draw it as a Drawable
+		 *
+		 * Drawing all indices of the VAO at once draws all submeshes, as long as
+		 * none of them has a base vertex.
+		 */
+		inline const std::shared_ptr<VertexArray>& GetVertexArray() const { return vao; }
+
+		inline const std::vector<Submesh>& GetSubmeshes() const { return submeshes; }
+		inline const std::vector<Dequantization>& GetDequantization() const { return dequantization; }
+		inline const BoundingBox& GetBounds() const { return bounds; }
+		inline Type GetIndexType() const { return indexType; }
+
+	private:
+		std::shared_ptr<VertexArray> vao;
+		std::vector<Submesh> submeshes;
+		std::vector<Dequantization> dequantization;
+		BoundingBox bounds;
+		Type indexType;
+	};
+}
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <functional>
+#include <vector>
 
 #include <glm/glm.hpp>
 
@@ -11,27 +13,64 @@
 
 namespace lol
 {
+	/**
+	 * @brief State of a shader program's compilation
+	 */
+	enum class ShaderStatus
+	{
+		Pending,	///< The driver is still compiling the program
+		Ready,		///< The program was linked successfully and can be used
+		Failed		///< Compilation or linking failed
+	};
+
+	/**
+	 * @brief When to wait for the driver to finish compiling a shader
+	 */
+	enum class CompileMode
+	{
+		Immediate,	///< Wait inside the constructor
+		Deferred	///< Return immediately, poll GetStatus() to find out when the program is ready
+	};
+
 	/**
 	 * @brief Compiles shaders into a program and manages access to that program
 	 */
 	class Shader : public NonCopyable
 	{
+		friend class ShaderCache;
+
 	public:
 		/**
 		 * @brief Create a new shader program from source
 		 * 
+		 * In deferred mode the sources are only handed to the driver. Drivers supporting
+		 * `GL_KHR_parallel_shader_compile` then compile them on background threads, so many
+		 * shaders can be submitted up front and compiled in parallel. Without the extension
+		 * the first GetStatus() call waits for the compilation instead.
+		 * 
 		 * @param vertexShader   Source code of the vertex shader
 		 * @param fragmentShader Source code of the fragment shader
+		 * @param mode           Whether to wait for compilation to finish
 		 */
-		Shader(const std::string& vertexShader, const std::string& fragmentShader);
+		Shader(const std::string& vertexShader, const std::string& fragmentShader, CompileMode mode = CompileMode::Immediate);
 		~Shader();
 
 		/**
 		 * @brief Status of the program creation
 		 * 
-		 * @returns `true` if shader was successfully created
+		 * @returns `true` if shader was successfully created and is ready to use
 		 */
-		inline bool Good() { return id != 0; }
+		inline bool Good() { return GetStatus() == ShaderStatus::Ready; }
+
+		/**
+		 * @brief Check whether compilation has finished
+		 *
+		 * If the driver supports `GL_KHR_parallel_shader_compile` this never blocks,
+		 * otherwise it waits for a pending compilation to finish.
+		 *
+		 * @return The status of the program
+		 */
+		ShaderStatus GetStatus();
 
 		/**
 		 * @brief Bind this shader program
@@ -43,6 +82,17 @@ namespace lol
 		 */
 		void Unbind();
 
+		/**
+		 * @brief Look up the location of a uniform
+		 *
+		 * Locations stay valid for the lifetime of the program, so they can be looked up
+		 * once and then be used from any thread, e.g. to record a CommandBuffer.
+		 *
+		 * @param name 	Name of the uniform
+		 * @return 		The location, or -1 if the program has no such uniform
+		 */
+		int GetUniformLocation(const std::string& name);
+
 		/**
 		 * Set a int uniform
 		 *
@@ -83,7 +133,52 @@ namespace lol
 		 */
 		void SetUniform(const std::string& name, const glm::vec4& value);
 
+	private:
+		/**
+		 * @brief Create an empty shader without a program
+		 */
+		Shader();
+
+		/**
+		 * @brief Compile and link the sources into this shader's program and wait for the result
+		 *
+		 * @param vertexShader   Source code of the vertex shader
+		 * @param fragmentShader Source code of the fragment shader
+		 * @param retrievable    Hint the driver that GetBinary() will be called
+		 * @return               `true` if the program was linked successfully
+		 */
+		bool Compile(const std::string& vertexShader, const std::string& fragmentShader, bool retrievable);
+
+		/**
+		 * @brief Hand the sources to the driver without querying any results
+		 */
+		void Submit(const std::string& vertexShader, const std::string& fragmentShader, bool retrievable);
+
+		/**
+		 * @brief Query the result of a submitted compilation, print errors and release the shader stages
+		 */
+		void Finish();
+
+		/**
+		 * @brief Create this shader's program from a binary retrieved with GetBinary()
+		 *
+		 * @param binaryFormat Driver specific format of the binary
+		 * @param binary       The program binary
+		 * @return             `false` if the driver rejected the binary
+		 */
+		bool LoadBinary(unsigned int binaryFormat, const std::vector<uint8_t>& binary);
+
+		/**
+		 * @brief Retrieve the linked program as a binary blob
+		 *
+		 * @param binaryFormat Receives the driver specific format of the binary
+		 * @return             The binary, or an empty vector if it couldn't be retrieved
+		 */
+		std::vector<uint8_t> GetBinary(unsigned int& binaryFormat) const;
+
 	private:
 		unsigned int id;
+		unsigned int vertexShaderID, fragmentShaderID;	///< Only alive while the compilation is pending
+		ShaderStatus status;
 	};
 }
\ No newline at end of file
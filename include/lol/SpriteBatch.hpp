@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <lol/util/BoundingBox.hpp>
+#include <lol/util/NonCopyable.hpp>
+#include <lol/util/QuadIndices.hpp>
+
+namespace lol
+{
+	class CameraBase;
+	class Shader;
+	class Texture;
+	class Texture2D;
+	class TextureAtlas;
+	class VertexArray;
+	class VertexBuffer;
+	struct AtlasRegion;
+	struct TextureLayer;
+
+	/**
+	 * @brief A textured quad drawn by a SpriteBatch
+	 */
+	struct Sprite
+	{
+		glm::vec2 position = glm::vec2(0.0f);		///< Where the origin of the sprite is placed
+		glm::vec2 size = glm::vec2(1.0f);			///< Width and height of the quad
+		Rect uv = { 0.0f, 0.0f, 1.0f, 1.0f };		///< Area of the texture to show, in texture coordinates
+		glm::vec4 color = glm::vec4(1.0f);			///< Multiplied with the texture
+		float rotation = 0.0f;						///< Counter-clockwise rotation around the origin, in radians
+		glm::vec2 origin = glm::vec2(0.5f);			///< Point the sprite is placed and rotated around, relative to its size. (0, 0) is the bottom left corner
+		int layer = 0;								///< Lower layers are drawn first, from -32768 to 32767
+	};
+
+	/**
+	 * @brief Draws large numbers of sprites with a handful of draw calls
+	 *
+	 * Sprites are collected between Begin() and End(). End() sorts them by layer and then by
+	 * texture, writes their vertices into a single streaming vertex buffer and issues one draw
+	 * call per run of sprites that share a layer and a texture. Sprites on pages of a
+	 * TextureAtlas share the page's texture, so atlased sprites batch together. The same
+	 * goes for sprites on layers of a Texture2DArray (e.g. from a TextureArrayPool), which
+	 * can show Images of the same size and format that weren't packed into an atlas.
+	 *
+	 * Within a layer, sprites with different textures aren't drawn in the order they were
+	 * added. Put sprites on different layers if they have to overlap in a specific order.
+	 *
+	 * Blending isn't changed, enable it beforehand for sprites with transparency.
+	 */
+	class SpriteBatch : public NonCopyable
+	{
+	public:
+		/**
+		 * @brief Construct a new SpriteBatch
+		 *
+		 * A custom shader gets the vertex position, texture coordinates and color at the
+		 * attribute locations 0, 1 and 2. It needs a `mat4 viewProjection` and a
+		 * `sampler2D sprite` uniform. A custom array shader additionally gets the layer
+		 * of the array at location 3, and samples a `sampler2DArray sprite` instead.
+		 *
+		 * @param shader 		Shader to draw the sprites with, or `nullptr` for the built-in one
+		 * @param arrayShader 	Shader to draw sprites on Texture2DArray layers with, or `nullptr` for the built-in one
+		 */
+		SpriteBatch(const std::shared_ptr<Shader>& shader = nullptr, const std::shared_ptr<Shader>& arrayShader = nullptr);
+		~SpriteBatch();
+
+		/**
+		 * @brief Start collecting sprites
+		 *
+		 * @param camera 	The camera to draw the sprites with, usually an OrthogonalCamera
+		 */
+		void Begin(const CameraBase& camera);
+
+		/**
+		 * @brief Add a sprite
+		 *
+		 * The texture has to stay alive until End() was called.
+		 *
+		 * @param texture 	The texture of the sprite
+		 * @param sprite 	Where and how to draw it
+		 */
+		void Draw(Texture2D& texture, const Sprite& sprite);
+
+		/**
+		 * @brief Add a sprite showing an Image of a TextureAtlas
+		 *
+		 * Empty regions are skipped.
+		 *
+		 * @param atlas 	The atlas containing the Image
+		 * @param region 	Location of the Image in the atlas, replaces the sprite's texture coordinates
+		 * @param sprite 	Where and how to draw it
+		 */
+		void Draw(const TextureAtlas& atlas, const AtlasRegion& region, Sprite sprite);
+
+		/**
+		 * @brief Add a sprite showing a layer of a Texture2DArray
+		 *
+		 * Sprites on different layers of the same array are drawn together. The array has
+		 * to stay alive until End() was called.
+		 *
+		 * @param layer 	The layer to show, e.g. as returned by TextureArrayPool::Insert()
+		 * @param sprite 	Where and how to draw it
+		 */
+		void Draw(const TextureLayer& layer, const Sprite& sprite);
+
+		/**
+		 * @brief Draw all sprites added since Begin()
+		 */
+		void End();
+
+		/**
+		 * @brief Get the number of sprites added since Begin()
+		 */
+		inline size_t GetSpriteCount() const { return sprites.size(); }
+
+		/**
+		 * @brief Get the number of draw calls the last End() issued
+		 */
+		inline size_t GetDrawCount() const { return drawCount; }
+
+		inline const std::shared_ptr<Shader>& GetShader() const { return shader; }
+		inline const std::shared_ptr<Shader>& GetArrayShader() const { return arrayShader; }
+
+	private:
+		struct Vertex
+		{
+			glm::vec2 position;
+			glm::vec2 uv;
+			uint8_t color[4];
+			float arrayLayer;		///< Layer of the Texture2DArray, unused for Texture2Ds
+		};
+
+		/**
+		 * @brief A texture used by the sprites of the batch
+		 */
+		struct BatchTexture
+		{
+			Texture* texture;
+			bool array;				///< Whether it is a Texture2DArray, which needs the array shader
+		};
+
+		/**
+		 * @brief Add a sprite with a texture of either kind
+		 */
+		void Add(Texture& texture, bool array, const Sprite& sprite, unsigned int arrayLayer);
+
+	private:
+		std::shared_ptr<Shader> shader;
+		std::shared_ptr<Shader> arrayShader;
+		std::shared_ptr<VertexBuffer> vertexBuffer;
+		std::shared_ptr<VertexArray> vao;
+		QuadIndices quadIndices;
+
+		glm::mat4 viewProjection;
+
+		std::vector<Sprite> sprites;
+		std::vector<uint16_t> spriteTextures;				///< Index into `textures` for every sprite
+		std::vector<unsigned int> spriteArrayLayers;		///< Layer of the array for every sprite, 0 for Texture2Ds
+		std::vector<BatchTexture> textures;
+		std::unordered_map<Texture*, uint16_t> textureIndices;
+
+		std::vector<uint64_t> keys;
+		std::vector<Vertex> vertices;
+		size_t drawCount;
+	};
+}
@@ -0,0 +1,255 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <lol/util/BoundingBox.hpp>
+#include <lol/util/NonCopyable.hpp>
+#include <lol/util/QuadIndices.hpp>
+
+namespace lol
+{
+	class CameraBase;
+	class GlyphCache;
+	class Shader;
+	class VertexArray;
+	class VertexBuffer;
+
+	/**
+	 * @brief A string laid out with the glyphs of a GlyphCache
+	 *
+	 * The layout is cached as a list of quads, grouped by the page of the GlyphCache they
+	 * sample from. It's only redone when the string changes or when the GlyphCache cleared
+	 * a page that some of the glyphs were on. Position, size and color are applied when
+	 * drawing, changing them doesn't redo the layout.
+	 *
+	 * Layout is simple: glyphs are placed one after another using their advance and the
+	 * kerning of the GlyphSource, `\n` starts a new line. Complex scripts that need a shaping
+	 * engine aren't supported.
+	 */
+	class Text
+	{
+	public:
+		/**
+		 * @brief Construct a new Text
+		 *
+		 * @param font 		The GlyphCache to take the glyphs from
+		 * @param string 	The string to show, UTF-8 encoded
+		 * @param size 		Size of the text, i.e. the height of an em in world units
+		 */
+		Text(const std::shared_ptr<GlyphCache>& font, const std::string& string = "", float size = 16.0f);
+
+		/**
+		 * @brief Change the string, the layout is redone the next time it's needed
+		 *
+		 * Does nothing if the string doesn't change.
+		 *
+		 * @param string The string to show, UTF-8 encoded
+		 */
+		void SetString(const std::string& string);
+
+		/**
+		 * @brief Set the position of the baseline of the first line, at the left edge of the text
+		 */
+		void SetPosition(const glm::vec2& position);
+
+		/**
+		 * @brief Set the size of the text, i.e. the height of an em in world units
+		 */
+		void SetSize(float size);
+
+		/**
+		 * @brief Set the color the text is drawn with
+		 */
+		void SetColor(const glm::vec4& color);
+
+		/**
+		 * @brief Redo the layout if the string changed or glyphs moved in the GlyphCache
+		 *
+		 * Called by TextRenderer::Draw(), there's usually no need to call it directly.
+		 * Marks the pages used by the text as used in this frame.
+		 *
+		 * @return Whether the layout was redone
+		 */
+		bool Update();
+
+		/**
+		 * @brief Get the area covered by the glyphs in world units
+		 *
+		 * Redoes the layout if needed.
+		 */
+		Rect GetBounds();
+
+		inline const std::string& GetString() const { return string; }
+		inline const glm::vec2& GetPosition() const { return position; }
+		inline float GetSize() const { return size; }
+		inline const glm::vec4& GetColor() const { return color; }
+		inline const std::shared_ptr<GlyphCache>& GetFont() const { return font; }
+
+		/**
+		 * @brief Get a number identifying the current state of the text
+		 *
+		 * Every change of the text, including a new layout, gives it a new revision. No two
+		 * texts share a revision unless one is a copy of the other.
+		 */
+		inline uint64_t GetRevision() const { return revision; }
+
+	private:
+		friend class TextRenderer;
+
+		/**
+		 * @brief A glyph of the layout, in pixels of the GlyphSource relative to the start of the text
+		 */
+		struct Quad
+		{
+			Rect bounds;
+			Rect uv;
+		};
+
+		/**
+		 * @brief Consecutive quads that are on the same page
+		 */
+		struct Run
+		{
+			unsigned int page;
+			uint64_t generation;	///< Generation of the page when the layout was done
+			size_t first;
+			size_t count;
+		};
+
+		void Layout();
+		void Changed();
+
+	private:
+		std::shared_ptr<GlyphCache> font;
+		std::string string;
+		glm::vec2 position;
+		float size;
+		glm::vec4 color;
+
+		bool laidOut;
+		std::vector<Quad> quads;
+		std::vector<Run> runs;
+		Rect bounds;				///< Bounds of the quads, in pixels of the GlyphSource
+		uint64_t revision;
+	};
+
+	/**
+	 * @brief Draws many Texts with one draw call per page of glyphs
+	 *
+	 * Texts are collected between Begin() and End(). End() combines the quads of all texts
+	 * that use the same GlyphCache page into one range of a shared vertex buffer and draws
+	 * each range with a single call.
+	 *
+	 * If the same texts with the same revisions are drawn as in the previous frame, End()
+	 * skips building and uploading the vertices and only issues the draw calls. For a HUD
+	 * with thousands of labels that rarely change, most frames are therefore cheap. Moving
+	 * the camera doesn't count as a change.
+	 *
+	 * The renderer calls GlyphCache::NewFrame() on every font the first time a text using
+	 * it is drawn after Begin(), so don't call it yourself for these fonts. Renderers that
+	 * share a font must not overlap: finish one with End() before calling Begin() on the
+	 * next, otherwise the second one starts a new frame on the font while the first still
+	 * needs its pages, and they may be cleared before they are drawn. Blending isn't
+	 * changed, enable it beforehand.
+	 */
+	class TextRenderer : public NonCopyable
+	{
+	public:
+		/**
+		 * @brief Construct a new TextRenderer
+		 *
+		 * A custom shader gets the vertex position, texture coordinates and color at the
+		 * attribute locations 0, 1 and 2. It needs a `mat4 viewProjection` and a
+		 * `sampler2D glyphs` uniform. The distance fields are in the red channel.
+		 *
+		 * @param shader 	Shader to draw the texts with, or `nullptr` for the built-in one
+		 */
+		TextRenderer(const std::shared_ptr<Shader>& shader = nullptr);
+		~TextRenderer();
+
+		/**
+		 * @brief Start collecting texts
+		 *
+		 * @param camera 	The camera to draw the texts with, usually an OrthogonalCamera
+		 */
+		void Begin(const CameraBase& camera);
+
+		/**
+		 * @brief Add a text, updating its layout if needed
+		 *
+		 * The text has to stay alive until End() was called.
+		 *
+		 * @param text 	The text to draw
+		 */
+		void Draw(Text& text);
+
+		/**
+		 * @brief Draw all texts added since Begin()
+		 */
+		void End();
+
+		/**
+		 * @brief Get the number of draw calls the last End() issued
+		 */
+		inline size_t GetDrawCount() const { return batches.size(); }
+
+		/**
+		 * @brief Whether the last End() had to build and upload the vertices
+		 */
+		inline bool WasRebuilt() const { return rebuilt; }
+
+		inline const std::shared_ptr<Shader>& GetShader() const { return shader; }
+
+	private:
+		struct Vertex
+		{
+			glm::vec2 position;
+			glm::vec2 uv;
+			uint8_t color[4];
+		};
+
+		struct Entry
+		{
+			Text* text;
+			uint64_t revision;
+
+			inline bool operator==(const Entry& other) const { return text == other.text && revision == other.revision; }
+		};
+
+		/**
+		 * @brief The quads of one page, drawn with one call
+		 */
+		struct Batch
+		{
+			GlyphCache* font;
+			unsigned int page;
+			size_t first;
+			size_t count;
+		};
+
+		/**
+		 * @brief Group the quads of all texts by page and upload their vertices
+		 */
+		void Rebuild();
+
+	private:
+		std::shared_ptr<Shader> shader;
+		std::shared_ptr<VertexBuffer> vertexBuffer;
+		std::shared_ptr<VertexArray> vao;
+		QuadIndices quadIndices;
+
+		glm::mat4 viewProjection;
+
+		std::vector<Entry> entries;
+		std::vector<GlyphCache*> fonts;	///< The fonts NewFrame() was called on since Begin()
+		std::vector<Entry> built;		///< The texts the vertex buffer currently holds
+		std::vector<Batch> batches;
+		std::vector<Vertex> vertices;
+		bool rebuilt;
+	};
+}
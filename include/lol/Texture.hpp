@@ -1,5 +1,9 @@
 #pragma once
 
+#include <vector>
+
+#include <glm/glm.hpp>
+
 #include <lol/util/NonCopyable.hpp>
 #include <lol/util/ObjectManager.hpp>
 #include <lol/util/Enums.hpp>
@@ -7,6 +11,7 @@
 namespace lol
 {
 	class Image;
+	class ResidencyManager;
 
 	/**
 	 * @brief A generic OpenGL Texture
@@ -61,9 +66,87 @@ namespace lol
 		 */
 		void SetBorderColor(float r, float g, float b, float a);
 
+		/**
+		 * @brief Regenerates all mipmap levels from the base level
+		 * 
+		 * Needs to be called after the base level was modified (e.g. via Texture2D::Update())
+		 */
+		void GenerateMipmaps();
+
+		/**
+		 * @brief Get the approximate amount of video memory used by the Texture
+		 * 
+		 * This includes all mipmap levels. If the Texture is currently evicted
+		 * by a ResidencyManager it still reports the memory it would use.
+		 * 
+		 * @return Number of bytes
+		 */
+		inline size_t GetMemoryUsage() const { return memoryUsage; }
+
+		/**
+		 * @brief Whether the Texture currently has storage on the GPU
+		 * 
+		 * @return `false` if the Texture was evicted by a ResidencyManager
+		 */
+		inline bool IsResident() const { return resident; }
+
+	protected:
+		/**
+		 * @brief Create the storage of the texture and fill its base level
+		 * 
+		 * The layout of the storage is taken from `extent`, `format`, `pixelFormat` and `pixelType`,
+		 * so these need to be set up by the derived class beforehand.
+		 * 
+		 * @param data 	Pixel data, or `nullptr` to leave the storage uninitialized
+		 * @param pitch 	Distance between two rows of the data in bytes, 0 if the rows are tightly packed
+		 */
+		void Allocate(const void* data, size_t pitch = 0);
+
+		/**
+		 * @brief Replace the storage of the texture with uninitialized storage of a new size
+		 * 
+		 * The texture keeps its ID, and stays tracked by its ResidencyManager with the new size.
+		 * 
+		 * @param newExtent 	Width, height and depth/layers of the new base level
+		 */
+		void Reallocate(const glm::uvec3& newExtent);
+
+		/**
+		 * @brief Restore the texture if it was evicted, and mark it as used for its ResidencyManager
+		 */
+		void MakeResident();
+
+	private:
+		friend class ResidencyManager;
+		friend class Framebuffer;
+
+		/**
+		 * @brief Copy the base level into system memory and delete the texture object
+		 */
+		void Evict();
+
+		/**
+		 * @brief Recreate the texture object from the copy made by Evict()
+		 */
+		void Restore();
+
 	protected:
 		TargetTexture target;
 		unsigned int id;
+
+		glm::uvec3 extent;			///< Width, height and depth/layers of the base level
+		TextureFormat format;
+		PixelFormat pixelFormat;	///< Format of the data that is uploaded to the texture
+		PixelType pixelType;		///< Datatype of the data that is uploaded to the texture
+
+	private:
+		TextureWrap wrap[3];
+		glm::vec4 borderColor;
+
+		size_t memoryUsage;
+		bool resident;
+		std::vector<uint8_t> evicted;
+		ResidencyManager* residency;
 	};
 
 
@@ -80,6 +163,62 @@ namespace lol
 		 * @param texFormat 	Format of the texture
 		 */
 		Texture2D(const Image& image, TextureFormat texFormat = TextureFormat::RGB);
+
+		/**
+		 * @brief Construct a new 2D Texture without any pixeldata
+		 * 
+		 * The contents of the texture are undefined until they are written to via Update()
+		 * 
+		 * @param width 		Width of the texture
+		 * @param height 		Height of the texture
+		 * @param texFormat 	Format of the texture
+		 * @param pixFormat 	Format of the pixel data that will be uploaded
+		 * @param pixType 		Datatype of each pixel that will be uploaded
+		 */
+		Texture2D(unsigned int width, unsigned int height, TextureFormat texFormat = TextureFormat::RGB, PixelFormat pixFormat = PixelFormat::RGB, PixelType pixType = PixelType::UByte);
+
+		/**
+		 * @brief Overwrite a region of the texture with raw data
+		 * 
+		 * Only the base level is updated, call GenerateMipmaps() afterwards if the
+		 * texture is sampled with mipmapping
+		 * 
+		 * @param x 			Left edge of the region in pixels
+		 * @param y 			Bottom edge of the region in pixels
+		 * @param width 		Width of the region
+		 * @param height 		Height of the region
+		 * @param data 			Pixel data of the region
+		 * @param pixFormat 	Format of the pixel data
+		 * @param pixType 		Datatype of each pixel
+		 * @param pitch 		Distance between two rows of the data in bytes, 0 if the rows are tightly packed
+		 */
+		void Update(unsigned int x, unsigned int y, unsigned int width, unsigned int height, const void* data, PixelFormat pixFormat = PixelFormat::RGB, PixelType pixType = PixelType::UByte, size_t pitch = 0);
+
+		/**
+		 * @brief Overwrite a region of the texture with an Image
+		 * 
+		 * @param x 		Left edge of the region in pixels
+		 * @param y 		Bottom edge of the region in pixels
+		 * @param image 	Image to fetch meta- and pixeldata from
+		 */
+		void Update(unsigned int x, unsigned int y, const Image& image);
+
+		/**
+		 * @brief Change the size of the texture
+		 * 
+		 * The contents are undefined afterwards. Does nothing if the size doesn't change.
+		 * 
+		 * @param width 	New width of the texture
+		 * @param height 	New height of the texture
+		 */
+		void Resize(unsigned int width, unsigned int height);
+
+		/**
+		 * @brief Get the dimensions of the texture
+		 * 
+		 * @return A glm::uvec2 with the width and height of the texture
+		 */
+		inline glm::uvec2 GetDimensions() const { return glm::uvec2(extent.x, extent.y); }
 	};
 
 	/**
@@ -110,4 +249,170 @@ namespace lol
 		 */
 		Texture1D(const Image& image, TextureFormat texFormat = TextureFormat::RGB);
 	};
+
+	/**
+	 * @brief A generic array Texture
+	 * 
+	 * Stores multiple equally sized images ("layers") in a single Texture object. Since all
+	 * layers are bound together, objects using different layers of the same array can be
+	 * rendered without rebinding any textures in between. The layer to sample is passed
+	 * to the shader separately, e.g. as a uniform or a vertex attribute.
+	 * 
+	 * Consider using its derived classes (e.g. Texture1DArray, Texture2DArray)
+	 */
+	class TextureArray : public Texture
+	{
+	public:
+		/**
+		 * @brief Reserve an unused layer of the array
+		 * 
+		 * @return The index of the reserved layer, or -1 if all layers are in use
+		 */
+		int AllocateLayer();
+
+		/**
+		 * @brief Return a layer to the array so it can be allocated again
+		 * 
+		 * The contents of the layer are not cleared
+		 * 
+		 * @param layer Index of the layer
+		 */
+		void FreeLayer(unsigned int layer);
+
+		/**
+		 * @brief Get the total number of layers in the array
+		 * 
+		 * @return Number of layers
+		 */
+		inline unsigned int GetLayerCount() const { return layers; }
+
+		/**
+		 * @brief Get the number of layers that can still be allocated
+		 * 
+		 * @return Number of unused layers
+		 */
+		inline unsigned int GetFreeLayerCount() const { return (unsigned int)freeLayers.size(); }
+
+	protected:
+		/**
+		 * @brief Generate a new array Texture of the specified target
+		 * 
+		 * @param target The target of the Texture
+		 * @param layers Number of layers in the array
+		 */
+		TextureArray(TargetTexture target, unsigned int layers);
+
+	protected:
+		unsigned int layers;
+		std::vector<unsigned int> freeLayers;
+	};
+
+	/**
+	 * @brief An array of 2D Textures
+	 */
+	class Texture2DArray : public TextureArray
+	{
+	public:
+		/**
+		 * @brief Construct a new 2D array Texture without any pixeldata
+		 * 
+		 * @param width 		Width of each layer
+		 * @param height 		Height of each layer
+		 * @param layers 		Number of layers
+		 * @param texFormat 	Format of the texture
+		 * @param pixFormat 	Format of the pixel data that will be uploaded
+		 * @param pixType 		Datatype of each pixel that will be uploaded
+		 */
+		Texture2DArray(unsigned int width, unsigned int height, unsigned int layers, TextureFormat texFormat = TextureFormat::RGBA8, PixelFormat pixFormat = PixelFormat::RGBA, PixelType pixType = PixelType::UByte);
+
+		/**
+		 * @brief Overwrite a layer with raw data
+		 * 
+		 * Only the base level is updated, call GenerateMipmaps() afterwards if the
+		 * texture is sampled with mipmapping
+		 * 
+		 * @param layer 		Index of the layer
+		 * @param data 			Tightly packed pixel data with the same dimensions as the layer
+		 * @param pixFormat 	Format of the pixel data
+		 * @param pixType 		Datatype of each pixel
+		 */
+		void SetLayer(unsigned int layer, const void* data, PixelFormat pixFormat = PixelFormat::RGBA, PixelType pixType = PixelType::UByte);
+
+		/**
+		 * @brief Overwrite a layer with an Image
+		 * 
+		 * If the Image is larger than a layer it is cropped, if it is smaller
+		 * the remainder of the layer is left untouched.
+		 * 
+		 * @param layer 	Index of the layer
+		 * @param image 	Image to fetch meta- and pixeldata from
+		 */
+		void SetLayer(unsigned int layer, const Image& image);
+
+		/**
+		 * @brief Get the dimensions of a single layer
+		 * 
+		 * @return A glm::uvec2 with the width and height of each layer
+		 */
+		inline glm::uvec2 GetDimensions() const { return glm::uvec2(extent.x, extent.y); }
+
+		/**
+		 * @brief Get the format of the texture
+		 * 
+		 * @return The internal format of the texture
+		 */
+		inline TextureFormat GetFormat() const { return format; }
+	};
+
+	/**
+	 * @brief An array of 1D Textures
+	 */
+	class Texture1DArray : public TextureArray
+	{
+	public:
+		/**
+		 * @brief Construct a new 1D array Texture without any pixeldata
+		 * 
+		 * @param width 		Width of each layer
+		 * @param layers 		Number of layers
+		 * @param texFormat 	Format of the texture
+		 * @param pixFormat 	Format of the pixel data that will be uploaded
+		 * @param pixType 		Datatype of each pixel that will be uploaded
+		 */
+		Texture1DArray(unsigned int width, unsigned int layers, TextureFormat texFormat = TextureFormat::RGBA8, PixelFormat pixFormat = PixelFormat::RGBA, PixelType pixType = PixelType::UByte);
+
+		/**
+		 * @brief Overwrite a layer with raw data
+		 * 
+		 * @param layer 		Index of the layer
+		 * @param data 			Pixel data with the same width as the layer
+		 * @param pixFormat 	Format of the pixel data
+		 * @param pixType 		Datatype of each pixel
+		 */
+		void SetLayer(unsigned int layer, const void* data, PixelFormat pixFormat = PixelFormat::RGBA, PixelType pixType = PixelType::UByte);
+
+		/**
+		 * @brief Overwrite a layer with an Image
+		 * 
+		 * Only the first row of pixels in the Image is used
+		 * 
+		 * @param layer 	Index of the layer
+		 * @param image 	Image to fetch meta- and pixeldata from
+		 */
+		void SetLayer(unsigned int layer, const Image& image);
+
+		/**
+		 * @brief Get the width of a single layer
+		 * 
+		 * @return Width of each layer
+		 */
+		inline unsigned int GetWidth() const { return extent.x; }
+
+		/**
+		 * @brief Get the format of the texture
+		 * 
+		 * @return The internal format of the texture
+		 */
+		inline TextureFormat GetFormat() const { return format; }
+	};
 }
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include <lol/Texture.hpp>
+#include <lol/util/NonCopyable.hpp>
+
+namespace lol
+{
+	class Image;
+
+	/**
+	 * @brief A single layer of a Texture2DArray
+	 * 
+	 * Objects that should be rendered with this texture bind `texture` and pass
+	 * `layer` to their shader (e.g. as a uniform or per-instance attribute).
+	 * Any two TextureLayers with the same `texture` can be rendered in one batch,
+	 * SpriteBatch::Draw(const TextureLayer&, const Sprite&) does exactly that.
+	 */
+	struct TextureLayer
+	{
+		std::shared_ptr<Texture2DArray> texture;	///< The array containing the layer
+		unsigned int layer;							///< Index of the layer inside the array
+	};
+
+	/**
+	 * @brief Sorts Images into Texture2DArrays by their size and format
+	 * 
+	 * Every Image inserted into the pool is put into the layer of an array that has the
+	 * same dimensions and format, a new array is created once all existing ones are full.
+	 * This way Images of equal size share as few textures as possible, so objects using
+	 * them can be batched together.
+	 */
+	class TextureArrayPool : public NonCopyable
+	{
+	public:
+		/**
+		 * @brief Construct a new, empty TextureArrayPool
+		 * 
+		 * @param layersPerArray Number of layers each newly created array has, at least 1
+		 */
+		TextureArrayPool(unsigned int layersPerArray = 64);
+
+		/**
+		 * @brief Upload an Image to a free layer
+		 * 
+		 * Only the base level is updated. Call UpdateMipmaps() once all Images
+		 * of this frame were inserted.
+		 * 
+		 * @param image 		The Image to upload
+		 * @param texFormat 	Format of the texture the Image should be stored in
+		 * @return 				The layer the Image was uploaded to
+		 */
+		TextureLayer Insert(const Image& image, TextureFormat texFormat = TextureFormat::RGBA8);
+
+		/**
+		 * @brief Release a layer so it can be reused by another Image
+		 * 
+		 * @param layer A layer previously returned by Insert()
+		 */
+		void Remove(const TextureLayer& layer);
+
+		/**
+		 * @brief Regenerate the mipmaps of all arrays that were modified since the last call
+		 */
+		void UpdateMipmaps();
+
+		/**
+		 * @brief Get the number of arrays created by the pool
+		 * 
+		 * @return Number of Texture2DArrays
+		 */
+		size_t GetArrayCount() const;
+
+	private:
+		/**
+		 * @brief An array of the pool and whether its mipmaps are outdated
+		 */
+		struct Entry
+		{
+			std::shared_ptr<Texture2DArray> texture;
+			bool dirty;
+		};
+
+		typedef std::tuple<unsigned int, unsigned int, TextureFormat> Key;
+
+	private:
+		unsigned int layersPerArray;
+		std::map<Key, std::vector<Entry>> arrays;
+	};
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <assert.h>
+#include <memory>
+#include <vector>
+
+#include <lol/Texture.hpp>
+#include <lol/util/BoundingBox.hpp>
+#include <lol/util/NonCopyable.hpp>
+#include <lol/util/SkylinePacker.hpp>
+
+namespace lol
+{
+	class Image;
+
+	/**
+	 * @brief Location of an Image inside a TextureAtlas
+	 */
+	struct AtlasRegion
+	{
+		static constexpr unsigned int NoPage = ~0u;	///< Page of empty Images, which aren't put on any page
+
+		unsigned int page;	///< Index of the atlas page (i.e. the Texture2D) the Image was put on
+		Rect bounds;		///< Area of the Image on the page in pixels
+		Rect uv;			///< Area of the Image on the page in texture coordinates
+
+		/**
+		 * @brief Check whether the region is empty, i.e. doesn't lie on any page
+		 */
+		inline bool IsEmpty() const { return page == NoPage; }
+	};
+
+	/**
+	 * @brief Packs many small Images into a few large Texture2Ds
+	 *
+	 * Every Image is surrounded by a gutter of `padding` pixels that repeats the Image's
+	 * edge pixels. This prevents neighbouring Images from bleeding into each other when
+	 * sampling with linear filtering or from lower mipmap levels.
+	 *
+	 * If an Image doesn't fit on any existing page a new page is created, so the atlas
+	 * can grow at runtime.
+	 */
+	class TextureAtlas : public NonCopyable
+	{
+	public:
+		/**
+		 * @brief Construct a new, empty TextureAtlas
+		 *
+		 * @param width 		Width of each atlas page
+		 * @param height 		Height of each atlas page
+		 * @param padding 		Width of the gutter around each Image in pixels
+		 * @param texFormat 	Format of the atlas pages
+		 */
+		TextureAtlas(unsigned int width = 2048, unsigned int height = 2048, unsigned int padding = 2, TextureFormat texFormat = TextureFormat::RGBA8);
+
+		/**
+		 * @brief Put an Image into the atlas
+		 *
+		 * Only the base level of the page is updated. Call UpdateMipmaps() once
+		 * all Images of this frame were inserted.
+		 *
+		 * @param image The Image to insert
+		 * @return 		The location of the Image inside the atlas, an empty region (see
+		 * 				AtlasRegion::IsEmpty()) if the Image has no pixels
+		 */
+		AtlasRegion Insert(const Image& image);
+
+		/**
+		 * @brief Put multiple Images into the atlas
+		 *
+		 * The Images are inserted from tallest to shortest, which packs
+		 * considerably tighter than inserting them one by one. Mipmaps are
+		 * updated afterwards.
+		 *
+		 * @param images 	The Images to insert
+		 * @return 			The location of each Image, in the same order as `images`
+		 */
+		std::vector<AtlasRegion> Insert(const std::vector<const Image*>& images);
+
+		/**
+		 * @brief Regenerate the mipmaps of all pages that were modified since the last call
+		 */
+		void UpdateMipmaps();
+
+		/**
+		 * @brief Get a page of the atlas
+		 *
+		 * @param index Index of the page (see AtlasRegion::page)
+		 * @return 		The Texture2D storing the page
+		 */
+		inline const std::shared_ptr<Texture2D>& GetPage(unsigned int index) const
+		{
+			assert(index < pages.size() && "lol::TextureAtlas::GetPage() index is out of bounds");
+			return pages[index].texture;
+		}
+
+		/**
+		 * @brief Get the number of pages in the atlas
+		 *
+		 * @return Number of pages
+		 */
+		inline size_t GetPageCount() const { return pages.size(); }
+
+	private:
+		/**
+		 * @brief One texture of the atlas and the packer that tracks its free space
+		 */
+		struct Page
+		{
+			std::shared_ptr<Texture2D> texture;
+			SkylinePacker packer;
+			bool dirty;
+		};
+
+		/**
+		 * @brief Copies the Image into a buffer with a gutter and uploads it to a page
+		 */
+		void Upload(Page& page, const glm::uvec2& position, const Image& image);
+
+	private:
+		glm::uvec2 pageSize;
+		unsigned int padding;
+		TextureFormat format;
+
+		std::vector<Page> pages;
+		std::vector<uint8_t> scratch;
+	};
+}
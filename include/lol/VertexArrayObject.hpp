@@ -61,6 +61,13 @@ namespace lol
 		 */
 		inline size_t GetIndexCount() { return elementBuffer->GetCount(); }
 
+		/**
+		 * @brief Returns the type of the indices inside the element buffer
+		 * 
+		 * @return Type of the elements in the EBO
+		 */
+		inline Type GetIndexType() { return elementBuffer->GetIndexType(); }
+
 	private:
 		unsigned int id;
 		std::shared_ptr<VertexBuffer> vertexBuffer;
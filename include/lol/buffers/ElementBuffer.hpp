@@ -18,6 +18,16 @@ namespace lol
 		 */
 		ElementBuffer(const std::vector<unsigned int>& elements, Usage usage = Usage::StaticDraw);
 
+		/**
+		 * @brief Construct a new ElementBuffer from raw indices, e.g. 16 bit ones read from a file
+		 * 
+		 * @param data 		Indices to put into the buffer
+		 * @param count 	Number of indices
+		 * @param indexType Type of the indices, Type::UByte, Type::UShort or Type::UInt
+		 * @param usage 	Hint OpenGL on how the buffer will be used
+		 */
+		ElementBuffer(const void* data, size_t count, Type indexType, Usage usage = Usage::StaticDraw);
+
 		/**
 		 * @brief Get the number of indices in the buffer
 		 * 
@@ -25,7 +35,13 @@ namespace lol
 		 */
 		inline size_t GetCount() const { return count; }
 
+		/**
+		 * @brief Get the type of the indices in the buffer
+		 */
+		inline Type GetIndexType() const { return indexType; }
+
 	private:
 		size_t count;
+		Type indexType;
 	};
 }
\ No newline at end of file
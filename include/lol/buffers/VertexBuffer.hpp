@@ -26,6 +26,11 @@ namespace lol
 		VertexAttribute(Type type, unsigned int count, bool normalized) :
 			type(type), size(count), normalized(normalized), offset(0)
 		{ }
+
+		/**
+		 * @brief Get the number of bytes the attribute takes up in a vertex
+		 */
+		inline size_t GetBytes() const { return IsPacked(type) ? SizeOf(type) : size * SizeOf(type); }
 	};
 
 	/**
@@ -41,6 +46,13 @@ namespace lol
 		 */
 		BufferLayout(const std::initializer_list<VertexAttribute>& attributes);
 
+		/**
+		 * @brief Construct a new BufferLayout from a layout that was put together at runtime
+		 * 
+		 * @param attributes A list of vertex attributes making up the layout
+		 */
+		BufferLayout(const std::vector<VertexAttribute>& attributes);
+
 		/**
 		 * @brief Returns the stored layout
 		 * 
@@ -91,6 +103,38 @@ namespace lol
 		 */
 		VertexBuffer(const std::vector<float>& data, Usage usage = Usage::StaticDraw);
 
+		/**
+		 * @brief Construct a new VertexBuffer with uninitialized storage
+		 * 
+		 * Meant for vertices that are written every frame, e.g. via SetData() or Update()
+		 * 
+		 * @param bytes Size of the buffer in bytes
+		 * @param usage Hint OpenGL on how the buffer will be used
+		 */
+		VertexBuffer(size_t bytes, Usage usage = Usage::StreamDraw);
+
+		/**
+		 * @brief Construct a new VertexBuffer from vertices that aren't floats, e.g. quantized ones
+		 * 
+		 * @param data 	Data to put into the buffer
+		 * @param bytes Size of the data in bytes
+		 * @param usage Hint OpenGL on how the buffer will be used
+		 */
+		VertexBuffer(const void* data, size_t bytes, Usage usage = Usage::StaticDraw);
+
+		/**
+		 * @brief Replace the storage of the buffer
+		 * 
+		 * The old storage is orphaned: draws that still use it aren't waited for, the
+		 * driver hands out fresh memory instead. This is the cheapest way to stream
+		 * vertices that change every frame.
+		 * 
+		 * @param data 	Data to put into the buffer, or `nullptr` to leave it uninitialized
+		 * @param bytes Size of the new storage in bytes
+		 * @param usage Hint OpenGL on how the buffer will be used
+		 */
+		void SetData(const void* data, size_t bytes, Usage usage = Usage::StreamDraw);
+
 		/**
 		 * @brief Set the BufferLayout of this VBO
 		 * 
@@ -3,9 +3,36 @@
 #include <lol/VertexArrayObject.hpp>
 #include <lol/Shader.hpp>
 #include <lol/Drawable.hpp>
+#include <lol/CommandBuffer.hpp>
+#include <lol/SpriteBatch.hpp>
+#include <lol/GlyphCache.hpp>
+#include <lol/Text.hpp>
+#include <lol/DebugDraw.hpp>
+#include <lol/Mesh.hpp>
 #include <lol/Transformable.hpp>
 #include <lol/Texture.hpp>
+#include <lol/TextureAtlas.hpp>
+#include <lol/TextureArrayPool.hpp>
+#include <lol/Framebuffer.hpp>
+#include <lol/AsyncReadback.hpp>
 #include <lol/Image.hpp>
 #include <lol/Camera.hpp>
 #include <lol/util/BoundingBox.hpp>
-#include <lol/Layer.hpp>
\ No newline at end of file
+#include <lol/util/ResidencyManager.hpp>
+#include <lol/util/Hash.hpp>
+#include <lol/util/ContentCache.hpp>
+#include <lol/util/ShaderCache.hpp>
+#include <lol/util/ShaderPreprocessor.hpp>
+#include <lol/util/ShaderVariants.hpp>
+#include <lol/util/Capabilities.hpp>
+#include <lol/util/JobSystem.hpp>
+#include <lol/util/Profiler.hpp>
+#include <lol/util/RenderStats.hpp>
+#include <lol/util/QuadIndices.hpp>
+#include <lol/util/VertexQuantizer.hpp>
+#include <lol/util/MappedFile.hpp>
+#include <lol/util/MeshConverter.hpp>
+#include <lol/util/DeletionQueue.hpp>
+#include <lol/Layer.hpp>
+#include <lol/LayerStack.hpp>
+#include <lol/Application.hpp>
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <string>
+
+namespace lol
+{
+	/**
+	 * @brief Check whether the current OpenGL context supports an extension
+	 *
+	 * The list of extensions is queried once, the first time this is called,
+	 * so a context must be current by then.
+	 *
+	 * @param name 	Name of the extension, e.g. `"GL_KHR_parallel_shader_compile"`
+	 * @return 		`true` if the extension is supported
+	 */
+	bool HasExtension(const std::string& name);
+
+	/**
+	 * @brief Check whether Buffer, Texture and VertexArray are edited through direct state access
+	 *
+	 * With direct state access (core since OpenGL 4.5) objects are created and edited by
+	 * their ID, instead of being bound first. This leaves the bindings of the context alone
+	 * and saves the bind calls. On older contexts the objects are bound to edit them.
+	 *
+	 * The first call decides based on the current context, so a context must be current by then.
+	 *
+	 * @return `true` if direct state access is used
+	 */
+	bool UsesDirectStateAccess();
+
+	/**
+	 * @brief Turn direct state access off, or back on if the context supports it
+	 *
+	 * Both ways create and edit the same OpenGL objects, e.g. to test the bind-to-edit path on
+	 * a new driver. Objects created without direct state access are bound once on creation,
+	 * because glGen*() only reserves a name and direct state access fails on names that were
+	 * never bound, so objects created before the switch stay usable after it.
+	 *
+	 * @param enable 	`false` to always bind objects to edit them
+	 */
+	void SetDirectStateAccess(bool enable);
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <lol/util/Enums.hpp>
+#include <lol/util/Hash.hpp>
+#include <lol/util/NonCopyable.hpp>
+
+namespace lol
+{
+	class Image;
+	class Texture2D;
+	class VertexBuffer;
+	class ElementBuffer;
+	class Shader;
+
+	/**
+	 * @brief Creates GPU resources only once per unique content
+	 *
+	 * Resources are identified by a hash of the data they are created from (plus any creation
+	 * parameters). If a resource with the same content already exists, that one is returned
+	 * instead of creating a new one. The cache only holds weak references, so a resource is
+	 * destroyed as usual once nobody uses it anymore.
+	 *
+	 * Since deduplicated resources are shared, modifying one (e.g. VertexBuffer::SetLayout() or
+	 * Texture::SetWrap()) affects everyone using the same content.
+	 */
+	class ContentCache : public NonCopyable
+	{
+	public:
+		/**
+		 * @brief Construct a new, empty ContentCache
+		 */
+		ContentCache();
+
+		/**
+		 * @brief Get a Texture2D with the contents of an Image
+		 *
+		 * @param image 		Image to fetch meta- and pixeldata from
+		 * @param texFormat 	Format of the texture
+		 * @return 				A new or existing texture
+		 */
+		std::shared_ptr<Texture2D> GetTexture2D(const Image& image, TextureFormat texFormat = TextureFormat::RGB);
+
+		/**
+		 * @brief Get a VertexBuffer with the given data
+		 *
+		 * @param data 	Data to put into the buffer
+		 * @param usage Hint OpenGL on how the buffer will be used
+		 * @return 		A new or existing buffer
+		 */
+		std::shared_ptr<VertexBuffer> GetVertexBuffer(const std::vector<float>& data, Usage usage = Usage::StaticDraw);
+
+		/**
+		 * @brief Get an ElementBuffer with the given indices
+		 *
+		 * @param elements 	Data to put into the buffer
+		 * @param usage 	Hint OpenGL on how the buffer will be used
+		 * @return 			A new or existing buffer
+		 */
+		std::shared_ptr<ElementBuffer> GetElementBuffer(const std::vector<unsigned int>& elements, Usage usage = Usage::StaticDraw);
+
+		/**
+		 * @brief Get a Shader compiled from the given sources
+		 *
+		 * @param vertexShader 		Source code of the vertex shader
+		 * @param fragmentShader 	Source code of the fragment shader
+		 * @return 					A new or existing shader
+		 */
+		std::shared_ptr<Shader> GetShader(const std::string& vertexShader, const std::string& fragmentShader);
+
+		/**
+		 * @brief Forget about resources that were destroyed
+		 */
+		void ClearExpired();
+
+		/**
+		 * @brief Get how much video memory was saved by returning existing resources
+		 *
+		 * @return Sum of the sizes of all Textures and Buffers that didn't have to be created
+		 */
+		inline size_t GetDeduplicatedBytes() const { return deduplicatedBytes.load(std::memory_order_relaxed); }
+
+		/**
+		 * @brief Get how often an existing resource was returned
+		 *
+		 * @return Number of cache hits
+		 */
+		inline size_t GetHits() const { return hits.load(std::memory_order_relaxed); }
+
+		/**
+		 * @brief Get how often a new resource had to be created
+		 *
+		 * @return Number of cache misses
+		 */
+		inline size_t GetMisses() const { return misses.load(std::memory_order_relaxed); }
+
+	private:
+		/**
+		 * @brief Return the resource stored for a hash, or create and store a new one
+		 *
+		 * `size` is called on cache hits to compute the number of deduplicated bytes.
+		 */
+		template<typename T, typename Create, typename Size>
+		std::shared_ptr<T> GetOrCreate(const Hash128& hash, Create&& create, Size&& size);
+
+	private:
+		std::mutex mutex;
+		std::unordered_map<Hash128, std::weak_ptr<void>> resources;
+
+		// Written under `mutex`, but atomic so the getters don't need to take it
+		std::atomic<size_t> deduplicatedBytes;
+		std::atomic<size_t> hits;
+		std::atomic<size_t> misses;
+	};
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include <lol/util/NonCopyable.hpp>
+
+namespace lol
+{
+	/**
+	 * @brief Kinds of OpenGL objects the DeletionQueue can delete
+	 */
+	enum class ObjectType
+	{
+		Buffer,
+		Texture,
+		VertexArray,
+		Program,
+		Shader,
+		Framebuffer,
+		Renderbuffer,
+
+		Count
+	};
+
+	/**
+	 * @brief Deletes OpenGL objects once the GPU is done with them
+	 *
+	 * The destructors of Buffer, Texture, VertexArray, Shader, Framebuffer and Renderbuffer
+	 * hand their objects to this queue. While the queue is enabled they aren't deleted right
+	 * away but kept until the GPU is done with them. That works on any thread, so lol objects
+	 * may be dropped by worker threads too, and it doesn't stall the driver when a lot of
+	 * objects are dropped at once, e.g. when ObjectManager::ClearUnused() releases the
+	 * resources of a whole level.
+	 *
+	 * NewFrame() puts a fence behind the commands of the frame and files everything released
+	 * during the frame under it. An object can't be used anymore once it is released, so the
+	 * last frame using it is at most the one it was released in. Once that fence has signaled,
+	 * the objects are deleted, at most `budget` of them per frame.
+	 *
+	 * Queued objects are only deleted by NewFrame() and Flush(), so the queue is disabled by
+	 * default and objects are deleted immediately by their destructors, which then have to
+	 * run on the thread owning the OpenGL context. Application enables it and calls NewFrame()
+	 * at the end of every frame. With a custom loop, call SetEnabled(true) and then NewFrame()
+	 * once per frame on the thread owning the context. Call Flush() before destroying the
+	 * context in either case, HeadlessContext does so.
+	 */
+	class DeletionQueue : public NonCopyable
+	{
+	public:
+		/**
+		 * @brief Get the queue shared by all threads
+		 */
+		static DeletionQueue& Get();
+
+		/**
+		 * @brief Queue an object for deletion, or delete it right away if the queue is disabled
+		 *
+		 * Can be called from any thread while the queue is enabled, otherwise only on the
+		 * thread owning the OpenGL context.
+		 *
+		 * @param type 	Kind of the object
+		 * @param id 	Name of the object, 0 is ignored
+		 */
+		void Release(ObjectType type, unsigned int id);
+
+		/**
+		 * @brief Fence the objects released during this frame and delete the ones that are no longer in use
+		 *
+		 * Must be called on the thread owning the OpenGL context, after the last draw of the frame.
+		 */
+		void NewFrame();
+
+		/**
+		 * @brief Wait for the GPU and delete all queued objects, regardless of the budget
+		 *
+		 * Must be called on the thread owning the OpenGL context, e.g. before destroying it.
+		 */
+		void Flush();
+
+		/**
+		 * @brief Turn queueing on or off
+		 *
+		 * Only enable it if NewFrame() is called every frame, otherwise the objects are never
+		 * deleted. Objects queued before disabling it are still deleted by NewFrame() and Flush().
+		 *
+		 * @param enable 	`true` to queue released objects, `false` to delete them immediately
+		 */
+		void SetEnabled(bool enable);
+
+		/**
+		 * @brief Whether released objects are queued, see SetEnabled()
+		 */
+		bool IsEnabled() const;
+
+		/**
+		 * @brief Set how many objects NewFrame() may delete at most
+		 *
+		 * Objects that don't fit into the budget are deleted during the next frames, in the
+		 * order they were released. The default is 256.
+		 *
+		 * @param objects 	Maximum number of objects deleted per frame, at least 1
+		 */
+		void SetBudget(size_t objects);
+
+		/**
+		 * @brief Get the number of objects that were released but not deleted yet
+		 */
+		size_t GetPendingCount();
+
+	private:
+		struct Object
+		{
+			ObjectType type;
+			unsigned int id;
+		};
+
+		/**
+		 * @brief Objects released during one frame, and the fence behind that frame
+		 */
+		struct Batch
+		{
+			std::vector<Object> objects;
+			size_t next;				///< Index of the first object that wasn't deleted yet
+			void* fence;				///< `nullptr` once the fence has signaled
+		};
+
+		DeletionQueue();
+
+		/**
+		 * @brief Fence the objects released since the last call
+		 */
+		void Submit();
+
+		/**
+		 * @brief Delete up to `count` objects of a batch, grouped into one call per type
+		 */
+		void Delete(Batch& batch, size_t count);
+
+	private:
+		std::mutex mutex;
+		std::vector<Object> released;		///< Released since the last NewFrame(), guarded by `mutex`
+		std::deque<Batch> batches;			///< Fenced, only touched on the OpenGL thread
+		size_t budget;
+		size_t pending;						///< Number of objects in `batches`, guarded by `mutex`
+		std::atomic<bool> enabled;
+
+		std::vector<unsigned int> names[(size_t)ObjectType::Count];
+	};
+}
@@ -22,11 +22,23 @@ namespace lol
 		Half			= GL_HALF_FLOAT,		///< 16 bit half-precision floating point number
 		Float			= GL_FLOAT,				///< 32 bit single-precision floating point number
 		Double			= GL_DOUBLE,			///< 64 bit double-precision floating point number
-		Fixed			= GL_FIXED				///< 32 bit 16.16 fixed decimal number
+		Fixed			= GL_FIXED,				///< 32 bit 16.16 fixed decimal number
+		Int2101010		= GL_INT_2_10_10_10_REV,			///< 4 signed integers packed into 32 bits, 10 bits for x, y and z, 2 bits for w
+		UInt2101010		= GL_UNSIGNED_INT_2_10_10_10_REV	///< 4 unsigned integers packed into 32 bits, 10 bits for x, y and z, 2 bits for w
 	};
 
+	/**
+	 * @brief Whether a datatype packs all components of a vertex attribute into one value
+	 */
+	constexpr bool IsPacked(Type type)
+	{
+		return type == Type::Int2101010 || type == Type::UInt2101010;
+	}
+
 	/**
 	 * @brief Get size of OpenGL datatype in Bytes
+	 * 
+	 * For packed datatypes this is the size of all components together.
 	 */
 	constexpr size_t SizeOf(Type type)
 	{
@@ -35,12 +47,15 @@ namespace lol
 		case Type::Byte:			return sizeof(GLbyte); 
 		case Type::UByte:			return sizeof(GLubyte); 
 		case Type::Short:			return sizeof(GLshort); 
+		case Type::UShort:			return sizeof(GLushort); 
 		case Type::Int:				return sizeof(GLint); 
 		case Type::UInt:			return sizeof(GLuint); 
 		case Type::Half:			return sizeof(GLhalf); 
 		case Type::Float:			return sizeof(GLfloat); 
 		case Type::Double:			return sizeof(GLdouble); 
 		case Type::Fixed:			return sizeof(GLfixed);
+		case Type::Int2101010:		return sizeof(GLuint);
+		case Type::UInt2101010:		return sizeof(GLuint);
 
 		default:
 			assert(false && "lol::SizeOf(Type) did not implement every datatype");
@@ -269,6 +284,11 @@ namespace lol
 	{
 		DepthComponent	= GL_DEPTH_COMPONENT,							///< Texture stores depth information
 		DepthStencil	= GL_DEPTH_STENCIL,								///< Texture stores depth and stencil information
+		Depth16			= GL_DEPTH_COMPONENT16,							///< Depth, unsigned normalized integers, 16 bits
+		Depth24			= GL_DEPTH_COMPONENT24,							///< Depth, unsigned normalized integers, 24 bits
+		Depth32F		= GL_DEPTH_COMPONENT32F,						///< Depth, floating points, 32 bits
+		Depth24Stencil8	= GL_DEPTH24_STENCIL8,							///< Depth and stencil, 24 bits unsigned normalized depth, 8 bits unsigned integer stencil
+		Depth32FStencil8 = GL_DEPTH32F_STENCIL8,						///< Depth and stencil, 32 bits floating point depth, 8 bits unsigned integer stencil
 		R				= GL_RED,										///< 1 channel, unsigned normalized integer
 		RG				= GL_RG,										///< 2 channels, unsigned normalized integers, OpenGL chooses the bitdepth
 		RGB				= GL_RGB,										///< 3 channels, unsigned normalized integers, OpenGL chooses the bitdepth
@@ -396,7 +416,8 @@ namespace lol
 		UInt8888		= GL_UNSIGNED_INT_8_8_8_8,				///< R = 8 Bits, G = 8 Bits, B = 8 Bits, A = 8 Bits (RGBA)
 		UInt8888Rev		= GL_UNSIGNED_INT_8_8_8_8_REV,			///< R = 8 Bits, G = 8 Bits, B = 8 Bits, A = 8 Bits (ABGR)
 		UInt1010102		= GL_UNSIGNED_INT_10_10_10_2,			///< R = 10 Bits, G = 10 Bits, B = 10 Bits, A = 10 Bits (RGBA)
-		UInt1010102Rev	= GL_UNSIGNED_INT_2_10_10_10_REV		///< R = 10 Bits, G = 10 Bits, B = 10 Bits, A = 10 Bits (ABGR)
+		UInt1010102Rev	= GL_UNSIGNED_INT_2_10_10_10_REV,		///< R = 10 Bits, G = 10 Bits, B = 10 Bits, A = 10 Bits (ABGR)
+		UInt248			= GL_UNSIGNED_INT_24_8					///< Depth = 24 Bits, Stencil = 8 Bits (DepthStencil)
 	};
 
 	/**
@@ -433,6 +454,7 @@ namespace lol
 		case PixelType::UInt8888Rev:
 		case PixelType::UInt1010102:
 		case PixelType::UInt1010102Rev:
+		case PixelType::UInt248:
 		case PixelType::UInt:			
 			return sizeof(GLuint);
 
@@ -445,6 +467,89 @@ namespace lol
 		}
 	}
 
+	/**
+	 * @brief Get number of components per pixel of an OpenGL pixel format
+	 */
+	constexpr size_t ChannelsOf(PixelFormat format)
+	{
+		switch (format)
+		{
+		case PixelFormat::R:
+		case PixelFormat::RI:
+		case PixelFormat::StencilIndex:
+		case PixelFormat::DepthComponent:
+			return 1;
+
+		case PixelFormat::RG:
+		case PixelFormat::RGI:
+		case PixelFormat::DepthStencil:
+			return 2;
+
+		case PixelFormat::RGB:
+		case PixelFormat::BGR:
+		case PixelFormat::RGBI:
+		case PixelFormat::BGRI:
+			return 3;
+
+		case PixelFormat::RGBA:
+		case PixelFormat::BGRA:
+		case PixelFormat::RGBAI:
+		case PixelFormat::BGRAI:
+			return 4;
+
+		default:
+			assert(false && "lol::ChannelsOf(PixelFormat) did not implement every format");
+			return 0;
+		}
+	}
+
+	/**
+	 * @brief Get size of one pixel in Bytes
+	 *
+	 * Packed pixel types (e.g. PixelType::UShort565) store all components in a single value
+	 */
+	constexpr size_t SizeOf(PixelFormat format, PixelType type)
+	{
+		switch (type)
+		{
+		case PixelType::UByte332:
+		case PixelType::UByte233Rev:
+		case PixelType::UShort565:
+		case PixelType::UShort565Rev:
+		case PixelType::UShort4444:
+		case PixelType::UShort4444Rev:
+		case PixelType::UShort5551:
+		case PixelType::UShort1555Rev:
+		case PixelType::UInt8888:
+		case PixelType::UInt8888Rev:
+		case PixelType::UInt1010102:
+		case PixelType::UInt1010102Rev:
+		case PixelType::UInt248:
+			return SizeOf(type);
+
+		default:
+			return ChannelsOf(format) * SizeOf(type);
+		}
+	}
+
+	/**
+	 * @brief Attachment points of a Framebuffer
+	 */
+	enum class FramebufferAttachment : GLenum
+	{
+		Color0			= GL_COLOR_ATTACHMENT0,			///< First color output of the fragment shader
+		Color1			= GL_COLOR_ATTACHMENT1,			///< Second color output of the fragment shader
+		Color2			= GL_COLOR_ATTACHMENT2,			///< Third color output of the fragment shader
+		Color3			= GL_COLOR_ATTACHMENT3,			///< Fourth color output of the fragment shader
+		Color4			= GL_COLOR_ATTACHMENT4,			///< Fifth color output of the fragment shader
+		Color5			= GL_COLOR_ATTACHMENT5,			///< Sixth color output of the fragment shader
+		Color6			= GL_COLOR_ATTACHMENT6,			///< Seventh color output of the fragment shader
+		Color7			= GL_COLOR_ATTACHMENT7,			///< Eighth color output of the fragment shader
+		Depth			= GL_DEPTH_ATTACHMENT,			///< Depth buffer
+		Stencil			= GL_STENCIL_ATTACHMENT,		///< Stencil buffer
+		DepthStencil	= GL_DEPTH_STENCIL_ATTACHMENT	///< Combined depth and stencil buffer
+	};
+
 	enum class TextureWrap : GLenum
 	{
 		ClampToEdge 		= GL_CLAMP_TO_EDGE,				///< Pixels outside of texture get the textures edge color
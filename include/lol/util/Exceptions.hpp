@@ -25,4 +25,100 @@ namespace lol
             std::runtime_error("Failed to Get() object with ID " + std::to_string(id) + " from ObjectManager. It does not exist.")
         { }
     };
+
+    /**
+     * @brief The Image can never fit into a TextureAtlas
+     * 
+     * Thrown by TextureAtlas::Insert() if the Image (including its padding)
+     * is larger than a single page of the atlas
+     */
+    class ImageTooLargeException : public std::runtime_error
+    {
+    public:
+        /**
+         * @brief Construct a new ImageTooLargeException
+         * 
+         * @param width     Width of the image that was inserted
+         * @param height    Height of the image that was inserted
+         */
+        ImageTooLargeException(unsigned int width, unsigned int height) :
+            std::runtime_error("Failed to Insert() image of size " + std::to_string(width) + "x" + std::to_string(height) + " into TextureAtlas. It is larger than an atlas page.")
+        { }
+    };
+
+    /**
+     * @brief A shader #include couldn't be resolved
+     * 
+     * Thrown by ShaderPreprocessor::Process() if an included file is neither
+     * a registered source nor found in any of the include paths
+     */
+    class ShaderIncludeException : public std::runtime_error
+    {
+    public:
+        /**
+         * @brief Construct a new ShaderIncludeException
+         * 
+         * @param name  Name of the file that was included
+         */
+        ShaderIncludeException(const std::string& name) :
+            std::runtime_error("Failed to resolve shader #include \"" + name + "\". It is not a registered source and not in any include path.")
+        { }
+    };
+
+    /**
+     * @brief No headless OpenGL context could be created
+     * 
+     * Thrown by the HeadlessContext constructor, e.g. if no EGL display is available
+     * or the driver doesn't support the requested OpenGL version
+     */
+    class HeadlessContextException : public std::runtime_error
+    {
+    public:
+        /**
+         * @brief Construct a new HeadlessContextException
+         * 
+         * @param reason    The step that failed
+         */
+        HeadlessContextException(const std::string& reason) :
+            std::runtime_error("Failed to create a headless OpenGL context. " + reason)
+        { }
+    };
+
+    /**
+     * @brief A file couldn't be mapped into memory
+     * 
+     * Thrown by the MappedFile constructor, e.g. if the file doesn't exist
+     */
+    class FileMappingException : public std::runtime_error
+    {
+    public:
+        /**
+         * @brief Construct a new FileMappingException
+         * 
+         * @param path  Path of the file
+         */
+        FileMappingException(const std::string& path) :
+            std::runtime_error("Failed to map file \"" + path + "\" into memory.")
+        { }
+    };
+
+    /**
+     * @brief A mesh file is malformed or can't be converted
+     * 
+     * Thrown by the Mesh constructor if a file isn't a valid mesh file, and by
+     * the mesh converters if the source file can't be parsed
+     */
+    class MeshFileException : public std::runtime_error
+    {
+    public:
+        /**
+         * @brief Construct a new MeshFileException
+         * 
+         * @param path      Path of the file
+         * @param reason    What is wrong with the file
+         */
+        MeshFileException(const std::string& path, const std::string& reason) :
+            std::runtime_error("Invalid mesh file \"" + path + "\". " + reason)
+        { }
+    };
 }
\ No newline at end of file
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lol
+{
+	class Image;
+
+	/**
+	 * @brief A 128 bit hash value
+	 */
+	struct Hash128
+	{
+		uint64_t low;
+		uint64_t high;
+
+		inline bool operator==(const Hash128& other) const { return low == other.low && high == other.high; }
+		inline bool operator!=(const Hash128& other) const { return !(*this == other); }
+
+		/**
+		 * @brief Format the hash as 32 hexadecimal digits
+		 *
+		 * @return The hash as a string
+		 */
+		std::string ToString() const;
+	};
+
+	/**
+	 * @brief Hash a block of memory with MurmurHash3 (x64, 128 bit)
+	 *
+	 * This is a fast non-cryptographic hash, don't use it for anything security related.
+	 *
+	 * @param data 	Pointer to the data
+	 * @param size 	Number of bytes to hash
+	 * @param seed 	Seed of the hash
+	 * @return 		The hash of the data
+	 */
+	Hash128 HashBytes(const void* data, size_t size, uint64_t seed = 0);
+
+	/**
+	 * @brief Mix two hashes into a new one
+	 *
+	 * The order of the hashes matters.
+	 */
+	Hash128 HashCombine(const Hash128& first, const Hash128& second);
+
+	/**
+	 * @brief Hash a potentially large blob of memory
+	 *
+	 * Blobs larger than a few megabytes are split into chunks which are hashed in parallel,
+	 * the final hash is then computed from the hashes of all chunks. Because of this the result
+	 * differs from HashBytes() for large blobs, but it doesn't depend on the number of threads.
+	 *
+	 * @param data 	Pointer to the data
+	 * @param size 	Number of bytes to hash
+	 * @return 		The hash of the data
+	 */
+	Hash128 HashContent(const void* data, size_t size);
+
+	/**
+	 * @brief Hash the metadata and pixels of an Image
+	 *
+	 * Padding bytes between rows are ignored, so two Images with the same pixels
+	 * but different row alignments produce the same hash.
+	 */
+	Hash128 HashContent(const Image& image);
+
+	/**
+	 * @brief Hash vertex data
+	 */
+	Hash128 HashContent(const std::vector<float>& vertices);
+
+	/**
+	 * @brief Hash index data
+	 */
+	Hash128 HashContent(const std::vector<unsigned int>& indices);
+
+	/**
+	 * @brief Hash a string, e.g. shader source code
+	 */
+	Hash128 HashContent(const std::string& text);
+}
+
+namespace std
+{
+	/**
+	 * @brief Allows Hash128 to be used as a key in unordered containers
+	 */
+	template<>
+	struct hash<lol::Hash128>
+	{
+		size_t operator()(const lol::Hash128& hash) const { return (size_t)(hash.low ^ (hash.high * 0x9E3779B97F4A7C15ull)); }
+	};
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <lol/util/NonCopyable.hpp>
+
+namespace lol
+{
+	/**
+	 * @brief An OpenGL context that doesn't need a window or a display
+	 *
+	 * Meant for rendering on servers and in batch jobs. The context is created through EGL,
+	 * preferring Mesa's surfaceless platform, which works without a display server and with
+	 * software rasterizers like llvmpipe. If EGL isn't available, OSMesa is used instead (see
+	 * the `LOL_BUILD_HEADLESS` CMake option).
+	 *
+	 * There is no usable default framebuffer, render into a Framebuffer instead.
+	 *
+	 * The context is made current on the constructing thread and the OpenGL functions are
+	 * loaded, so the rest of the library can be used right away.
+	 */
+	class HeadlessContext : public NonCopyable
+	{
+	public:
+		/**
+		 * @brief Create a core profile context and make it current
+		 *
+		 * Throws a HeadlessContextException if no context can be created.
+		 *
+		 * @param major 	Requested major OpenGL version
+		 * @param minor 	Requested minor OpenGL version
+		 */
+		HeadlessContext(int major = 3, int minor = 3);
+
+		/**
+		 * @brief Release the context
+		 *
+		 * All objects created with the context need to be destroyed beforehand.
+		 */
+		~HeadlessContext();
+
+		/**
+		 * @brief Make the context current on the calling thread
+		 */
+		void MakeCurrent();
+
+		/**
+		 * @brief Get the name of the renderer, e.g. to tell hardware and software rendering apart
+		 *
+		 * @return The `GL_RENDERER` string
+		 */
+		std::string GetRenderer() const;
+
+	private:
+		void* display;
+		void* surface;
+		void* context;
+
+		std::vector<unsigned char> colorBuffer;	///< OSMesa always needs a buffer to render into
+	};
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <lol/util/NonCopyable.hpp>
+
+namespace lol
+{
+	/**
+	 * @brief Provides the pixel memory for Images
+	 *
+	 * Derive from this to control where Images get their memory from. The allocator
+	 * has to outlive every Image that was created with it.
+	 */
+	class ImageAllocator : public NonCopyable
+	{
+	public:
+		virtual ~ImageAllocator() {}
+
+		/**
+		 * @brief Allocate a block of memory
+		 *
+		 * @param size 		Number of bytes to allocate
+		 * @param alignment Required alignment of the block, a power of two
+		 * @return 			Pointer to the block
+		 */
+		virtual void* Allocate(size_t size, size_t alignment) = 0;
+
+		/**
+		 * @brief Release a block previously returned by Allocate()
+		 *
+		 * @param block 	Pointer to the block
+		 * @param size 		Size the block was allocated with
+		 * @param alignment Alignment the block was allocated with
+		 */
+		virtual void Deallocate(void* block, size_t size, size_t alignment) = 0;
+
+		/**
+		 * @brief Get the allocator Images use if none is specified
+		 *
+		 * Allocates aligned blocks directly from the heap
+		 *
+		 * @return The default allocator
+		 */
+		static ImageAllocator& Default();
+	};
+
+	/**
+	 * @brief An ImageAllocator that recycles blocks instead of freeing them
+	 *
+	 * Released blocks are kept in a free list per size, so creating Images of the same
+	 * dimensions over and over (e.g. when streaming video frames or tiles) doesn't have to
+	 * go through the heap after the first few frames. The pool can be used from multiple
+	 * threads at once.
+	 */
+	class ImagePool : public ImageAllocator
+	{
+	public:
+		/**
+		 * @brief Construct a new, empty ImagePool
+		 *
+		 * @param capacity Maximum number of bytes kept in the free lists. Blocks released while the pool is full are freed.
+		 */
+		ImagePool(size_t capacity = 256 * 1024 * 1024);
+
+		/**
+		 * @brief Frees all cached blocks
+		 */
+		~ImagePool();
+
+		void* Allocate(size_t size, size_t alignment) override;
+		void Deallocate(void* block, size_t size, size_t alignment) override;
+
+		/**
+		 * @brief Free all cached blocks
+		 */
+		void Trim();
+
+		/**
+		 * @brief Get the number of bytes currently held in the free lists
+		 *
+		 * @return Number of cached bytes
+		 */
+		size_t GetCachedBytes();
+
+	private:
+		size_t capacity;
+		size_t cachedBytes;
+
+		std::mutex mutex;
+		std::map<std::pair<size_t, size_t>, std::vector<void*>> freeBlocks;
+	};
+}
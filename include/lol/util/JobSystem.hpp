@@ -0,0 +1,191 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <lol/util/NonCopyable.hpp>
+
+namespace lol
+{
+	/**
+	 * @brief A set of jobs that can be waited for together
+	 *
+	 * Jobs can be added to a group from any thread, including from jobs of the same group.
+	 */
+	class JobGroup : public NonCopyable
+	{
+		friend class JobSystem;
+
+	public:
+		JobGroup();
+
+		/**
+		 * @brief Check whether all jobs of the group have finished
+		 *
+		 * @return `true` if no job of the group is queued or running
+		 */
+		inline bool IsDone() const { return pending.load(std::memory_order_acquire) == 0; }
+
+	private:
+		std::atomic<size_t> pending;
+
+		std::mutex errorMutex;
+		std::exception_ptr error;
+	};
+
+	/**
+	 * @brief Runs jobs on a pool of worker threads
+	 *
+	 * Every worker has its own queue. Jobs submitted from a worker go to the back of its
+	 * own queue, and the worker takes its newest job first, which keeps related data in its
+	 * cache. Workers that run out of jobs steal the oldest jobs of other workers, which tend
+	 * to be the largest pieces of work. Jobs submitted from other threads go into a shared
+	 * queue that every worker steals from.
+	 *
+	 * Threads waiting for a JobGroup run jobs themselves instead of blocking, so waiting
+	 * from inside a job never deadlocks the pool.
+	 *
+	 * OpenGL calls can only be made on the thread owning the context, so jobs that need
+	 * the GPU are queued with RunOnMainThread() and executed by ProcessMainThreadJobs().
+	 */
+	class JobSystem : public NonCopyable
+	{
+	public:
+		/**
+		 * @brief Start a new pool of worker threads
+		 *
+		 * With 0 workers, jobs only run on threads that call Wait().
+		 *
+		 * @param workers Number of worker threads
+		 */
+		JobSystem(unsigned int workers = DefaultWorkerCount());
+
+		/**
+		 * @brief Runs all remaining jobs and stops the worker threads
+		 */
+		~JobSystem();
+
+		/**
+		 * @brief Get the job system shared by the library
+		 *
+		 * It is created on first use, with DefaultWorkerCount() workers.
+		 *
+		 * @return The shared job system
+		 */
+		static JobSystem& Default();
+
+		/**
+		 * @brief Get the number of workers that keeps all cores busy alongside the main thread
+		 *
+		 * @return One less than the number of hardware threads, but at least 1
+		 */
+		static unsigned int DefaultWorkerCount();
+
+		/**
+		 * @brief Queue a job
+		 *
+		 * @param group The group the job belongs to, it must outlive the job
+		 * @param job 	The function to run
+		 */
+		void Run(JobGroup& group, std::function<void()> job);
+
+		/**
+		 * @brief Wait until all jobs of a group finished, running queued jobs in the meantime
+		 *
+		 * If any job of the group threw an exception, the first one is rethrown here.
+		 *
+		 * @param group The group to wait for
+		 */
+		void Wait(JobGroup& group);
+
+		/**
+		 * @brief Call a function for all subranges of [begin, end) in parallel
+		 *
+		 * The range is split in half recursively, and the halves are handed out as jobs, so
+		 * idle workers steal large pieces first and busy workers keep splitting off smaller
+		 * ones. Ranges are never split below `grain` elements. Returns once the whole range
+		 * was processed.
+		 *
+		 * @param begin First index
+		 * @param end 	One past the last index
+		 * @param body 	Function taking the first and one past the last index of a subrange
+		 * @param grain Smallest subrange worth a job of its own, 0 to pick one based on the worker count
+		 */
+		void ParallelFor(size_t begin, size_t end, const std::function<void(size_t, size_t)>& body, size_t grain = 0);
+
+		/**
+		 * @brief Queue a job to run on the main thread
+		 *
+		 * @param job The function to run, e.g. an upload to the GPU
+		 */
+		void RunOnMainThread(std::function<void()> job);
+
+		/**
+		 * @brief Run jobs queued with RunOnMainThread()
+		 *
+		 * Must be called regularly from the thread that owns the OpenGL context. At least
+		 * one job is run per call, if there are any.
+		 *
+		 * @param budget 	Stop starting new jobs after this much time
+		 * @return 			Number of jobs that were run
+		 */
+		size_t ProcessMainThreadJobs(std::chrono::microseconds budget = std::chrono::microseconds::max());
+
+		/**
+		 * @brief Get the number of worker threads
+		 *
+		 * @return Number of workers, not counting threads that help out in Wait()
+		 */
+		inline unsigned int GetWorkerCount() const { return (unsigned int)threads.size(); }
+
+	private:
+		struct Job
+		{
+			std::function<void()> function;
+			JobGroup* group;
+		};
+
+		struct Queue
+		{
+			std::mutex mutex;
+			std::deque<Job> jobs;
+		};
+
+		/**
+		 * @brief Take a job from the given queue, or steal one from any other queue
+		 */
+		bool TryPop(size_t queue, Job& job);
+
+		/**
+		 * @brief Run a job and mark it as finished in its group
+		 */
+		void Execute(Job& job);
+
+		/**
+		 * @brief Get the queue the calling thread owns, or the shared queue for other threads
+		 */
+		size_t QueueOfThisThread() const;
+
+		void WorkerLoop(size_t index);
+
+	private:
+		std::vector<std::unique_ptr<Queue>> queues;	///< One per worker, plus the shared queue at the end
+		std::vector<std::thread> threads;
+
+		std::atomic<size_t> queuedJobs;
+		std::atomic<bool> stopping;
+		std::mutex sleepMutex;
+		std::condition_variable wakeup;
+
+		std::mutex mainThreadMutex;
+		std::deque<std::function<void()>> mainThreadJobs;
+	};
+}
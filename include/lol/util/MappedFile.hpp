@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <lol/util/NonCopyable.hpp>
+
+namespace lol
+{
+	/**
+	 * @brief A file mapped read-only into memory
+	 *
+	 * The operating system pages the file in as it is read, so uploading its contents to
+	 * OpenGL reads straight from the page cache without copying the file into a buffer first.
+	 * The mapping stays valid until the MappedFile is destroyed.
+	 */
+	class MappedFile : public NonCopyable
+	{
+	public:
+		/**
+		 * @brief Map a file into memory
+		 *
+		 * @param path 	Path of the file
+		 * @throws FileMappingException if the file can't be opened or mapped
+		 */
+		MappedFile(const std::string& path);
+		~MappedFile();
+
+		/**
+		 * @brief Get the contents of the file, `nullptr` if the file is empty
+		 */
+		inline const uint8_t* GetData() const { return data; }
+
+		/**
+		 * @brief Get the size of the file in bytes
+		 */
+		inline size_t GetSize() const { return size; }
+
+	private:
+		const uint8_t* data;
+		size_t size;
+
+#ifdef _WIN32
+		void* file;
+		void* mapping;
+#endif
+	};
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <istream>
+#include <string>
+
+#include <lol/Mesh.hpp>
+
+namespace lol
+{
+	/**
+	 * @brief Options for converting meshes into mesh files
+	 */
+	struct MeshConvertOptions
+	{
+		bool quantize = true;		///< Store positions as Bounds16, normals as Octahedral16 and texture coordinates as Half (see VertexQuantizer)
+	};
+
+	/**
+	 * @brief Convert a Wavefront OBJ mesh
+	 *
+	 * Reads positions, normals and texture coordinates. Polygons are triangulated as fans,
+	 * corners that share all of their attributes become one vertex. Every `o`, `g` and
+	 * `usemtl` statement starts a new submesh.
+	 *
+	 * The vertices have the attributes position (3 components), normal (3 components, only
+	 * if the file has normals) and texture coordinate (2 components, only if the file has
+	 * texture coordinates), in this order. Corners without a normal or texture coordinate
+	 * get zeros.
+	 *
+	 * @param stream 	The OBJ file
+	 * @param options 	How to store the vertices
+	 * @param name 		Name of the file used in error messages
+	 * @return 			The converted mesh, ready for Mesh::Write()
+	 * @throws MeshFileException if the file refers to vertices it doesn't have
+	 */
+	MeshData ConvertOBJ(std::istream& stream, const MeshConvertOptions& options = MeshConvertOptions(), const std::string& name = "<stream>");
+
+	/**
+	 * @brief Convert a Wavefront OBJ file, see ConvertOBJ(std::istream&, const MeshConvertOptions&, const std::string&)
+	 *
+	 * @param path 		Path of the OBJ file
+	 * @param options 	How to store the vertices
+	 * @return 			The converted mesh, ready for Mesh::Write()
+	 * @throws MeshFileException if the file can't be opened or refers to vertices it doesn't have
+	 */
+	MeshData ConvertOBJ(const std::string& path, const MeshConvertOptions& options = MeshConvertOptions());
+}
@@ -1,10 +1,23 @@
 #pragma once
 
-#include <map>
+#include <array>
+#include <assert.h>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
 
 #include <lol/util/NonCopyable.hpp>
 #include <lol/util/Exceptions.hpp>
+#include <lol/util/ObjectPool.hpp>
+#include <lol/util/JobSystem.hpp>
 
 namespace lol
 {
@@ -21,6 +34,13 @@ namespace lol
 	 * not break and still work. But realistically this shouldn't happen in the first place.
 	 * As a consequence, even if no objects are using an object stored in here it will continue to
 	 * exist.
+	 *
+	 * The manager is safe to use from multiple threads. Objects are spread over several shards that
+	 * are locked independently, so e.g. loader threads can create objects while the render thread
+	 * looks up others.
+	 *
+	 * For lookups on hot paths, objects can instead be put into a per-type ObjectPool (see GetPool())
+	 * and be referred to via Handles, which resolve in O(1) without touching any reference counts.
 	 */
 	class ObjectManager : public NonCopyable
 	{
@@ -29,7 +49,14 @@ namespace lol
 		 * @brief Construct a new ObjectManager
 		 * 
 		 */
-		ObjectManager() {}
+		ObjectManager();
+
+		/**
+		 * @brief Waits for all loads that are still running on worker threads
+		 * 
+		 * Loads whose GPU objects haven't been created yet are abandoned.
+		 */
+		~ObjectManager();
 
 		/**
 		 * @brief Tell the ObjectManager to create a new object of type T
@@ -46,12 +73,138 @@ namespace lol
 		template<typename T, typename... Args>
 		std::shared_ptr<T> Create(unsigned int id, Args&&... args)
 		{
-			std::shared_ptr<T> object = std::make_shared<T>(args...);
-			objects.insert({id, object});
+			std::shared_ptr<T> object = std::make_shared<T>(std::forward<Args>(args)...);
+
+			Shard& shard = GetShard(id);
+			std::unique_lock<std::shared_mutex> lock(shard.mutex);
+			shard.objects.insert({id, object});
 
 			return object;
 		}
 
+		/**
+		 * @brief Load an object in the background
+		 * 
+		 * `decode` is run on the default JobSystem and should do all the work that doesn't need
+		 * an OpenGL context, like reading and decoding files. Its result is then handed to
+		 * `create` on the thread that calls ProcessUploads(), which creates the actual object.
+		 * 
+		 * If the ID is already being loaded, no new load is started and the future of the
+		 * running load is returned instead, which must have been started with the same T.
+		 * If the ID already exists, a ready future is returned.
+		 * 
+		 * Don't wait on the returned future on the thread that calls ProcessUploads(), it would
+		 * never become ready.
+		 * 
+		 * @tparam T 		Type of the object to create
+		 * @param id 		ID to give this object in the manager
+		 * @param decode 	Function producing the CPU-side data of the object, e.g. an Image
+		 * @param create 	Function taking a reference to the decoded data and returning a `std::shared_ptr<T>`
+		 * @return 			A future that becomes ready once the object was created
+		 */
+		template<typename T, typename Decode, typename Create>
+		std::shared_future<std::shared_ptr<T>> LoadAsync(unsigned int id, Decode&& decode, Create&& create)
+		{
+			typedef std::decay_t<std::invoke_result_t<std::decay_t<Decode>&>> Decoded;
+
+			std::lock_guard<std::mutex> lock(loadMutex);
+
+			auto it = loads.find(id);
+			if (it != loads.end())
+			{
+				assert(it->second.type == std::type_index(typeid(T)) && "lol::ObjectManager::LoadAsync() ID is already being loaded as a different type");
+				return *std::static_pointer_cast<std::shared_future<std::shared_ptr<T>>>(it->second.future);
+			}
+
+			std::shared_ptr<std::promise<std::shared_ptr<T>>> promise = std::make_shared<std::promise<std::shared_ptr<T>>>();
+			std::shared_future<std::shared_ptr<T>> future = promise->get_future().share();
+
+			std::shared_ptr<T> existing = TryGet<T>(id);
+			if (existing != nullptr)
+			{
+				promise->set_value(existing);
+				return future;
+			}
+
+			loads.insert({ id, Load{ std::type_index(typeid(T)), std::make_shared<std::shared_future<std::shared_ptr<T>>>(future) } });
+
+			JobSystem::Default().Run(decodeJobs,
+				[this, id, promise, decode = std::forward<Decode>(decode), create = std::forward<Create>(create)]() mutable
+				{
+					std::shared_ptr<Decoded> decoded;
+					try
+					{
+						decoded = std::make_shared<Decoded>(decode());
+					}
+					catch (...)
+					{
+						FinishLoad(id);
+						promise->set_exception(std::current_exception());
+						return;
+					}
+
+					QueueUpload([this, id, promise, decoded, create]() mutable
+					{
+						try
+						{
+							std::shared_ptr<T> object = create(*decoded);
+							{
+								Shard& shard = GetShard(id);
+								std::unique_lock<std::shared_mutex> lock(shard.mutex);
+								shard.objects.insert({ id, object });
+							}
+
+							FinishLoad(id);
+							promise->set_value(object);
+						}
+						catch (...)
+						{
+							FinishLoad(id);
+							promise->set_exception(std::current_exception());
+						}
+					});
+				}
+			);
+
+			return future;
+		}
+
+		/**
+		 * @brief Load an object in the background
+		 * 
+		 * The object is created by passing the result of `decode` to T's constructor,
+		 * e.g. `LoadAsync<Texture2D>(id, [path]() { return Image(path); })`
+		 * 
+		 * @tparam T 		Type of the object to create
+		 * @param id 		ID to give this object in the manager
+		 * @param decode 	Function producing the argument to T's constructor
+		 * @return 			A future that becomes ready once the object was created
+		 */
+		template<typename T, typename Decode>
+		std::shared_future<std::shared_ptr<T>> LoadAsync(unsigned int id, Decode&& decode)
+		{
+			return LoadAsync<T>(id, std::forward<Decode>(decode), [](auto& decoded) { return std::make_shared<T>(decoded); });
+		}
+
+		/**
+		 * @brief Create the objects of finished background loads
+		 * 
+		 * Must be called regularly (e.g. once per frame) from the thread owning the OpenGL context.
+		 * Creation stops once the time budget is used up, the remaining objects are created on the
+		 * next call. At least one object is created per call.
+		 * 
+		 * @param budget 	How much time may be spent creating objects
+		 * @return 			Number of objects created
+		 */
+		size_t ProcessUploads(std::chrono::microseconds budget = std::chrono::microseconds(2000));
+
+		/**
+		 * @brief Get the number of loads that haven't finished yet
+		 * 
+		 * @return Number of running loads
+		 */
+		size_t GetPendingLoadCount();
+
 		/**
 		 * @brief Remove object from manager
 		 * 
@@ -85,6 +238,48 @@ namespace lol
 			return std::static_pointer_cast<T>(object);
 		}
 
+		/**
+		 * @brief Retrieve a generic object from the manager without throwing
+		 * 
+		 * @param id ID of the object to retrieve
+		 * @return A void* to the object, or `nullptr` if it doesn't exist
+		 */
+		std::shared_ptr<void> TryGet(unsigned int id);
+
+		/**
+		 * @brief Retrieve an object of a specific type from the manager without throwing
+		 * 
+		 * @tparam T 	Type of the object
+		 * @param id 	ID of the object
+		 * @return 		A pointer to the object, or `nullptr` if it doesn't exist
+		 */
+		template<typename T>
+		std::shared_ptr<T> TryGet(unsigned int id)
+		{
+			return std::static_pointer_cast<T>(TryGet(id));
+		}
+
+		/**
+		 * @brief Get the ObjectPool storing objects of type T
+		 * 
+		 * The pool is created on first use and lives as long as the manager. The returned
+		 * reference stays valid, so it can be stored to skip this lookup.
+		 * 
+		 * @tparam T 	Type of the objects
+		 * @return 		The pool for type T
+		 */
+		template<typename T>
+		ObjectPool<T>& GetPool()
+		{
+			std::lock_guard<std::mutex> lock(poolMutex);
+
+			std::shared_ptr<void>& pool = pools[std::type_index(typeid(T))];
+			if (pool == nullptr)
+				pool = std::make_shared<ObjectPool<T>>();
+
+			return *std::static_pointer_cast<ObjectPool<T>>(pool);
+		}
+
 		/**
 		 * @brief Removes any objects that aren't in use by anyone anymore
 		 * 
@@ -104,7 +299,59 @@ namespace lol
 		void Clear();
 
 	private:
-		std::map<unsigned int, std::shared_ptr<void>> objects;
+		/**
+		 * @brief Queue work that has to run on the thread calling ProcessUploads()
+		 */
+		void QueueUpload(std::function<void()>&& upload);
+
+		/**
+		 * @brief Mark the load of an ID as done, so it can be loaded again
+		 */
+		void FinishLoad(unsigned int id);
+
+	private:
+		/**
+		 * @brief An independently locked part of the ID to object mapping
+		 */
+		struct Shard
+		{
+			std::shared_mutex mutex;
+			std::unordered_map<unsigned int, std::shared_ptr<void>> objects;
+		};
+
+		/**
+		 * @brief A running load, and the type it was started with
+		 */
+		struct Load
+		{
+			std::type_index type;
+			std::shared_ptr<void> future;	///< A `std::shared_future<std::shared_ptr<T>>`
+		};
+
+		/**
+		 * @brief Get the shard responsible for an ID
+		 */
+		inline Shard& GetShard(unsigned int id)
+		{
+			// Fibonacci hashing, so that consecutive IDs end up in different shards
+			return shards[(uint32_t)(id * 2654435769u) >> (32 - ShardBits)];
+		}
+
+	private:
+		static constexpr unsigned int ShardBits = 4;
+
+		std::array<Shard, 1 << ShardBits> shards;
+
+		std::mutex poolMutex;
+		std::unordered_map<std::type_index, std::shared_ptr<void>> pools;
+
+		std::mutex loadMutex;
+		std::unordered_map<unsigned int, Load> loads;	///< Every running load
+
+		std::mutex uploadMutex;
+		std::deque<std::function<void()>> uploads;
+
+		JobGroup decodeJobs;	///< Running decodes, ~ObjectManager() waits for them before any member is destroyed
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,277 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+#include <lol/util/NonCopyable.hpp>
+
+namespace lol
+{
+	/**
+	 * @brief A typed reference to an object inside an ObjectPool
+	 *
+	 * A Handle consists of the index of a slot in the pool and the generation of that slot.
+	 * Every time an object is removed from a slot the slot's generation is increased, so old
+	 * Handles to that slot stop resolving instead of pointing to whatever object lives there now.
+	 *
+	 * A default constructed Handle never resolves to anything.
+	 *
+	 * @tparam T Type of the object
+	 */
+	template<typename T>
+	struct Handle
+	{
+		uint32_t index = 0;			///< Index of the slot in the pool
+		uint32_t generation = 0;	///< Generation of the slot when the Handle was created
+
+		inline bool operator==(const Handle& other) const { return index == other.index && generation == other.generation; }
+		inline bool operator!=(const Handle& other) const { return !(*this == other); }
+
+		/**
+		 * @brief Whether the Handle was ever assigned to an object
+		 *
+		 * This doesn't say anything about whether the object still exists, use ObjectPool::IsValid() for that.
+		 */
+		inline explicit operator bool() const { return generation != 0; }
+	};
+
+	/**
+	 * @brief Stores objects of a single type and hands out generational Handles to them
+	 *
+	 * Shared pointers to the objects are kept in a dense array, and Handles are resolved
+	 * through a slot table in O(1) without touching any reference counts. Removing an object
+	 * moves the last pointer into its place, so the array never has holes. The objects
+	 * themselves are allocated separately, which is what lets Lock() keep an object alive
+	 * after it was removed, so iterating over them isn't any more cache friendly than
+	 * iterating over a vector of shared pointers.
+	 *
+	 * The pool can be used from multiple threads at once. Lookups only take a shared lock,
+	 * so they can happen in parallel. Note that the raw pointer returned by Resolve() is not
+	 * protected against another thread destroying the object, use Lock() in that case.
+	 *
+	 * @tparam T Type of the objects
+	 */
+	template<typename T>
+	class ObjectPool : public NonCopyable
+	{
+	public:
+		/**
+		 * @brief Construct a new, empty ObjectPool
+		 */
+		ObjectPool() {}
+
+		/**
+		 * @brief Construct a new object inside the pool
+		 *
+		 * @tparam Args
+		 * @param args 	Arguments to pass to T's constructor
+		 * @return 		A Handle to the new object
+		 */
+		template<typename... Args>
+		Handle<T> Create(Args&&... args)
+		{
+			return Insert(std::make_shared<T>(std::forward<Args>(args)...));
+		}
+
+		/**
+		 * @brief Put an existing object into the pool
+		 *
+		 * @param object 	The object to store
+		 * @return 			A Handle to the object
+		 */
+		Handle<T> Insert(std::shared_ptr<T> object)
+		{
+			std::unique_lock<std::shared_mutex> lock(mutex);
+
+			uint32_t index;
+			if (freeSlots.empty())
+			{
+				index = (uint32_t)slots.size();
+				slots.push_back(Slot{ 0, 1 });
+			}
+			else
+			{
+				index = freeSlots.back();
+				freeSlots.pop_back();
+			}
+
+			slots[index].dense = (uint32_t)objects.size();
+			objects.push_back(std::move(object));
+			owners.push_back(index);
+
+			return Handle<T>{ index, slots[index].generation };
+		}
+
+		/**
+		 * @brief Get the object a Handle refers to
+		 *
+		 * @param handle 	Handle of the object
+		 * @return 			A pointer to the object, or `nullptr` if it doesn't exist anymore
+		 */
+		T* Resolve(Handle<T> handle) const
+		{
+			std::shared_lock<std::shared_mutex> lock(mutex);
+
+			const Slot* slot = Find(handle);
+			return (slot != nullptr) ? objects[slot->dense].get() : nullptr;
+		}
+
+		/**
+		 * @brief Get shared ownership of the object a Handle refers to
+		 *
+		 * Unlike Resolve() the object is guaranteed to stay alive for as long as
+		 * the returned pointer exists, even if it is removed from the pool.
+		 *
+		 * @param handle 	Handle of the object
+		 * @return 			A shared pointer to the object, or `nullptr` if it doesn't exist anymore
+		 */
+		std::shared_ptr<T> Lock(Handle<T> handle) const
+		{
+			std::shared_lock<std::shared_mutex> lock(mutex);
+
+			const Slot* slot = Find(handle);
+			return (slot != nullptr) ? objects[slot->dense] : nullptr;
+		}
+
+		/**
+		 * @brief Check whether a Handle still refers to an object
+		 *
+		 * @param handle 	The Handle to check
+		 * @return 			`true` if the object exists
+		 */
+		bool IsValid(Handle<T> handle) const
+		{
+			std::shared_lock<std::shared_mutex> lock(mutex);
+			return Find(handle) != nullptr;
+		}
+
+		/**
+		 * @brief Remove an object from the pool
+		 *
+		 * All Handles to the object become invalid. The object itself is destroyed
+		 * once nobody holds a shared pointer from Lock() anymore.
+		 *
+		 * @param handle 	Handle of the object
+		 * @return 			`false` if the Handle was already invalid
+		 */
+		bool Destroy(Handle<T> handle)
+		{
+			std::shared_ptr<T> removed;
+			{
+				std::unique_lock<std::shared_mutex> lock(mutex);
+
+				Slot* slot = const_cast<Slot*>(Find(handle));
+				if (slot == nullptr)
+					return false;
+
+				// Move the last object into the gap
+				uint32_t dense = slot->dense;
+				removed = std::move(objects[dense]);
+				objects[dense] = std::move(objects.back());
+				owners[dense] = owners.back();
+				slots[owners[dense]].dense = dense;
+
+				objects.pop_back();
+				owners.pop_back();
+
+				slot->generation++;
+				if (slot->generation == 0)	// Generation 0 is reserved for invalid handles
+					slot->generation = 1;
+
+				freeSlots.push_back(handle.index);
+			}
+
+			// Destroy the object outside of the lock, its destructor might take a while
+			return true;
+		}
+
+		/**
+		 * @brief Remove all objects from the pool
+		 */
+		void Clear()
+		{
+			std::vector<std::shared_ptr<T>> removed;
+			{
+				std::unique_lock<std::shared_mutex> lock(mutex);
+
+				for (uint32_t index : owners)
+				{
+					slots[index].generation++;
+					if (slots[index].generation == 0)
+						slots[index].generation = 1;
+
+					freeSlots.push_back(index);
+				}
+
+				removed.swap(objects);
+				owners.clear();
+			}
+
+			// Destroy the objects outside of the lock, like Destroy() does
+		}
+
+		/**
+		 * @brief Get the number of objects in the pool
+		 *
+		 * @return Number of objects
+		 */
+		size_t Size() const
+		{
+			std::shared_lock<std::shared_mutex> lock(mutex);
+			return objects.size();
+		}
+
+		/**
+		 * @brief Call a function for every object in the pool
+		 *
+		 * The objects are visited in storage order. The pool must not be
+		 * modified from inside the function.
+		 *
+		 * @param function Function taking a `T&`
+		 */
+		template<typename Function>
+		void ForEach(Function&& function) const
+		{
+			std::shared_lock<std::shared_mutex> lock(mutex);
+
+			for (const std::shared_ptr<T>& object : objects)
+				function(*object);
+		}
+
+	private:
+		/**
+		 * @brief Entry of the slot table
+		 */
+		struct Slot
+		{
+			uint32_t dense;			///< Index of the object in the dense array
+			uint32_t generation;	///< Current generation of the slot
+		};
+
+		/**
+		 * @brief Look up the slot of a Handle
+		 *
+		 * @return The slot, or `nullptr` if the Handle is invalid
+		 */
+		const Slot* Find(Handle<T> handle) const
+		{
+			if (handle.index >= slots.size())
+				return nullptr;
+
+			const Slot& slot = slots[handle.index];
+			return (slot.generation == handle.generation) ? &slot : nullptr;
+		}
+
+	private:
+		mutable std::shared_mutex mutex;
+
+		std::vector<Slot> slots;
+		std::vector<uint32_t> freeSlots;
+
+		std::vector<std::shared_ptr<T>> objects;
+		std::vector<uint32_t> owners;		///< Slot index of each object in the dense array
+	};
+}
@@ -0,0 +1,225 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <lol/util/NonCopyable.hpp>
+
+#define LOL_PROFILER_CONCAT_IMPL(a, b) a##b
+#define LOL_PROFILER_CONCAT(a, b) LOL_PROFILER_CONCAT_IMPL(a, b)
+
+#ifdef LOL_ENABLE_PROFILER
+	/// Time the enclosing scope on the CPU, `name` must be a string literal
+	#define LOL_PROFILE_SCOPE(name) ::lol::ProfileScope LOL_PROFILER_CONCAT(lolProfileScope, __LINE__)(name)
+	/// Time the enclosing function on the CPU
+	#define LOL_PROFILE_FUNCTION() LOL_PROFILE_SCOPE(__func__)
+	/// Time the GPU work submitted in the enclosing scope, `name` must be a string literal
+	#define LOL_PROFILE_GPU_SCOPE(name) ::lol::GpuProfileScope LOL_PROFILER_CONCAT(lolGpuProfileScope, __LINE__)(name)
+	/// Mark the end of a frame, must be called on the thread owning the OpenGL context
+	#define LOL_PROFILE_FRAME() ::lol::Profiler::Get().NewFrame()
+#else
+	#define LOL_PROFILE_SCOPE(name) ((void)0)
+	#define LOL_PROFILE_FUNCTION() ((void)0)
+	#define LOL_PROFILE_GPU_SCOPE(name) ((void)0)
+	#define LOL_PROFILE_FRAME() ((void)0)
+#endif
+
+namespace lol
+{
+	/**
+	 * @brief Collects CPU and GPU timings and exports them as a Chrome trace
+	 *
+	 * The library is instrumented with the `LOL_PROFILE_*` macros, which only do something
+	 * if `LOL_ENABLE_PROFILER` is defined (see the CMake option of the same name). Otherwise
+	 * they compile to nothing.
+	 *
+	 * CPU scopes are written into a ring buffer owned by the recording thread, so recording
+	 * never takes a lock. Only the most recent events of each thread are kept.
+	 *
+	 * GPU scopes are timed with `GL_TIMESTAMP` queries. Their results are read two frames
+	 * later, and only if they are already available, so measuring never stalls the pipeline.
+	 *
+	 * Nothing is recorded unless a capture is running. Open the exported file in
+	 * `chrome://tracing` or Perfetto.
+	 */
+	class Profiler : public NonCopyable
+	{
+	public:
+		/**
+		 * @brief Get the profiler shared by all threads
+		 */
+		static Profiler& Get();
+
+		/**
+		 * @brief Start recording events
+		 */
+		void BeginCapture();
+
+		/**
+		 * @brief Stop recording events
+		 */
+		void EndCapture();
+
+		inline bool IsCapturing() const { return capturing.load(std::memory_order_relaxed); }
+
+		/**
+		 * @brief Mark the end of a frame and collect finished GPU timings
+		 *
+		 * Must be called once per frame on the thread owning the OpenGL context.
+		 */
+		void NewFrame();
+
+		/**
+		 * @brief Give the calling thread a name in the trace
+		 *
+		 * @param name Name of the thread
+		 */
+		void SetThreadName(const std::string& name);
+
+		/**
+		 * @brief Write all recorded events in the Chrome trace event format
+		 *
+		 * Should be called after EndCapture(), once the recording threads left their scopes.
+		 *
+		 * @param stream The stream to write the JSON to
+		 */
+		void ExportChromeTrace(std::ostream& stream);
+
+		/**
+		 * @brief Write all recorded events in the Chrome trace event format to a file
+		 *
+		 * @param path 	Path of the file
+		 * @return 		`false` if the file couldn't be written
+		 */
+		bool ExportChromeTrace(const std::string& path);
+
+		/**
+		 * @brief Delete the GPU queries
+		 *
+		 * Call this before destroying the OpenGL context, if GPU scopes were used.
+		 */
+		void ReleaseGpuResources();
+
+		/**
+		 * @brief Get the current time of the profiler's clock
+		 *
+		 * @return Time in nanoseconds
+		 */
+		static uint64_t Now();
+
+		/**
+		 * @brief Record a finished CPU scope
+		 */
+		void RecordCpu(const char* name, uint64_t start, uint64_t end);
+
+		/**
+		 * @brief Start timing a GPU scope
+		 *
+		 * @return Handle to pass to EndGpu(), or -1 if nothing is recorded
+		 */
+		int BeginGpu(const char* name);
+
+		/**
+		 * @brief Stop timing a GPU scope
+		 */
+		void EndGpu(int handle);
+
+	private:
+		Profiler();
+
+		struct Event
+		{
+			const char* name;
+			uint64_t start;
+			uint64_t end;
+		};
+
+		/**
+		 * @brief Events recorded by a single thread
+		 */
+		struct ThreadEvents
+		{
+			std::string name;
+			uint32_t id;
+
+			std::vector<Event> events;
+			std::atomic<uint64_t> written;	///< Total number of events ever written, the ring index is this modulo the capacity
+		};
+
+		/**
+		 * @brief GPU queries issued during one frame
+		 */
+		struct GpuFrame
+		{
+			std::vector<unsigned int> queries;	///< Two per scope, start and end
+			std::vector<const char*> names;
+			size_t used = 0;
+			int64_t clockOffset = 0;			///< Add to GPU timestamps to get profiler time
+		};
+
+		ThreadEvents& GetThreadEvents();
+		void RecordGpu(const char* name, uint64_t start, uint64_t end);
+
+	private:
+		static constexpr size_t EventsPerThread = 1 << 16;
+		static constexpr size_t GpuScopesPerFrame = 1024;
+
+		std::atomic<bool> capturing;
+
+		std::mutex threadsMutex;
+		std::vector<std::unique_ptr<ThreadEvents>> threads;	///< Never shrinks, so threads can exit at any time
+
+		GpuFrame gpuFrames[2];
+		size_t gpuFrame;
+		std::vector<Event> gpuEvents;
+		uint64_t gpuEventsWritten;
+
+		uint64_t frameStart;
+	};
+
+	/**
+	 * @brief Records the time between its construction and destruction, see LOL_PROFILE_SCOPE
+	 */
+	class ProfileScope : public NonCopyable
+	{
+	public:
+		inline ProfileScope(const char* name) :
+			name(name), start(Profiler::Get().IsCapturing() ? Profiler::Now() : 0)
+		{ }
+
+		inline ~ProfileScope()
+		{
+			if (start != 0)
+				Profiler::Get().RecordCpu(name, start, Profiler::Now());
+		}
+
+	private:
+		const char* name;
+		uint64_t start;
+	};
+
+	/**
+	 * @brief Times the GPU work submitted during its lifetime, see LOL_PROFILE_GPU_SCOPE
+	 */
+	class GpuProfileScope : public NonCopyable
+	{
+	public:
+		inline GpuProfileScope(const char* name) :
+			handle(Profiler::Get().BeginGpu(name))
+		{ }
+
+		inline ~GpuProfileScope()
+		{
+			if (handle >= 0)
+				Profiler::Get().EndGpu(handle);
+		}
+
+	private:
+		int handle;
+	};
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace lol
+{
+	class VertexArray;
+
+	/**
+	 * @brief The index buffer shared by the quad batchers, SpriteBatch and TextRenderer
+	 *
+	 * Every quad is four vertices in the order lower left, lower right, upper right, upper
+	 * left, drawn as the triangles (0 1 2) and (0 2 3). The indices only depend on the number
+	 * of quads, so a single buffer serves every run of a batch, each draw offsets it with the
+	 * base vertex of its first quad.
+	 */
+	class QuadIndices
+	{
+	public:
+		QuadIndices();
+
+		/**
+		 * @brief Make sure the element buffer of a VAO covers a run of quads
+		 *
+		 * The buffer grows in powers of two so it is only recreated a few times. The VAO is
+		 * left bound.
+		 *
+		 * @param vao 			The VAO to set the element buffer on, always the same one
+		 * @param quadCount 	Number of quads the longest draw needs
+		 */
+		void Reserve(VertexArray& vao, size_t quadCount);
+
+		/**
+		 * @brief Get the number of quads the element buffer covers
+		 */
+		inline size_t GetCapacity() const { return capacity; }
+
+	private:
+		size_t capacity;
+	};
+
+	/**
+	 * @brief Store a color channel in [0, 1] as an unsigned normalized byte, rounding to nearest
+	 */
+	inline uint8_t ToUNorm8(float value)
+	{
+		return (uint8_t)(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+	}
+}
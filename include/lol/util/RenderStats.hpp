@@ -0,0 +1,175 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+#include <lol/util/NonCopyable.hpp>
+#include <lol/util/Enums.hpp>
+
+namespace lol
+{
+	/**
+	 * @brief Things counted during a frame
+	 */
+	enum class RenderCounter
+	{
+		DrawCalls,				///< Number of draw calls issued
+		Primitives,				///< Number of points, lines or triangles drawn
+		ShaderBinds,			///< Number of times a Shader was bound
+		VertexArrayBinds,		///< Number of times a VertexArray was bound
+		BufferBinds,			///< Number of times a Buffer was bound
+		TextureBinds,			///< Number of times a Texture was bound
+		UniformUpdates,			///< Number of uniforms set
+		BufferUploadBytes,		///< Bytes uploaded into Buffers
+		TextureUploadBytes,		///< Bytes uploaded into Textures
+
+		Count
+	};
+
+	/**
+	 * @brief Types of objects whose video memory is tracked
+	 */
+	enum class RenderMemory
+	{
+		Texture,
+		Buffer,
+
+		Count
+	};
+
+	/**
+	 * @brief The counters of a single finished frame
+	 */
+	struct FrameStats
+	{
+		uint64_t frame = 0;																///< Index of the frame, counting from 0
+		std::array<uint64_t, (size_t)RenderCounter::Count> counters{};					///< Indexed by RenderCounter
+		std::array<int64_t, (size_t)RenderMemory::Count> liveMemory{};					///< Bytes of video memory in use at the end of the frame, indexed by RenderMemory
+
+		inline uint64_t operator[](RenderCounter counter) const { return counters[(size_t)counter]; }
+		inline int64_t operator[](RenderMemory type) const { return liveMemory[(size_t)type]; }
+	};
+
+	/**
+	 * @brief Counts draw calls, binds and uploads per frame
+	 *
+	 * The library reports into the counters as it issues OpenGL calls. At the end of every
+	 * frame NewFrame() moves the current counters into a history of the most recent frames
+	 * and resets them, so frame-over-frame changes can be checked, e.g. a draw call count
+	 * that suddenly doubles.
+	 *
+	 * Live memory isn't reset, it's the estimated video memory used by all existing
+	 * Textures and Buffers.
+	 *
+	 * Counting is a relaxed atomic add, so it can be done from any thread.
+	 */
+	class RenderStats : public NonCopyable
+	{
+	public:
+		/**
+		 * @brief Get the statistics shared by all threads
+		 */
+		static RenderStats& Get();
+
+		/**
+		 * @brief Increase a counter of the current frame
+		 *
+		 * @param counter	The counter to increase
+		 * @param amount	The amount to add
+		 */
+		inline void Add(RenderCounter counter, uint64_t amount = 1)
+		{
+			counters[(size_t)counter].fetch_add(amount, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Count a draw call and the primitives it draws
+		 *
+		 * @param mode		How the vertices are assembled
+		 * @param vertices	Number of vertices (or indices) drawn
+		 */
+		void AddDraw(DrawMode mode, size_t vertices);
+
+		/**
+		 * @brief Change the live memory of a type of object
+		 *
+		 * @param type	The type of object
+		 * @param bytes	Number of bytes allocated, or negative if memory was freed
+		 */
+		inline void AddMemory(RenderMemory type, int64_t bytes)
+		{
+			liveMemory[(size_t)type].fetch_add(bytes, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Finish the current frame
+		 *
+		 * Moves the counters into the history and resets them. Application calls this after
+		 * EndFrame(), applications with their own loop have to call it once per frame.
+		 */
+		void NewFrame();
+
+		/**
+		 * @brief Set how many frames the history keeps
+		 *
+		 * @param frames Number of frames, older ones are dropped
+		 */
+		void SetHistorySize(size_t frames);
+
+		/**
+		 * @brief Get the counters of the most recently finished frame
+		 *
+		 * @return The counters, or all zeros if no frame finished yet
+		 */
+		FrameStats GetLastFrame() const;
+
+		/**
+		 * @brief Get the counters of the most recent frames
+		 *
+		 * @return The frames, oldest first
+		 */
+		std::deque<FrameStats> GetHistory() const;
+
+		/**
+		 * @brief Get the average of a counter over the most recent frames
+		 *
+		 * @param counter	The counter to average
+		 * @param frames	Number of frames to average over, limited by the history size
+		 * @return			The average, or 0 if there is no history yet
+		 */
+		double GetAverage(RenderCounter counter, size_t frames) const;
+
+		/**
+		 * @brief Get the video memory currently used by a type of object
+		 *
+		 * @param type	The type of object
+		 * @return		Number of bytes
+		 */
+		inline int64_t GetLiveMemory(RenderMemory type) const { return liveMemory[(size_t)type].load(std::memory_order_relaxed); }
+
+		/**
+		 * @brief Get the number of primitives drawn from a number of vertices
+		 *
+		 * @param mode		How the vertices are assembled
+		 * @param vertices	Number of vertices
+		 * @return			Number of points, lines, triangles or patches
+		 */
+		static size_t CountPrimitives(DrawMode mode, size_t vertices);
+
+	private:
+		RenderStats();
+
+	private:
+		std::array<std::atomic<uint64_t>, (size_t)RenderCounter::Count> counters;
+		std::array<std::atomic<int64_t>, (size_t)RenderMemory::Count> liveMemory;
+
+		mutable std::mutex historyMutex;
+		std::deque<FrameStats> history;
+		size_t historySize;
+		uint64_t frame;
+	};
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+#include <lol/util/NonCopyable.hpp>
+
+namespace lol
+{
+	class Texture;
+	class Buffer;
+
+	/**
+	 * @brief Keeps the video memory used by Textures below a budget
+	 *
+	 * Every tracked Texture counts towards the budget with the amount of memory it uses.
+	 * At the start of each frame, if the budget is exceeded, the least recently bound
+	 * Textures are evicted: their base level is copied into system memory and the GPU
+	 * object is deleted. The next time an evicted Texture is bound it is transparently
+	 * uploaded again (and its mipmaps regenerated).
+	 *
+	 * Buffers are never evicted, since VertexArrays keep referencing them. Tracking them
+	 * only reports their memory in GetResidentBytes() and GetBufferBytes(), they don't
+	 * count towards the budget. Otherwise a few large Buffers would make the manager
+	 * evict every Texture without ever meeting the budget.
+	 *
+	 * Textures that were bound during the previous frame are never evicted, as they would
+	 * likely have to be restored right away. So the budget can be exceeded if a single
+	 * frame needs more memory than it allows.
+	 *
+	 * The bookkeeping is guarded by a mutex, so tracked objects may be destroyed on any
+	 * thread, e.g. when the DeletionQueue lets worker threads drop them. Track(), Touch()
+	 * and NewFrame() evict and restore Textures, so they must be called on the thread
+	 * owning the OpenGL context.
+	 */
+	class ResidencyManager : public NonCopyable
+	{
+	public:
+		/**
+		 * @brief Construct a new ResidencyManager
+		 *
+		 * @param budget Number of bytes the tracked Textures may use
+		 */
+		ResidencyManager(size_t budget);
+
+		/**
+		 * @brief Stops tracking all objects
+		 *
+		 * Evicted Textures are restored the next time they are bound.
+		 */
+		~ResidencyManager();
+
+		/**
+		 * @brief Start tracking a Texture
+		 *
+		 * A Texture can only be tracked by one manager at a time. It is untracked
+		 * automatically when it is destroyed.
+		 *
+		 * @param texture The Texture to track
+		 */
+		void Track(Texture& texture);
+
+		/**
+		 * @brief Start tracking a Buffer
+		 *
+		 * A Buffer can only be tracked by one manager at a time. It is untracked
+		 * automatically when it is destroyed.
+		 *
+		 * @param buffer The Buffer to track
+		 */
+		void Track(Buffer& buffer);
+
+		/**
+		 * @brief Stop tracking a Texture
+		 *
+		 * If the Texture is currently evicted it is restored the next time it is bound.
+		 *
+		 * @param texture The Texture to untrack
+		 */
+		void Untrack(Texture& texture);
+
+		/**
+		 * @brief Stop tracking a Buffer
+		 *
+		 * @param buffer The Buffer to untrack
+		 */
+		void Untrack(Buffer& buffer);
+
+		/**
+		 * @brief Mark a Texture as used in the current frame and restore it if necessary
+		 *
+		 * Called by Texture::Bind(), there should be no need to call this manually. Textures
+		 * that aren't tracked by this manager are ignored.
+		 *
+		 * @param texture The Texture that is being used
+		 */
+		void Touch(Texture& texture);
+
+		/**
+		 * @brief Advance to the next frame and evict Textures until the budget is met
+		 *
+		 * Should be called once at the beginning of every frame
+		 */
+		void NewFrame();
+
+		/**
+		 * @brief Change the budget
+		 *
+		 * Takes effect on the next call to NewFrame()
+		 *
+		 * @param budget Number of bytes the tracked Textures may use
+		 */
+		void SetBudget(size_t budget);
+
+		/**
+		 * @brief Get the budget
+		 *
+		 * @return Number of bytes the tracked Textures may use
+		 */
+		size_t GetBudget() const;
+
+		/**
+		 * @brief Get the amount of video memory currently used by tracked objects
+		 *
+		 * @return Number of bytes, including those of Buffers
+		 */
+		size_t GetResidentBytes() const;
+
+		/**
+		 * @brief Get the amount of video memory used by tracked Buffers
+		 *
+		 * @return Number of bytes that can't be evicted
+		 */
+		size_t GetBufferBytes() const;
+
+		/**
+		 * @brief Get the amount of memory currently evicted to system memory
+		 *
+		 * @return Number of bytes
+		 */
+		size_t GetEvictedBytes() const;
+
+		/**
+		 * @brief Get the number of the current frame
+		 *
+		 * @return Number of calls to NewFrame() so far
+		 */
+		uint64_t GetFrame() const;
+
+	private:
+		/**
+		 * @brief Bookkeeping data of a tracked Texture
+		 */
+		struct Entry
+		{
+			size_t bytes;
+			uint64_t lastUsed;
+		};
+
+	private:
+		mutable std::mutex mutex;		///< Guards everything below, objects may be untracked on any thread
+		size_t budget;
+		size_t residentBytes;
+		size_t bufferBytes;		///< Part of `residentBytes` that can't be evicted
+		size_t evictedBytes;
+		uint64_t frame;
+
+		std::unordered_map<Texture*, Entry> textures;
+		std::unordered_map<Buffer*, size_t> buffers;
+	};
+}
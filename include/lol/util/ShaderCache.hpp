@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <lol/util/Hash.hpp>
+#include <lol/util/NonCopyable.hpp>
+
+namespace lol
+{
+	class Shader;
+
+	/**
+	 * @brief Stores linked shader programs on disk to skip compilation on later runs
+	 *
+	 * Programs are identified by a hash of their sources, their defines and the vendor,
+	 * renderer and version strings of the driver. The first time a program is requested
+	 * it is compiled from source and its binary is written to the cache directory. After
+	 * that the binary is loaded directly, unless the driver rejects it (e.g. after a driver
+	 * update), in which case the program is compiled again and the cache entry replaced.
+	 *
+	 * If the driver doesn't support any program binary formats every request is a miss.
+	 * The cache must be created and used on the thread owning the OpenGL context.
+	 */
+	class ShaderCache : public NonCopyable
+	{
+	public:
+		/**
+		 * @brief Construct a new ShaderCache
+		 *
+		 * @param directory Directory to store the program binaries in, it is created if it doesn't exist
+		 */
+		ShaderCache(const std::string& directory);
+
+		/**
+		 * @brief Get a shader program from the cache, or compile it
+		 *
+		 * @param vertexShader   Source code of the vertex shader
+		 * @param fragmentShader Source code of the fragment shader
+		 * @param defines        Preprocessor definitions (e.g. `"USE_FOG"` or `"LIGHTS 4"`) inserted after the `#version` line of both stages
+		 * @return               The shader, check Shader::Good() to see whether compilation succeeded
+		 */
+		std::shared_ptr<Shader> Load(const std::string& vertexShader, const std::string& fragmentShader, const std::vector<std::string>& defines = {});
+
+		/**
+		 * @brief Delete all program binaries from the cache directory
+		 */
+		void Clear();
+
+		/**
+		 * @brief Get how often a program was loaded from its binary
+		 *
+		 * @return Number of cache hits
+		 */
+		inline size_t GetHits() const { return hits; }
+
+		/**
+		 * @brief Get how often a program had to be compiled
+		 *
+		 * @return Number of cache misses, including rejected binaries
+		 */
+		inline size_t GetMisses() const { return misses; }
+
+		/**
+		 * @brief Get how often a cached binary was rejected by the driver
+		 *
+		 * Corrupted cache files are not counted here, they are simply treated as misses.
+		 *
+		 * @return Number of rejected binaries
+		 */
+		inline size_t GetRejected() const { return rejected; }
+
+		/**
+		 * @brief Whether the driver supports program binaries at all
+		 *
+		 * @return `false` if programs are never cached
+		 */
+		inline bool IsSupported() const { return supported; }
+
+	private:
+		std::string PathOf(const Hash128& key) const;
+
+		bool ReadBinary(const Hash128& key, unsigned int& binaryFormat, std::vector<uint8_t>& binary) const;
+		void WriteBinary(const Hash128& key, unsigned int binaryFormat, const std::vector<uint8_t>& binary) const;
+
+	private:
+		std::string directory;
+		Hash128 driverHash;
+		bool supported;
+
+		size_t hits;
+		size_t misses;
+		size_t rejected;
+	};
+}
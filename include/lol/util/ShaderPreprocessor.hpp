@@ -0,0 +1,73 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <lol/util/NonCopyable.hpp>
+
+namespace lol
+{
+	/**
+	 * @brief Resolves #include directives and injects #defines into GLSL sources
+	 *
+	 * Included files are looked up among the registered sources first and then in the
+	 * include paths, in the order they were added. Every file is only included once per
+	 * Process() call (like `#pragma once`), which also breaks include cycles.
+	 *
+	 * `#line` directives are emitted around included code so compiler errors point at the
+	 * right line. The source string number in those errors is 0 for the main source and
+	 * N for the N-th distinct file that was included.
+	 */
+	class ShaderPreprocessor : public NonCopyable
+	{
+	public:
+		/**
+		 * @brief Construct a new ShaderPreprocessor without any sources or include paths
+		 */
+		ShaderPreprocessor();
+
+		/**
+		 * @brief Add a directory to search for included files
+		 *
+		 * @param directory Path of the directory
+		 */
+		void AddIncludePath(const std::string& directory);
+
+		/**
+		 * @brief Register a source that can be included by name without touching the disk
+		 *
+		 * @param name   Name used in the #include directive
+		 * @param source GLSL code of the file
+		 */
+		void AddSource(const std::string& name, const std::string& source);
+
+		/**
+		 * @brief Resolve all #includes of a shader and inject defines
+		 *
+		 * @param source  GLSL code of the shader
+		 * @param defines Preprocessor definitions (e.g. `"USE_FOG"` or `"LIGHTS 4"`)
+		 * @return        The processed source code
+		 *
+		 * @throws ShaderIncludeException if an included file can't be found
+		 */
+		std::string Process(const std::string& source, const std::vector<std::string>& defines = {}) const;
+
+		/**
+		 * @brief Insert #define lines after the #version line of a shader
+		 *
+		 * @param source  GLSL code of the shader
+		 * @param defines Preprocessor definitions (e.g. `"USE_FOG"` or `"LIGHTS 4"`)
+		 * @return        The source with the defines inserted
+		 */
+		static std::string InjectDefines(const std::string& source, const std::vector<std::string>& defines);
+
+	private:
+		void Expand(const std::string& source, size_t fileIndex, std::vector<std::string>& included, std::string& output) const;
+		std::string Load(const std::string& name) const;
+
+	private:
+		std::vector<std::string> includePaths;
+		std::unordered_map<std::string, std::string> sources;
+	};
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <lol/Shader.hpp>
+#include <lol/util/NonCopyable.hpp>
+
+namespace lol
+{
+	class ShaderPreprocessor;
+	class ShaderCache;
+
+	/**
+	 * @brief Builds permutations of a shader from a set of optional features
+	 *
+	 * Every feature is a preprocessor define that the shader sources can test with `#ifdef`.
+	 * A variant is selected with a bitmask where bit N enables the N-th feature. Variants
+	 * are only compiled the first time they are requested and then kept, so selecting an
+	 * existing variant is a single hash map lookup.
+	 *
+	 * @code
+	 * ShaderVariants variants(vertexSource, fragmentSource, { "USE_NORMAL_MAP", "USE_FOG" });
+	 * std::shared_ptr<Shader> shader = variants.Get(variants.FeatureBit("USE_FOG"));
+	 * @endcode
+	 */
+	class ShaderVariants : public NonCopyable
+	{
+	public:
+		/**
+		 * @brief Construct a new set of shader variants
+		 *
+		 * The sources are run through the preprocessor once, the features are then
+		 * injected for every variant.
+		 *
+		 * @param vertexShader   Source code of the vertex shader
+		 * @param fragmentShader Source code of the fragment shader
+		 * @param features       Names of the feature defines, at most 64
+		 * @param preprocessor   Preprocessor to resolve #includes with, or `nullptr` if the sources have none
+		 */
+		ShaderVariants(const std::string& vertexShader, const std::string& fragmentShader, const std::vector<std::string>& features, const ShaderPreprocessor* preprocessor = nullptr);
+
+		/**
+		 * @brief Get the shader with the given features enabled, compiling it if needed
+		 *
+		 * Bits that don't correspond to a feature are ignored.
+		 *
+		 * @param features Bitmask of the enabled features
+		 * @return         The shader variant, it might still be compiling (see Shader::GetStatus())
+		 */
+		std::shared_ptr<Shader> Get(uint64_t features);
+
+		/**
+		 * @brief Get the bit that enables a feature
+		 *
+		 * @param name 	Name of the feature
+		 * @return 		The bit of the feature, or 0 if there is no such feature
+		 */
+		uint64_t FeatureBit(const std::string& name) const;
+
+		/**
+		 * @brief Load variants through a ShaderCache instead of compiling them directly
+		 *
+		 * Cached variants are always compiled immediately, since the program binary
+		 * has to be retrieved right after linking.
+		 *
+		 * @param cache The cache to use, or `nullptr` to compile directly
+		 */
+		inline void SetCache(ShaderCache* cache) { this->cache = cache; }
+
+		/**
+		 * @brief Set whether new variants wait for their compilation to finish
+		 *
+		 * @param mode The compile mode, variants are deferred by default
+		 */
+		inline void SetCompileMode(CompileMode mode) { this->mode = mode; }
+
+		/**
+		 * @brief Get the number of variants that were built so far
+		 *
+		 * @return Number of variants
+		 */
+		inline size_t GetVariantCount() const { return variants.size(); }
+
+		/**
+		 * @brief Destroy all built variants
+		 */
+		void Clear();
+
+	private:
+		std::string vertexShader, fragmentShader;
+		std::vector<std::string> features;
+		uint64_t featureMask;
+
+		ShaderCache* cache;
+		CompileMode mode;
+
+		std::unordered_map<uint64_t, std::shared_ptr<Shader>> variants;
+	};
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace lol
+{
+
+	/**
+	 * @brief Packs rectangles into a fixed size area using the skyline bottom-left heuristic
+	 *
+	 * The packer only keeps track of the "skyline", the upper contour of all rectangles that
+	 * were placed so far. New rectangles are placed on top of the skyline wherever their upper
+	 * edge ends up the lowest. This wastes slightly more space than a full MaxRects packer, but
+	 * insertions are cheap enough to be done at runtime.
+	 */
+	class SkylinePacker
+	{
+	public:
+		/**
+		 * @brief Construct a new, empty SkylinePacker
+		 *
+		 * @param width 	Width of the area to pack into
+		 * @param height 	Height of the area to pack into
+		 */
+		SkylinePacker(unsigned int width, unsigned int height);
+
+		/**
+		 * @brief Find space for a rectangle and mark it as used
+		 *
+		 * @param width 	Width of the rectangle
+		 * @param height 	Height of the rectangle
+		 * @param position 	Receives the bottom left corner of the rectangle
+		 * @return 			`true` if the rectangle fit into the remaining area
+		 */
+		bool Insert(unsigned int width, unsigned int height, glm::uvec2& position);
+
+		/**
+		 * @brief Mark the entire area as unused again
+		 */
+		void Clear();
+
+		/**
+		 * @brief Get the ratio of used area to total area
+		 *
+		 * @return A number between 0 and 1
+		 */
+		inline float GetOccupancy() const { return (float)usedArea / ((float)size.x * (float)size.y); }
+
+		/**
+		 * @brief Get the size of the area the packer packs into
+		 *
+		 * @return Width and height of the packing area
+		 */
+		inline const glm::uvec2& GetDimensions() const { return size; }
+
+	private:
+		/**
+		 * @brief One horizontal segment of the skyline
+		 */
+		struct Node
+		{
+			unsigned int x, y;
+			unsigned int width;
+		};
+
+		/**
+		 * @brief Checks if a rectangle fits on top of the skyline, starting at a node
+		 *
+		 * @param index 	Index of the leftmost node the rectangle would rest on
+		 * @param width 	Width of the rectangle
+		 * @param height 	Height of the rectangle
+		 * @param y 		Receives the height the rectangle would be placed at
+		 * @return 			`true` if the rectangle fits
+		 */
+		bool Fits(size_t index, unsigned int width, unsigned int height, unsigned int& y) const;
+
+	private:
+		glm::uvec2 size;
+		size_t usedArea;
+		std::vector<Node> skyline;
+	};
+
+}
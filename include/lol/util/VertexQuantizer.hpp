@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <lol/buffers/VertexBuffer.hpp>
+
+namespace lol
+{
+	/**
+	 * @brief How a vertex attribute is stored after quantization
+	 */
+	enum class AttributeEncoding
+	{
+		Float,			///< Unchanged 32 bit floats
+		Bounds16,		///< Unsigned normalized 16 bit integers spanning the bounding box of the attribute, for positions
+		Octahedral16,	///< Unit vectors mapped onto an octahedron, 2 signed normalized 16 bit integers, for normals
+		Packed1010102,	///< Unit vectors as 10 bits per component plus a 2 bit sign in w, for normals and tangents
+		Half,			///< 16 bit floats, for texture coordinates
+		UNorm8			///< Unsigned normalized 8 bit integers, for colors in the range [0, 1]
+	};
+
+	/**
+	 * @brief An attribute of the float vertices passed to VertexQuantizer
+	 */
+	struct QuantizedAttribute
+	{
+		unsigned int components;		///< Number of floats of the attribute in the source vertices
+		AttributeEncoding encoding;		///< How to store the attribute
+	};
+
+	/**
+	 * @brief Turns the value read from a quantized attribute back into the original value
+	 *
+	 * The original value is `offset + scale * value`, applied to all four components of the
+	 * attribute in the shader. Octahedral16 attributes have to be decoded afterwards.
+	 */
+	struct Dequantization
+	{
+		glm::vec4 scale;
+		glm::vec4 offset;
+	};
+
+	/**
+	 * @brief The output of VertexQuantizer::Quantize()
+	 */
+	struct QuantizedVertices
+	{
+		std::vector<uint8_t> data;						///< Interleaved vertices, ready for VertexBuffer
+		BufferLayout layout;							///< Layout of `data`, set it on the VertexBuffer
+		std::vector<Dequantization> dequantization;		///< One entry per attribute, pass them to the shader as uniforms
+		size_t vertexCount;
+	};
+
+	/**
+	 * @brief Stores vertex attributes with fewer bits than 32 bit floats
+	 *
+	 * Most attributes don't need the precision of a float. Quantizing positions to 16 bits
+	 * within the mesh bounds, normals to 32 bits in total, texture coordinates to half floats
+	 * and colors to bytes shrinks a typical vertex by a factor of 2 to 3, which saves memory
+	 * and bandwidth in the vertex fetch.
+	 *
+	 * Every attribute is padded to a multiple of 4 bytes. Components that only exist because
+	 * of the padding read as 0, except for w which reads as 1, just like missing components
+	 * of unquantized attributes.
+	 *
+	 * The shader applies the dequantization of each attribute itself. GetShaderSource()
+	 * returns helper functions for that, register them with ShaderPreprocessor::AddSource():
+	 *
+	 * ```glsl
+	 * #include "lol/dequantize.glsl"
+	 *
+	 * layout (location = 0) in vec4 position;
+	 * layout (location = 1) in vec2 normal;
+	 * uniform vec4 positionScale, positionOffset;
+	 *
+	 * vec3 p = lolDequantize(position, positionScale, positionOffset).xyz;
+	 * vec3 n = lolOctahedralDecode(normal);
+	 * ```
+	 */
+	class VertexQuantizer
+	{
+	public:
+		/**
+		 * @brief Construct a new VertexQuantizer
+		 *
+		 * @param attributes 	The attributes of the source vertices, in order, and how to store them
+		 */
+		VertexQuantizer(const std::initializer_list<QuantizedAttribute>& attributes);
+
+		/**
+		 * @brief Construct a new VertexQuantizer from attributes that were put together at runtime
+		 *
+		 * @param attributes 	The attributes of the source vertices, in order, and how to store them
+		 */
+		VertexQuantizer(const std::vector<QuantizedAttribute>& attributes);
+
+		/**
+		 * @brief Quantize interleaved float vertices
+		 *
+		 * Bounds16 attributes are quantized within the bounds of the attribute over all vertices.
+		 * Octahedral16 attributes need 3 components, Packed1010102 attributes 3 or 4, where
+		 * the fourth is a sign (e.g. the handedness of a tangent). Both expect unit vectors.
+		 *
+		 * @param vertices 	The vertices, with the attributes given to the constructor
+		 * @return 			The quantized vertices with their layout and dequantization parameters
+		 */
+		QuantizedVertices Quantize(const std::vector<float>& vertices) const;
+
+		/**
+		 * @brief Get the number of floats per source vertex
+		 */
+		inline unsigned int GetSourceStride() const { return sourceStride; }
+
+		/**
+		 * @brief Get GLSL helpers for reading quantized attributes
+		 *
+		 * Defines `vec4 lolDequantize(vec4 value, vec4 scale, vec4 offset)` and
+		 * `vec3 lolOctahedralDecode(vec2 value)`.
+		 */
+		static const char* GetShaderSource();
+
+	private:
+		std::vector<QuantizedAttribute> attributes;
+		unsigned int sourceStride;
+	};
+}
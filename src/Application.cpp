@@ -0,0 +1,58 @@
+#include <lol/Application.hpp>
+
+#include <algorithm>
+
+#include <lol/util/DeletionQueue.hpp>
+#include <lol/util/RenderStats.hpp>
+
+namespace lol
+{
+	Application::Application(float timestep) :
+		timestep(timestep), maxFrameTime(0.25f), accumulator(0.0f), running(false), started(false)
+	{
+		// Otherwise no amount of accumulated time is ever used up by updates
+		assert(timestep > 0.0f && "lol::Application::Application() timestep must be greater than 0");
+
+		// RunFrame() calls NewFrame(), so released objects can wait for the GPU
+		DeletionQueue::Get().SetEnabled(true);
+	}
+
+	Application::~Application()
+	{
+	}
+
+	void Application::Run()
+	{
+		running = true;
+		while (running && !ShouldClose())
+			RunFrame();
+	}
+
+	void Application::RunFrame()
+	{
+		auto now = std::chrono::steady_clock::now();
+		if (!started)
+		{
+			lastFrame = now;
+			started = true;
+		}
+
+		float elapsed = std::chrono::duration<float>(now - lastFrame).count();
+		lastFrame = now;
+
+		BeginFrame();
+
+		accumulator += std::min(elapsed, maxFrameTime);
+		while (accumulator >= timestep)
+		{
+			layers.Update(timestep);
+			accumulator -= timestep;
+		}
+
+		layers.Render(GetCamera(), accumulator / timestep);
+
+		EndFrame();
+		DeletionQueue::Get().NewFrame();
+		RenderStats::Get().NewFrame();
+	}
+}
@@ -0,0 +1,173 @@
+#include <lol/AsyncReadback.hpp>
+
+#include <algorithm>
+#include <assert.h>
+#include <cstring>
+#include <memory>
+
+#include <glad/glad.h>
+
+#include <lol/Framebuffer.hpp>
+#include <lol/util/DeletionQueue.hpp>
+#include <lol/util/Profiler.hpp>
+
+namespace lol
+{
+	AsyncReadback::AsyncReadback(size_t buffers) :
+		slots(std::max<size_t>(buffers, 1)), next(0), pending(0), completing(false)
+	{
+		for (Slot& slot : slots)
+			glGenBuffers(1, &slot.buffer);
+	}
+
+	AsyncReadback::~AsyncReadback()
+	{
+		for (Slot& slot : slots)
+		{
+			if (slot.fence != nullptr)
+				glDeleteSync((GLsync)slot.fence);
+
+			DeletionQueue::Get().Release(ObjectType::Buffer, slot.buffer);
+		}
+	}
+
+	void AsyncReadback::Read(Framebuffer& framebuffer, Callback callback, FramebufferAttachment attachment, PixelFormat format, PixelType type)
+	{
+		LOL_PROFILE_SCOPE("AsyncReadback::Read");
+		assert(!completing && "lol::AsyncReadback::Read() can't be called from a readback callback");
+
+		// Reusing the oldest buffer, its pixels have to be handed out first
+		if (pending == slots.size())
+			CompleteOldest(true);
+
+		Slot& slot = slots[next];
+		slot.dimensions = framebuffer.GetDimensions();
+		slot.format = format;
+		slot.type = type;
+		slot.size = (size_t)slot.dimensions.x * slot.dimensions.y * SizeOf(format, type);
+		slot.callback = std::move(callback);
+
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer.id);
+		glReadBuffer(NATIVE(attachment));
+
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+		if (slot.capacity < slot.size)
+		{
+			glBufferData(GL_PIXEL_PACK_BUFFER, slot.size, nullptr, GL_STREAM_READ);
+			slot.capacity = slot.size;
+		}
+
+		// With a pack buffer bound the pixels go into the buffer, and the call returns right away
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glReadPixels(0, 0, slot.dimensions.x, slot.dimensions.y, NATIVE(format), NATIVE(type), nullptr);
+		glPixelStorei(GL_PACK_ALIGNMENT, 4);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+		next = (next + 1) % slots.size();
+		pending++;
+	}
+
+	std::future<Image> AsyncReadback::ReadImage(Framebuffer& framebuffer, FramebufferAttachment attachment, PixelFormat format, PixelType type, ImageAllocator* allocator)
+	{
+		std::shared_ptr<std::promise<Image>> promise = std::make_shared<std::promise<Image>>();
+		std::future<Image> future = promise->get_future();
+
+		Read(framebuffer, [promise, allocator](const ReadbackView& view)
+		{
+			Image image(view.dimensions.x, view.dimensions.y, view.format, view.type, 1, allocator);
+
+			size_t rowSize = view.size / std::max(view.dimensions.y, 1u);
+			for (unsigned int y = 0; y < view.dimensions.y; y++)
+				std::memcpy(image.GetRow(y), view.pixels + y * rowSize, rowSize);
+
+			promise->set_value(std::move(image));
+		}, attachment, format, type);
+
+		return future;
+	}
+
+	size_t AsyncReadback::Poll()
+	{
+		assert(!completing && "lol::AsyncReadback::Poll() can't be called from a readback callback");
+
+		size_t completed = 0;
+		while (pending > 0 && CompleteOldest(false))
+			completed++;
+
+		return completed;
+	}
+
+	size_t AsyncReadback::Finish()
+	{
+		assert(!completing && "lol::AsyncReadback::Finish() can't be called from a readback callback");
+
+		size_t completed = 0;
+		while (pending > 0 && CompleteOldest(true))
+			completed++;
+
+		return completed;
+	}
+
+	bool AsyncReadback::CompleteOldest(bool wait)
+	{
+		Slot& slot = slots[(next + slots.size() - pending) % slots.size()];
+
+		// The first check flushes, otherwise the fence might never reach the GPU
+		GLuint64 timeout = wait ? 1000000000 : 0;
+		GLenum result = glClientWaitSync((GLsync)slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+		while (wait && result == GL_TIMEOUT_EXPIRED)
+			result = glClientWaitSync((GLsync)slot.fence, 0, timeout);
+
+		if (result == GL_TIMEOUT_EXPIRED)
+			return false;
+
+		LOL_PROFILE_SCOPE("AsyncReadback::Complete");
+
+		glDeleteSync((GLsync)slot.fence);
+		slot.fence = nullptr;
+		pending--;
+
+		// Dropping the callback of a failed readback breaks the future of ReadImage()
+		Callback callback = std::move(slot.callback);
+		slot.callback = nullptr;
+
+		if (result == GL_WAIT_FAILED)
+			return true;
+
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+		const uint8_t* pixels = (const uint8_t*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, slot.size, GL_MAP_READ_BIT);
+		if (pixels == nullptr)
+		{
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+			return true;
+		}
+
+		// The view points into the mapped buffer, which the callback must not reuse (see Read())
+		auto unmap = [&slot]()
+		{
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+			glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		};
+
+		completing = true;
+		try
+		{
+			if (callback)
+				callback(ReadbackView{ pixels, slot.size, slot.dimensions, slot.format, slot.type });
+		}
+		catch (...)
+		{
+			completing = false;
+			unmap();
+			throw;
+		}
+
+		completing = false;
+		unmap();
+
+		return true;
+	}
+}
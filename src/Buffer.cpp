@@ -1,31 +1,104 @@
 #include <lol/Buffer.hpp>
 
+#include <assert.h>
+
+#include <lol/util/Capabilities.hpp>
+#include <lol/util/DeletionQueue.hpp>
+#include <lol/util/RenderStats.hpp>
+#include <lol/util/ResidencyManager.hpp>
+
 namespace lol
 {
 	Buffer::Buffer(BufferType type) :
-		id(0), type(type)
+		id(0), type(type), size(0), residency(nullptr)
 	{
+		if (UsesDirectStateAccess())
+		{
+			glCreateBuffers(1, &id);
+			return;
+		}
+
 		glGenBuffers(1, &id);
 		glBindBuffer(NATIVE(type), id);
 	}
 
 	Buffer::~Buffer()
 	{
-		glDeleteBuffers(1, &id);
+		if (residency != nullptr)
+			residency->Untrack(*this);
+
+		RenderStats::Get().AddMemory(RenderMemory::Buffer, -(int64_t)size);
+		DeletionQueue::Get().Release(ObjectType::Buffer, id);
 	}
 
 	void* Buffer::Map(Access access)
 	{
+		if (UsesDirectStateAccess())
+			return glMapNamedBuffer(id, NATIVE(access));
+
+		Bind();
 		return glMapBuffer(NATIVE(type), NATIVE(access));
 	}
 
 	void Buffer::Unmap()
 	{
+		if (UsesDirectStateAccess())
+		{
+			glUnmapNamedBuffer(id);
+			return;
+		}
+
+		Bind();
 		glUnmapBuffer(NATIVE(type));
 	}
 
+	void Buffer::Reallocate(const void* data, size_t bytes, Usage usage)
+	{
+		// The manager remembers the size the buffer had when it was tracked
+		ResidencyManager* manager = residency;
+		if (manager != nullptr)
+			manager->Untrack(*this);
+
+		// Immutable storage (glNamedBufferStorage) can't be replaced, so both paths keep the storage mutable
+		if (UsesDirectStateAccess())
+		{
+			glNamedBufferData(id, bytes, data, NATIVE(usage));
+		}
+		else
+		{
+			Bind();
+			glBufferData(NATIVE(type), bytes, data, NATIVE(usage));
+		}
+
+		if (data != nullptr)
+			RenderStats::Get().Add(RenderCounter::BufferUploadBytes, bytes);
+
+		RenderStats::Get().AddMemory(RenderMemory::Buffer, (int64_t)bytes - (int64_t)size);
+		size = bytes;
+
+		if (manager != nullptr)
+			manager->Track(*this);
+	}
+
+	void Buffer::Update(const void* data, size_t bytes, size_t offset)
+	{
+		assert(offset + bytes <= size && "lol::Buffer::Update() writes past the end of the buffer");
+
+		if (UsesDirectStateAccess())
+		{
+			glNamedBufferSubData(id, offset, bytes, data);
+		}
+		else
+		{
+			Bind();
+			glBufferSubData(NATIVE(type), offset, bytes, data);
+		}
+		RenderStats::Get().Add(RenderCounter::BufferUploadBytes, bytes);
+	}
+
 	void Buffer::Bind()
 	{
+		RenderStats::Get().Add(RenderCounter::BufferBinds);
 		glBindBuffer(NATIVE(type), id);
 	}
 
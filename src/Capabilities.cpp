@@ -0,0 +1,46 @@
+#include <lol/util/Capabilities.hpp>
+
+#include <unordered_set>
+
+#include <glad/glad.h>
+
+namespace lol
+{
+	static std::unordered_set<std::string> QueryExtensions()
+	{
+		std::unordered_set<std::string> extensions;
+
+		GLint count = 0;
+		glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+		for (GLint i = 0; i < count; i++)
+		{
+			const GLubyte* name = glGetStringi(GL_EXTENSIONS, i);
+			if (name != nullptr)
+				extensions.insert((const char*)name);
+		}
+
+		return extensions;
+	}
+
+	bool HasExtension(const std::string& name)
+	{
+		static const std::unordered_set<std::string> extensions = QueryExtensions();
+		return extensions.count(name) != 0;
+	}
+
+	// -1 until the first object is created with a current context
+	static int directStateAccess = -1;
+
+	bool UsesDirectStateAccess()
+	{
+		if (directStateAccess < 0)
+			directStateAccess = GLAD_GL_VERSION_4_5 ? 1 : 0;
+
+		return directStateAccess != 0;
+	}
+
+	void SetDirectStateAccess(bool enable)
+	{
+		directStateAccess = (enable && GLAD_GL_VERSION_4_5) ? 1 : 0;
+	}
+}
@@ -0,0 +1,332 @@
+#include <lol/CommandBuffer.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <lol/Drawable.hpp>
+#include <lol/Shader.hpp>
+#include <lol/Texture.hpp>
+#include <lol/VertexArrayObject.hpp>
+#include <lol/util/JobSystem.hpp>
+#include <lol/util/Profiler.hpp>
+#include <lol/util/RenderStats.hpp>
+
+namespace lol
+{
+	// Payloads of the commands, stored right after the command type
+	struct ShaderCommand { Shader* shader; Shader* fallback; };
+	struct TextureCommand { Texture* texture; unsigned int unit; };
+	struct IntCommand { int location; int value; };
+	struct FloatCommand { int location; float value; };
+	struct Vec2Command { int location; glm::vec2 value; };
+	struct Vec4Command { int location; glm::vec4 value; };
+	struct Mat4Command { int location; glm::mat4 value; };
+	struct DrawCommand { GLenum mode; unsigned int count; unsigned int first; GLenum indexType; };
+
+	template<typename Payload>
+	static Payload Read(const uint8_t*& cursor)
+	{
+		Payload payload;
+		std::memcpy(&payload, cursor, sizeof(Payload));
+		cursor += sizeof(Payload);
+
+		return payload;
+	}
+
+	CommandBuffer::CommandBuffer() :
+		commandCount(0), lastShader(nullptr), lastFallback(nullptr), lastVAO(nullptr)
+	{
+	}
+
+	CommandBuffer::CommandBuffer(CommandBuffer&& other) noexcept :
+		data(std::move(other.data)), commandCount(other.commandCount), lastShader(other.lastShader), lastFallback(other.lastFallback), lastVAO(other.lastVAO)
+	{
+		other.Clear();
+	}
+
+	CommandBuffer& CommandBuffer::operator=(CommandBuffer&& other) noexcept
+	{
+		data = std::move(other.data);
+		commandCount = other.commandCount;
+		lastShader = other.lastShader;
+		lastFallback = other.lastFallback;
+		lastVAO = other.lastVAO;
+
+		other.Clear();
+		return *this;
+	}
+
+	template<typename Payload>
+	void CommandBuffer::Push(CommandType type, const Payload& payload)
+	{
+		size_t offset = data.size();
+		data.resize(offset + 1 + sizeof(Payload));
+		data[offset] = (uint8_t)type;
+		std::memcpy(data.data() + offset + 1, &payload, sizeof(Payload));
+
+		commandCount++;
+	}
+
+	void CommandBuffer::BindShader(Shader& shader, Shader* fallback)
+	{
+		if (lastShader == &shader && lastFallback == fallback)
+			return;
+
+		Push(CommandType::BindShader, ShaderCommand{ &shader, fallback });
+		lastShader = &shader;
+		lastFallback = fallback;
+	}
+
+	void CommandBuffer::BindVertexArray(VertexArray& vao)
+	{
+		if (lastVAO == &vao)
+			return;
+
+		Push(CommandType::BindVertexArray, &vao);
+		lastVAO = &vao;
+	}
+
+	void CommandBuffer::BindTexture(Texture& texture, unsigned int unit)
+	{
+		Push(CommandType::BindTexture, TextureCommand{ &texture, unit });
+	}
+
+	void CommandBuffer::SetUniform(int location, int value)
+	{
+		Push(CommandType::Uniform1i, IntCommand{ location, value });
+	}
+
+	void CommandBuffer::SetUniform(int location, float value)
+	{
+		Push(CommandType::Uniform1f, FloatCommand{ location, value });
+	}
+
+	void CommandBuffer::SetUniform(int location, const glm::vec2& value)
+	{
+		Push(CommandType::Uniform2f, Vec2Command{ location, value });
+	}
+
+	void CommandBuffer::SetUniform(int location, const glm::vec4& value)
+	{
+		Push(CommandType::Uniform4f, Vec4Command{ location, value });
+	}
+
+	void CommandBuffer::SetUniform(int location, const glm::mat4& value)
+	{
+		Push(CommandType::UniformMatrix4f, Mat4Command{ location, value });
+	}
+
+	void CommandBuffer::DrawElements(DrawMode mode, unsigned int count, unsigned int first, Type indexType)
+	{
+		Push(CommandType::DrawElements, DrawCommand{ NATIVE(mode), count, first, NATIVE(indexType) });
+	}
+
+	void CommandBuffer::Append(const CommandBuffer& other)
+	{
+		data.insert(data.end(), other.data.begin(), other.data.end());
+		commandCount += other.commandCount;
+
+		// The other buffer may have bound anything
+		lastShader = other.lastShader;
+		lastFallback = other.lastFallback;
+		lastVAO = other.lastVAO;
+	}
+
+	void CommandBuffer::Execute() const
+	{
+		LOL_PROFILE_SCOPE("CommandBuffer::Execute");
+		LOL_PROFILE_GPU_SCOPE("CommandBuffer::Execute");
+
+		const uint8_t* cursor = data.data();
+		const uint8_t* end = data.data() + data.size();
+
+		// While neither the shader nor its fallback is ready, everything up to the next shader bind is skipped.
+		// Uniforms are also skipped while the fallback is bound, their locations belong to the other program.
+		// Once one was dropped the fallback would draw with stale values, so draws are skipped from then on.
+		bool skipping = false;
+		bool skippingUniforms = false;
+		bool droppedUniforms = false;
+
+		while (cursor < end)
+		{
+			CommandType type = (CommandType)*cursor++;
+			switch (type)
+			{
+			case CommandType::BindShader:
+			{
+				ShaderCommand command = Read<ShaderCommand>(cursor);
+				Shader* shader = command.shader;
+				skippingUniforms = false;
+				droppedUniforms = false;
+				if (shader->GetStatus() != ShaderStatus::Ready)
+				{
+					shader = command.fallback;
+					skippingUniforms = true;
+				}
+
+				skipping = (shader == nullptr || shader->GetStatus() != ShaderStatus::Ready);
+				if (!skipping)
+					shader->Bind();
+				break;
+			}
+
+			case CommandType::BindVertexArray:
+			{
+				// Recording drops binds of the VAO that is already bound, even across shader binds,
+				// so it is bound even while skipping, later commands may rely on it
+				VertexArray* vao = Read<VertexArray*>(cursor);
+				vao->Bind();
+				break;
+			}
+
+			case CommandType::BindTexture:
+			{
+				TextureCommand command = Read<TextureCommand>(cursor);
+				if (!skipping)
+				{
+					glActiveTexture(GL_TEXTURE0 + command.unit);
+					command.texture->Bind();
+				}
+				break;
+			}
+
+			case CommandType::Uniform1i:
+			{
+				IntCommand command = Read<IntCommand>(cursor);
+				if (skippingUniforms)
+					droppedUniforms = true;
+				else if (!skipping)
+				{
+					RenderStats::Get().Add(RenderCounter::UniformUpdates);
+					glUniform1i(command.location, command.value);
+				}
+				break;
+			}
+
+			case CommandType::Uniform1f:
+			{
+				FloatCommand command = Read<FloatCommand>(cursor);
+				if (skippingUniforms)
+					droppedUniforms = true;
+				else if (!skipping)
+				{
+					RenderStats::Get().Add(RenderCounter::UniformUpdates);
+					glUniform1f(command.location, command.value);
+				}
+				break;
+			}
+
+			case CommandType::Uniform2f:
+			{
+				Vec2Command command = Read<Vec2Command>(cursor);
+				if (skippingUniforms)
+					droppedUniforms = true;
+				else if (!skipping)
+				{
+					RenderStats::Get().Add(RenderCounter::UniformUpdates);
+					glUniform2fv(command.location, 1, glm::value_ptr(command.value));
+				}
+				break;
+			}
+
+			case CommandType::Uniform4f:
+			{
+				Vec4Command command = Read<Vec4Command>(cursor);
+				if (skippingUniforms)
+					droppedUniforms = true;
+				else if (!skipping)
+				{
+					RenderStats::Get().Add(RenderCounter::UniformUpdates);
+					glUniform4fv(command.location, 1, glm::value_ptr(command.value));
+				}
+				break;
+			}
+
+			case CommandType::UniformMatrix4f:
+			{
+				Mat4Command command = Read<Mat4Command>(cursor);
+				if (skippingUniforms)
+					droppedUniforms = true;
+				else if (!skipping)
+				{
+					RenderStats::Get().Add(RenderCounter::UniformUpdates);
+					glUniformMatrix4fv(command.location, 1, GL_FALSE, glm::value_ptr(command.value));
+				}
+				break;
+			}
+
+			case CommandType::DrawElements:
+			{
+				DrawCommand command = Read<DrawCommand>(cursor);
+				if (!skipping && !droppedUniforms)
+				{
+					glDrawElements(command.mode, command.count, command.indexType, (const void*)(command.first * SizeOf((Type)command.indexType)));
+					RenderStats::Get().AddDraw((DrawMode)command.mode, command.count);
+				}
+				break;
+			}
+			}
+		}
+	}
+
+	void CommandBuffer::Clear()
+	{
+		data.clear();
+		commandCount = 0;
+		lastShader = nullptr;
+		lastFallback = nullptr;
+		lastVAO = nullptr;
+	}
+
+	CommandQueue::CommandQueue() :
+		usedBuffers(0)
+	{
+	}
+
+	void CommandQueue::Record(const std::vector<Drawable*>& drawables, const CameraBase& camera, JobSystem& jobs)
+	{
+		LOL_PROFILE_SCOPE("CommandQueue::Record");
+
+		// A few ranges per thread, so threads that finish early can steal some work
+		const size_t minimumRange = 64;
+		size_t ranges = std::min<size_t>((jobs.GetWorkerCount() + 1) * 4, (drawables.size() + minimumRange - 1) / minimumRange);
+		size_t rangeSize = (ranges > 0) ? (drawables.size() + ranges - 1) / ranges : 0;
+
+		if (buffers.size() < ranges)
+			buffers.resize(ranges);
+
+		usedBuffers = ranges;
+
+		jobs.ParallelFor(0, ranges, [&](size_t first, size_t last)
+		{
+			for (size_t range = first; range < last; range++)
+			{
+				LOL_PROFILE_SCOPE("CommandQueue::Record range");
+
+				CommandBuffer& buffer = buffers[range];
+				buffer.Clear();
+
+				size_t end = std::min(drawables.size(), (range + 1) * rangeSize);
+				for (size_t i = range * rangeSize; i < end; i++)
+					drawables[i]->Record(buffer, camera);
+			}
+		}, 1);
+	}
+
+	void CommandQueue::Execute() const
+	{
+		for (size_t i = 0; i < usedBuffers; i++)
+			buffers[i].Execute();
+	}
+
+	size_t CommandQueue::GetCommandCount() const
+	{
+		size_t count = 0;
+		for (size_t i = 0; i < usedBuffers; i++)
+			count += buffers[i].GetCommandCount();
+
+		return count;
+	}
+}
@@ -0,0 +1,100 @@
+#include <lol/util/ContentCache.hpp>
+
+#include <lol/Image.hpp>
+#include <lol/Texture.hpp>
+#include <lol/Shader.hpp>
+#include <lol/buffers/VertexBuffer.hpp>
+#include <lol/buffers/ElementBuffer.hpp>
+
+namespace lol
+{
+	// Every kind of resource gets its own seed, so e.g. a shader and a buffer with the same bytes don't collide
+	enum class ResourceKind : uint64_t
+	{
+		Texture2D = 1,
+		VertexBuffer,
+		ElementBuffer,
+		Shader
+	};
+
+	static Hash128 MakeKey(ResourceKind kind, uint64_t parameter, const Hash128& content)
+	{
+		uint64_t header[2] = { (uint64_t)kind, parameter };
+		return HashCombine(HashBytes(header, sizeof(header)), content);
+	}
+
+	ContentCache::ContentCache() :
+		deduplicatedBytes(0), hits(0), misses(0)
+	{
+	}
+
+	template<typename T, typename Create, typename Size>
+	std::shared_ptr<T> ContentCache::GetOrCreate(const Hash128& hash, Create&& create, Size&& size)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		std::weak_ptr<void>& entry = resources[hash];
+		std::shared_ptr<T> resource = std::static_pointer_cast<T>(entry.lock());
+		if (resource != nullptr)
+		{
+			hits.fetch_add(1, std::memory_order_relaxed);
+			deduplicatedBytes.fetch_add(size(*resource), std::memory_order_relaxed);
+			return resource;
+		}
+
+		misses.fetch_add(1, std::memory_order_relaxed);
+		resource = create();
+		entry = resource;
+
+		return resource;
+	}
+
+	std::shared_ptr<Texture2D> ContentCache::GetTexture2D(const Image& image, TextureFormat texFormat)
+	{
+		Hash128 key = MakeKey(ResourceKind::Texture2D, NATIVE(texFormat), HashContent(image));
+		return GetOrCreate<Texture2D>(key,
+			[&]() { return std::make_shared<Texture2D>(image, texFormat); },
+			[](const Texture2D& resource) { return resource.GetMemoryUsage(); }
+		);
+	}
+
+	std::shared_ptr<VertexBuffer> ContentCache::GetVertexBuffer(const std::vector<float>& data, Usage usage)
+	{
+		Hash128 key = MakeKey(ResourceKind::VertexBuffer, NATIVE(usage), HashContent(data));
+		return GetOrCreate<VertexBuffer>(key,
+			[&]() { return std::make_shared<VertexBuffer>(data, usage); },
+			[](const VertexBuffer& resource) { return resource.GetSize(); }
+		);
+	}
+
+	std::shared_ptr<ElementBuffer> ContentCache::GetElementBuffer(const std::vector<unsigned int>& elements, Usage usage)
+	{
+		Hash128 key = MakeKey(ResourceKind::ElementBuffer, NATIVE(usage), HashContent(elements));
+		return GetOrCreate<ElementBuffer>(key,
+			[&]() { return std::make_shared<ElementBuffer>(elements, usage); },
+			[](const ElementBuffer& resource) { return resource.GetSize(); }
+		);
+	}
+
+	std::shared_ptr<Shader> ContentCache::GetShader(const std::string& vertexShader, const std::string& fragmentShader)
+	{
+		Hash128 key = MakeKey(ResourceKind::Shader, 0, HashCombine(HashContent(vertexShader), HashContent(fragmentShader)));
+		return GetOrCreate<Shader>(key,
+			[&]() { return std::make_shared<Shader>(vertexShader, fragmentShader); },
+			[](const Shader&) { return (size_t)0; }	// Program sizes aren't known to the application
+		);
+	}
+
+	void ContentCache::ClearExpired()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		for (auto it = resources.begin(); it != resources.end();)
+		{
+			if (it->second.expired())
+				it = resources.erase(it);
+			else
+				it++;
+		}
+	}
+}
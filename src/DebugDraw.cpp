@@ -0,0 +1,244 @@
+#include <lol/DebugDraw.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include <glad/glad.h>
+
+#include <lol/Camera.hpp>
+#include <lol/Shader.hpp>
+#include <lol/Transformable.hpp>
+#include <lol/VertexArrayObject.hpp>
+#include <lol/buffers/VertexBuffer.hpp>
+#include <lol/util/Profiler.hpp>
+#include <lol/util/RenderStats.hpp>
+
+namespace lol
+{
+	static const char* debugVertexShader = R"(
+#version 330 core
+layout (location = 0) in vec3 position;
+layout (location = 1) in vec4 color;
+
+uniform mat4 viewProjection;
+
+out vec4 fragmentColor;
+
+void main()
+{
+	fragmentColor = color;
+	gl_Position = viewProjection * vec4(position, 1.0);
+}
+)";
+
+	static const char* debugFragmentShader = R"(
+#version 330 core
+in vec4 fragmentColor;
+
+out vec4 result;
+
+void main()
+{
+	result = fragmentColor;
+}
+)";
+
+	static void ToBytes(const glm::vec4& color, uint8_t* bytes)
+	{
+		for (int i = 0; i < 4; i++)
+			bytes[i] = (uint8_t)(std::min(std::max(color[i], 0.0f), 1.0f) * 255.0f + 0.5f);
+	}
+
+	DebugDraw& DebugDraw::Get()
+	{
+		// Never destroyed, so no OpenGL calls happen after the context is gone
+		static DebugDraw* debugDraw = new DebugDraw();
+		return *debugDraw;
+	}
+
+	DebugDraw::DebugDraw()
+	{
+	}
+
+	void DebugDraw::Line(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color, bool depthTest)
+	{
+		uint8_t bytes[4];
+		ToBytes(color, bytes);
+
+		std::lock_guard<std::mutex> lock(mutex);
+		Append(from, to, bytes, depthTest);
+	}
+
+	void DebugDraw::Box(const BoundingBox& box, const glm::vec4& color, bool depthTest)
+	{
+		uint8_t bytes[4];
+		ToBytes(color, bytes);
+
+		// Corner i has the maximum x if bit 0 is set, maximum y for bit 1 and maximum z for bit 2
+		glm::vec3 corners[8];
+		for (int i = 0; i < 8; i++)
+			corners[i] = glm::vec3(box.x + ((i & 1) ? box.w : 0.0f), box.y + ((i & 2) ? box.h : 0.0f), box.z + ((i & 4) ? box.d : 0.0f));
+
+		std::lock_guard<std::mutex> lock(mutex);
+		for (int i = 0; i < 8; i++)
+		{
+			// Connect every corner to the neighbours with one more bit set
+			for (int bit = 1; bit < 8; bit <<= 1)
+			{
+				if (!(i & bit))
+					Append(corners[i], corners[i | bit], bytes, depthTest);
+			}
+		}
+	}
+
+	void DebugDraw::Sphere(const glm::vec3& center, float radius, const glm::vec4& color, bool depthTest, unsigned int segments)
+	{
+		uint8_t bytes[4];
+		ToBytes(color, bytes);
+		segments = std::max(segments, 3u);
+
+		std::lock_guard<std::mutex> lock(mutex);
+		glm::vec2 previous(radius, 0.0f);
+		for (unsigned int i = 1; i <= segments; i++)
+		{
+			float angle = 2.0f * glm::pi<float>() * (float)i / (float)segments;
+			glm::vec2 current(std::cos(angle) * radius, std::sin(angle) * radius);
+
+			Append(center + glm::vec3(previous.x, previous.y, 0.0f), center + glm::vec3(current.x, current.y, 0.0f), bytes, depthTest);
+			Append(center + glm::vec3(previous.x, 0.0f, previous.y), center + glm::vec3(current.x, 0.0f, current.y), bytes, depthTest);
+			Append(center + glm::vec3(0.0f, previous.x, previous.y), center + glm::vec3(0.0f, current.x, current.y), bytes, depthTest);
+
+			previous = current;
+		}
+	}
+
+	void DebugDraw::Frustum(const CameraBase& camera, const glm::vec4& color, bool depthTest)
+	{
+		uint8_t bytes[4];
+		ToBytes(color, bytes);
+
+		// The frustum is the clip space cube, transformed back into world space
+		glm::mat4 inverse = glm::inverse(camera.GetProjection() * camera.GetView());
+		glm::vec3 corners[8];
+		for (int i = 0; i < 8; i++)
+		{
+			glm::vec4 corner = inverse * glm::vec4((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f, 1.0f);
+			corners[i] = glm::vec3(corner) / corner.w;
+		}
+
+		std::lock_guard<std::mutex> lock(mutex);
+		for (int i = 0; i < 8; i++)
+		{
+			for (int bit = 1; bit < 8; bit <<= 1)
+			{
+				if (!(i & bit))
+					Append(corners[i], corners[i | bit], bytes, depthTest);
+			}
+		}
+	}
+
+	void DebugDraw::Axes(const Transformable& object, float length, bool depthTest)
+	{
+		static const uint8_t colors[3][4] = { { 255, 0, 0, 255 }, { 0, 255, 0, 255 }, { 0, 0, 255, 255 } };
+
+		const glm::vec3& origin = object.GetPosition();
+		const glm::vec3& scale = object.GetScale();
+
+		std::lock_guard<std::mutex> lock(mutex);
+		for (int axis = 0; axis < 3; axis++)
+		{
+			glm::vec3 direction(0.0f);
+			direction[axis] = length * scale[axis];
+
+			Append(origin, origin + object.GetQuaternion() * direction, colors[axis], depthTest);
+		}
+	}
+
+	void DebugDraw::Flush(const CameraBase& camera)
+	{
+		LOL_PROFILE_SCOPE("DebugDraw::Flush");
+
+		size_t withoutDepth, withDepth;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			withoutDepth = lines[0].size();
+			withDepth = lines[1].size();
+			if (withoutDepth == 0 && withDepth == 0)
+				return;
+
+			vertices.clear();
+			vertices.insert(vertices.end(), lines[0].begin(), lines[0].end());
+			vertices.insert(vertices.end(), lines[1].begin(), lines[1].end());
+			lines[0].clear();
+			lines[1].clear();
+		}
+
+		if (shader == nullptr)
+		{
+			shader = std::make_shared<Shader>(debugVertexShader, debugFragmentShader);
+
+			vertexBuffer = std::make_shared<VertexBuffer>(vertices.size() * sizeof(Vertex));
+			vertexBuffer->SetLayout({
+				VertexAttribute(Type::Float, 3, false),
+				VertexAttribute(Type::UByte, 4, true)
+			});
+
+			vao = std::make_shared<VertexArray>();
+			vao->SetVertexBuffer(vertexBuffer);
+		}
+
+		// Orphaning the old storage, so the lines of the previous frame don't have to be drawn first
+		vertexBuffer->SetData(vertices.data(), vertices.size() * sizeof(Vertex));
+
+		shader->Bind();
+		shader->SetUniform("viewProjection", camera.GetProjection() * camera.GetView());
+		vao->Bind();
+
+		GLboolean depthTestEnabled = glIsEnabled(GL_DEPTH_TEST);
+		if (withoutDepth > 0)
+		{
+			glDisable(GL_DEPTH_TEST);
+			glDrawArrays(GL_LINES, 0, (GLsizei)withoutDepth);
+			RenderStats::Get().AddDraw(DrawMode::Lines, withoutDepth);
+		}
+
+		if (withDepth > 0)
+		{
+			glEnable(GL_DEPTH_TEST);
+			glDrawArrays(GL_LINES, (GLint)withoutDepth, (GLsizei)withDepth);
+			RenderStats::Get().AddDraw(DrawMode::Lines, withDepth);
+		}
+
+		if (depthTestEnabled)
+			glEnable(GL_DEPTH_TEST);
+		else
+			glDisable(GL_DEPTH_TEST);
+	}
+
+	void DebugDraw::Clear()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		lines[0].clear();
+		lines[1].clear();
+	}
+
+	size_t DebugDraw::GetLineCount()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return (lines[0].size() + lines[1].size()) / 2;
+	}
+
+	void DebugDraw::ReleaseGpuResources()
+	{
+		vao = nullptr;
+		vertexBuffer = nullptr;
+		shader = nullptr;
+	}
+
+	void DebugDraw::Append(const glm::vec3& from, const glm::vec3& to, const uint8_t* color, bool depthTest)
+	{
+		std::vector<Vertex>& list = lines[depthTest ? 1 : 0];
+		list.push_back(Vertex{ from, { color[0], color[1], color[2], color[3] } });
+		list.push_back(Vertex{ to, { color[0], color[1], color[2], color[3] } });
+	}
+}
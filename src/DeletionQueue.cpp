@@ -0,0 +1,176 @@
+#include <lol/util/DeletionQueue.hpp>
+
+#include <algorithm>
+#include <assert.h>
+
+#include <glad/glad.h>
+
+#include <lol/util/Profiler.hpp>
+
+namespace lol
+{
+	static void DeleteNames(ObjectType type, const unsigned int* ids, size_t count)
+	{
+		switch (type)
+		{
+		case ObjectType::Buffer:		glDeleteBuffers((GLsizei)count, ids); break;
+		case ObjectType::Texture:		glDeleteTextures((GLsizei)count, ids); break;
+		case ObjectType::VertexArray:	glDeleteVertexArrays((GLsizei)count, ids); break;
+		case ObjectType::Framebuffer:	glDeleteFramebuffers((GLsizei)count, ids); break;
+		case ObjectType::Renderbuffer:	glDeleteRenderbuffers((GLsizei)count, ids); break;
+
+		case ObjectType::Program:
+			for (size_t i = 0; i < count; i++)
+				glDeleteProgram(ids[i]);
+			break;
+
+		case ObjectType::Shader:
+			for (size_t i = 0; i < count; i++)
+				glDeleteShader(ids[i]);
+			break;
+
+		default:
+			assert(false && "lol::DeletionQueue did not implement every object type");
+			break;
+		}
+	}
+
+	DeletionQueue::DeletionQueue() :
+		budget(256), pending(0), enabled(false)
+	{
+	}
+
+	DeletionQueue& DeletionQueue::Get()
+	{
+		// Never destroyed, objects dropped during shutdown must not reach OpenGL after the context is gone
+		static DeletionQueue* queue = new DeletionQueue();
+		return *queue;
+	}
+
+	void DeletionQueue::Release(ObjectType type, unsigned int id)
+	{
+		if (id == 0)
+			return;
+
+		if (!enabled.load(std::memory_order_relaxed))
+		{
+			DeleteNames(type, &id, 1);
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(mutex);
+		released.push_back(Object{ type, id });
+	}
+
+	void DeletionQueue::Submit()
+	{
+		Batch batch{ {}, 0, nullptr };
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (released.empty())
+				return;
+
+			batch.objects.swap(released);
+			pending += batch.objects.size();
+		}
+
+		batch.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		batches.push_back(std::move(batch));
+	}
+
+	void DeletionQueue::NewFrame()
+	{
+		LOL_PROFILE_SCOPE("DeletionQueue::NewFrame");
+
+		Submit();
+
+		size_t remaining = budget;
+		while (!batches.empty() && remaining > 0)
+		{
+			Batch& batch = batches.front();
+			if (batch.fence != nullptr)
+			{
+				// The first check flushes, otherwise the fence might never reach the GPU
+				GLenum result = glClientWaitSync((GLsync)batch.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+				if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+					break;
+
+				glDeleteSync((GLsync)batch.fence);
+				batch.fence = nullptr;
+			}
+
+			size_t count = std::min(remaining, batch.objects.size() - batch.next);
+			Delete(batch, count);
+			remaining -= count;
+
+			if (batch.next == batch.objects.size())
+				batches.pop_front();
+		}
+	}
+
+	void DeletionQueue::Flush()
+	{
+		LOL_PROFILE_SCOPE("DeletionQueue::Flush");
+
+		Submit();
+
+		for (Batch& batch : batches)
+		{
+			if (batch.fence != nullptr)
+			{
+				const GLuint64 second = 1000000000;
+				GLenum result = glClientWaitSync((GLsync)batch.fence, GL_SYNC_FLUSH_COMMANDS_BIT, second);
+				while (result == GL_TIMEOUT_EXPIRED)
+					result = glClientWaitSync((GLsync)batch.fence, 0, second);
+
+				glDeleteSync((GLsync)batch.fence);
+			}
+
+			Delete(batch, batch.objects.size() - batch.next);
+		}
+
+		batches.clear();
+	}
+
+	void DeletionQueue::SetEnabled(bool enable)
+	{
+		enabled.store(enable, std::memory_order_relaxed);
+	}
+
+	bool DeletionQueue::IsEnabled() const
+	{
+		return enabled.load(std::memory_order_relaxed);
+	}
+
+	void DeletionQueue::SetBudget(size_t objects)
+	{
+		budget = std::max<size_t>(objects, 1);
+	}
+
+	size_t DeletionQueue::GetPendingCount()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return pending + released.size();
+	}
+
+	void DeletionQueue::Delete(Batch& batch, size_t count)
+	{
+		for (size_t i = batch.next; i < batch.next + count; i++)
+			names[(size_t)batch.objects[i].type].push_back(batch.objects[i].id);
+
+		batch.next += count;
+
+		for (size_t type = 0; type < (size_t)ObjectType::Count; type++)
+		{
+			std::vector<unsigned int>& ids = names[type];
+			if (ids.empty())
+				continue;
+
+			DeleteNames((ObjectType)type, ids.data(), ids.size());
+			ids.clear();
+		}
+
+		std::lock_guard<std::mutex> lock(mutex);
+		pending -= count;
+	}
+}
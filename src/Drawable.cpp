@@ -1,15 +1,58 @@
 #include <lol/Drawable.hpp>
 
+#include <lol/CommandBuffer.hpp>
+#include <lol/util/Profiler.hpp>
+#include <lol/util/RenderStats.hpp>
+
 namespace lol
 {
 
+	std::shared_ptr<Shader> Drawable::fallbackShader;
+
 	void Drawable::Draw(const CameraBase& camera)
 	{
-		shader->Bind();
+		LOL_PROFILE_SCOPE("Drawable::Draw");
+
+		if (shader->GetStatus() == ShaderStatus::Ready)
+		{
+			DrawWith(shader, camera);
+			return;
+		}
+
+		if (fallbackShader != nullptr && fallbackShader->GetStatus() == ShaderStatus::Ready)
+			DrawWith(fallbackShader, camera);
+	}
+
+	void Drawable::DrawWith(const std::shared_ptr<Shader>& active, const CameraBase& camera)
+	{
+		LOL_PROFILE_GPU_SCOPE("Drawable::Draw");
+
+		// PreRender() sets its uniforms through `shader`, so it has to refer to the bound program
+		// until PreRender() returns. The guard puts the Drawable's own shader back even if it throws.
+		struct ShaderGuard
+		{
+			std::shared_ptr<Shader>& member;
+			std::shared_ptr<Shader> original;
+
+			~ShaderGuard() { member = std::move(original); }
+		} guard{ shader, shader };
+		shader = active;
+
+		active->Bind();
 		vao->Bind();
 		PreRender(camera);
 
-		glDrawElements(NATIVE(type), vao->GetIndexCount(), GL_UNSIGNED_INT, nullptr);
+		glDrawElements(NATIVE(type), vao->GetIndexCount(), NATIVE(vao->GetIndexType()), nullptr);
+		RenderStats::Get().AddDraw(type, vao->GetIndexCount());
+	}
+
+	void Drawable::Record(CommandBuffer& commands, const CameraBase& camera)
+	{
+		commands.BindShader(*shader, fallbackShader.get());
+		commands.BindVertexArray(*vao);
+		PreRecord(commands, camera);
+
+		commands.DrawElements(type, (unsigned int)vao->GetIndexCount(), 0, vao->GetIndexType());
 	}
 
 	void Drawable::SetDrawMode(DrawMode type)
@@ -17,4 +60,9 @@ namespace lol
 		this->type = type;
 	}
 
+	void Drawable::SetFallbackShader(const std::shared_ptr<Shader>& shader)
+	{
+		fallbackShader = shader;
+	}
+
 }
\ No newline at end of file
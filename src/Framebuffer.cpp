@@ -0,0 +1,217 @@
+#include <lol/Framebuffer.hpp>
+
+#include <algorithm>
+
+#include <glad/glad.h>
+
+#include <lol/Texture.hpp>
+#include <lol/util/DeletionQueue.hpp>
+
+namespace lol
+{
+	Renderbuffer::Renderbuffer(unsigned int width, unsigned int height, TextureFormat format, unsigned int samples) :
+		id(0), size(0), format(format), samples(samples)
+	{
+		glGenRenderbuffers(1, &id);
+		Resize(width, height);
+	}
+
+	Renderbuffer::~Renderbuffer()
+	{
+		DeletionQueue::Get().Release(ObjectType::Renderbuffer, id);
+	}
+
+	void Renderbuffer::Resize(unsigned int width, unsigned int height)
+	{
+		if (size.x == width && size.y == height)
+			return;
+
+		size = glm::uvec2(width, height);
+
+		glBindRenderbuffer(GL_RENDERBUFFER, id);
+		if (samples > 0)
+			glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, NATIVE(format), width, height);
+		else
+			glRenderbufferStorage(GL_RENDERBUFFER, NATIVE(format), width, height);
+	}
+
+	void Renderbuffer::Bind()
+	{
+		glBindRenderbuffer(GL_RENDERBUFFER, id);
+	}
+
+	void Renderbuffer::Unbind()
+	{
+		glBindRenderbuffer(GL_RENDERBUFFER, 0);
+	}
+
+
+	Framebuffer::Framebuffer(unsigned int width, unsigned int height) :
+		id(0), size(width, height)
+	{
+		glGenFramebuffers(1, &id);
+	}
+
+	Framebuffer::~Framebuffer()
+	{
+		DeletionQueue::Get().Release(ObjectType::Framebuffer, id);
+	}
+
+	void Framebuffer::Attach(FramebufferAttachment attachment, const std::shared_ptr<Texture2D>& texture)
+	{
+		texture->Resize(size.x, size.y);
+
+		Slot& slot = GetSlot(attachment);
+		slot.texture = texture;
+		slot.renderbuffer = nullptr;
+
+		glBindFramebuffer(GL_FRAMEBUFFER, id);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, NATIVE(attachment), GL_RENDERBUFFER, 0);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, NATIVE(attachment), GL_TEXTURE_2D, texture->id, 0);
+		UpdateDrawBuffers();
+	}
+
+	void Framebuffer::Attach(FramebufferAttachment attachment, const std::shared_ptr<Renderbuffer>& renderbuffer)
+	{
+		renderbuffer->Resize(size.x, size.y);
+
+		Slot& slot = GetSlot(attachment);
+		slot.texture = nullptr;
+		slot.renderbuffer = renderbuffer;
+
+		glBindFramebuffer(GL_FRAMEBUFFER, id);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, NATIVE(attachment), GL_TEXTURE_2D, 0, 0);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, NATIVE(attachment), GL_RENDERBUFFER, renderbuffer->id);
+		UpdateDrawBuffers();
+	}
+
+	void Framebuffer::Detach(FramebufferAttachment attachment)
+	{
+		auto it = std::find_if(slots.begin(), slots.end(), [attachment](const Slot& slot) { return slot.attachment == attachment; });
+		if (it == slots.end())
+			return;
+
+		glBindFramebuffer(GL_FRAMEBUFFER, id);
+		if (it->texture != nullptr)
+			glFramebufferTexture2D(GL_FRAMEBUFFER, NATIVE(attachment), GL_TEXTURE_2D, 0, 0);
+		else
+			glFramebufferRenderbuffer(GL_FRAMEBUFFER, NATIVE(attachment), GL_RENDERBUFFER, 0);
+
+		slots.erase(it);
+		UpdateDrawBuffers();
+	}
+
+	std::shared_ptr<Texture2D> Framebuffer::GetTexture(FramebufferAttachment attachment) const
+	{
+		for (const Slot& slot : slots)
+		{
+			if (slot.attachment == attachment)
+				return slot.texture;
+		}
+
+		return nullptr;
+	}
+
+	std::shared_ptr<Renderbuffer> Framebuffer::GetRenderbuffer(FramebufferAttachment attachment) const
+	{
+		for (const Slot& slot : slots)
+		{
+			if (slot.attachment == attachment)
+				return slot.renderbuffer;
+		}
+
+		return nullptr;
+	}
+
+	void Framebuffer::Resize(unsigned int width, unsigned int height)
+	{
+		if (size.x == width && size.y == height)
+			return;
+
+		size = glm::uvec2(width, height);
+
+		// Both keep their IDs when resized, so the attachments stay valid
+		for (Slot& slot : slots)
+		{
+			if (slot.texture != nullptr)
+				slot.texture->Resize(width, height);
+			else
+				slot.renderbuffer->Resize(width, height);
+		}
+	}
+
+	bool Framebuffer::IsComplete()
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, id);
+		return glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+	}
+
+	void Framebuffer::Bind()
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, id);
+		glViewport(0, 0, size.x, size.y);
+	}
+
+	void Framebuffer::Unbind()
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	}
+
+	void Framebuffer::ResolveTo(Framebuffer& target, FramebufferAttachment source, bool depth)
+	{
+		GLbitfield mask = GL_COLOR_BUFFER_BIT;
+		if (depth)
+			mask |= GL_DEPTH_BUFFER_BIT;
+
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, id);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, target.id);
+		glReadBuffer(NATIVE(source));
+
+		// Depth can only be copied without filtering, and resolving requires equal sizes anyways
+		GLenum filter = (depth || size == target.size) ? GL_NEAREST : GL_LINEAR;
+		glBlitFramebuffer(0, 0, size.x, size.y, 0, 0, target.size.x, target.size.y, mask, filter);
+	}
+
+	Framebuffer::Slot& Framebuffer::GetSlot(FramebufferAttachment attachment)
+	{
+		for (Slot& slot : slots)
+		{
+			if (slot.attachment == attachment)
+				return slot;
+		}
+
+		slots.push_back(Slot{ attachment, nullptr, nullptr });
+		return slots.back();
+	}
+
+	void Framebuffer::UpdateDrawBuffers()
+	{
+		// Fragment shader output i is written to draw buffer i, so every output goes to the
+		// attachment with the same index and the gaps between attachments are left empty
+		GLenum buffers[8];
+		GLsizei count = 0;
+		for (const Slot& slot : slots)
+		{
+			if (slot.attachment >= FramebufferAttachment::Color0 && slot.attachment <= FramebufferAttachment::Color7)
+				count = std::max(count, (GLsizei)(NATIVE(slot.attachment) - GL_COLOR_ATTACHMENT0 + 1));
+		}
+
+		std::fill(buffers, buffers + count, (GLenum)GL_NONE);
+		for (const Slot& slot : slots)
+		{
+			if (slot.attachment >= FramebufferAttachment::Color0 && slot.attachment <= FramebufferAttachment::Color7)
+				buffers[NATIVE(slot.attachment) - GL_COLOR_ATTACHMENT0] = NATIVE(slot.attachment);
+		}
+
+		if (count == 0)
+		{
+			glDrawBuffer(GL_NONE);
+			glReadBuffer(GL_NONE);
+		}
+		else
+		{
+			glDrawBuffers(count, buffers);
+			glReadBuffer(*std::find_if(buffers, buffers + count, [](GLenum buffer) { return buffer != GL_NONE; }));
+		}
+	}
+}
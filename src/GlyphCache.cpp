@@ -0,0 +1,258 @@
+#include <lol/GlyphCache.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include <lol/Texture.hpp>
+#include <lol/util/Exceptions.hpp>
+#include <lol/util/Profiler.hpp>
+
+namespace lol
+{
+	static const float infinity = 1e20f;
+
+	/**
+	 * Squared euclidean distance transform of one row or column, after Felzenszwalb and
+	 * Huttenlocher, "Distance Transforms of Sampled Functions". Works in place on `grid`.
+	 */
+	static void DistanceTransform1D(float* grid, size_t stride, size_t length, float* f, int* v, float* z)
+	{
+		v[0] = 0;
+		z[0] = -infinity;
+		z[1] = infinity;
+		f[0] = grid[0];
+
+		int k = 0;
+		for (int q = 1; q < (int)length; q++)
+		{
+			f[q] = grid[q * stride];
+
+			float s;
+			do
+			{
+				int r = v[k];
+				s = (f[q] - f[r] + (float)(q * q - r * r)) / (float)(q - r) / 2.0f;
+			} while (s <= z[k] && --k > -1);
+
+			k++;
+			v[k] = q;
+			z[k] = s;
+			z[k + 1] = infinity;
+		}
+
+		k = 0;
+		for (int q = 0; q < (int)length; q++)
+		{
+			while (z[k + 1] < (float)q)
+				k++;
+
+			int r = v[k];
+			grid[q * stride] = f[r] + (float)((q - r) * (q - r));
+		}
+	}
+
+	static void DistanceTransform(std::vector<float>& grid, unsigned int width, unsigned int height, float* f, int* v, float* z)
+	{
+		for (unsigned int x = 0; x < width; x++)
+			DistanceTransform1D(grid.data() + x, width, height, f, v, z);
+
+		for (unsigned int y = 0; y < height; y++)
+			DistanceTransform1D(grid.data() + (size_t)y * width, 1, width, f, v, z);
+	}
+
+	GlyphCache::GlyphCache(const std::shared_ptr<GlyphSource>& source, unsigned int pageSize, unsigned int maxPages, unsigned int spread) :
+		source(source), pageSize(pageSize), maxPages(std::max(maxPages, 1u)), spread(std::max(spread, 1u)), frame(1)
+	{
+	}
+
+	GlyphCache::~GlyphCache()
+	{
+	}
+
+	const Glyph& GlyphCache::GetGlyph(uint32_t codepoint)
+	{
+		auto it = glyphs.find(codepoint);
+		if (it != glyphs.end())
+		{
+			if (!it->second.empty)
+				Touch(it->second.page);
+
+			return it->second;
+		}
+
+		LOL_PROFILE_SCOPE("GlyphCache::GetGlyph");
+
+		rasterized.width = 0;
+		rasterized.height = 0;
+		rasterized.coverage.clear();
+		rasterized.bearing = glm::vec2(0.0f);
+		rasterized.advance = 0.0f;
+
+		// Missing glyphs are cached as empty ones, so the source isn't asked again
+		Glyph glyph{ 0, Rect{ 0.0f, 0.0f, 0.0f, 0.0f }, Rect{ 0.0f, 0.0f, 0.0f, 0.0f }, 0.0f, true };
+		if (!source->Rasterize(codepoint, rasterized))
+			return glyphs.insert({ codepoint, glyph }).first->second;
+
+		glyph.advance = rasterized.advance;
+		if (rasterized.width == 0 || rasterized.height == 0)
+			return glyphs.insert({ codepoint, glyph }).first->second;
+
+		GenerateDistanceField(rasterized);
+		unsigned int fieldWidth = rasterized.width + 2 * spread;
+		unsigned int fieldHeight = rasterized.height + 2 * spread;
+
+		// One pixel of space between the fields keeps linear filtering from picking up the neighbours
+		glm::uvec2 position;
+		unsigned int pageIndex = Allocate(fieldWidth + 2, fieldHeight + 2, position);
+		position += glm::uvec2(1);
+
+		Page& page = pages[pageIndex];
+		page.texture->Update(position.x, position.y, fieldWidth, fieldHeight, field.data(), PixelFormat::R, PixelType::UByte);
+		page.codepoints.push_back(codepoint);
+		page.dirty = true;
+
+		glyph.page = pageIndex;
+		glyph.bounds = Rect{ rasterized.bearing.x - spread, rasterized.bearing.y - rasterized.height - spread, (float)fieldWidth, (float)fieldHeight };
+		glyph.uv = Rect{ (float)position.x / pageSize, (float)position.y / pageSize, (float)fieldWidth / pageSize, (float)fieldHeight / pageSize };
+		glyph.empty = false;
+
+		return glyphs.insert({ codepoint, glyph }).first->second;
+	}
+
+	void GlyphCache::Touch(unsigned int page)
+	{
+		pages[page].lastUsed = frame;
+	}
+
+	void GlyphCache::NewFrame()
+	{
+		frame++;
+	}
+
+	void GlyphCache::UpdateMipmaps()
+	{
+		for (Page& page : pages)
+		{
+			if (!page.dirty)
+				continue;
+
+			page.texture->GenerateMipmaps();
+			page.dirty = false;
+		}
+	}
+
+	unsigned int GlyphCache::Allocate(unsigned int width, unsigned int height, glm::uvec2& position)
+	{
+		if (width > pageSize || height > pageSize)
+			throw ImageTooLargeException(width, height);
+
+		for (size_t i = 0; i < pages.size(); i++)
+		{
+			if (pages[i].packer.Insert(width, height, position))
+			{
+				Touch((unsigned int)i);
+				return (unsigned int)i;
+			}
+		}
+
+		// All pages are full, reuse the least recently used one unless it's needed in this frame
+		size_t oldest = pages.size();
+		if (pages.size() >= maxPages)
+		{
+			for (size_t i = 0; i < pages.size(); i++)
+			{
+				if (pages[i].lastUsed < frame && (oldest == pages.size() || pages[i].lastUsed < pages[oldest].lastUsed))
+					oldest = i;
+			}
+		}
+
+		if (oldest == pages.size())
+		{
+			pages.push_back(Page{
+				std::make_shared<Texture2D>(pageSize, pageSize, TextureFormat::R8, PixelFormat::R, PixelType::UByte),
+				SkylinePacker(pageSize, pageSize),
+				{},
+				0,
+				frame,
+				false
+			});
+
+			pages.back().texture->SetWrap(TextureWrap::ClampToEdge, TextureWrap::ClampToEdge);
+		}
+
+		Page& page = pages[oldest];
+		Clear(page);
+		page.packer.Insert(width, height, position);
+		Touch((unsigned int)oldest);
+
+		return (unsigned int)oldest;
+	}
+
+	void GlyphCache::Clear(Page& page)
+	{
+		for (uint32_t codepoint : page.codepoints)
+			glyphs.erase(codepoint);
+
+		page.codepoints.clear();
+		page.packer.Clear();
+		page.generation++;
+
+		// The gaps between the new glyphs have to be empty again for filtering and mipmaps
+		std::vector<uint8_t> zeros((size_t)pageSize * pageSize, 0);
+		page.texture->Update(0, 0, pageSize, pageSize, zeros.data(), PixelFormat::R, PixelType::UByte);
+		page.dirty = true;
+	}
+
+	void GlyphCache::GenerateDistanceField(const GlyphBitmap& bitmap)
+	{
+		unsigned int width = bitmap.width + 2 * spread;
+		unsigned int height = bitmap.height + 2 * spread;
+		size_t size = (size_t)width * height;
+
+		// Partially covered pixels start with the distance to where the outline crosses them,
+		// which keeps the anti-aliasing of the source in the field
+		outer.assign(size, infinity);
+		inner.assign(size, 0.0f);
+		for (unsigned int y = 0; y < bitmap.height; y++)
+		{
+			for (unsigned int x = 0; x < bitmap.width; x++)
+			{
+				float alpha = bitmap.coverage[(size_t)y * bitmap.width + x] / 255.0f;
+				if (alpha == 0.0f)
+					continue;
+
+				size_t index = (size_t)(y + spread) * width + (x + spread);
+				if (alpha == 1.0f)
+				{
+					outer[index] = 0.0f;
+					inner[index] = infinity;
+				}
+				else
+				{
+					float distance = 0.5f - alpha;
+					outer[index] = distance > 0.0f ? distance * distance : 0.0f;
+					inner[index] = distance < 0.0f ? distance * distance : 0.0f;
+				}
+			}
+		}
+
+		size_t length = std::max(width, height);
+		scratch.resize(length * 2 + 1);
+		hull.resize(length);
+		DistanceTransform(outer, width, height, scratch.data(), hull.data(), scratch.data() + length);
+		DistanceTransform(inner, width, height, scratch.data(), hull.data(), scratch.data() + length);
+
+		// The coverage rows are top to bottom, textures want them bottom to top
+		field.resize(size);
+		for (unsigned int y = 0; y < height; y++)
+		{
+			const size_t row = (size_t)(height - 1 - y) * width;
+			for (unsigned int x = 0; x < width; x++)
+			{
+				float distance = std::sqrt(inner[row + x]) - std::sqrt(outer[row + x]);
+				float value = 0.5f + distance / (2.0f * spread);
+				field[(size_t)y * width + x] = (uint8_t)(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+			}
+		}
+	}
+}
@@ -0,0 +1,185 @@
+#include <lol/util/Hash.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#include <lol/Image.hpp>
+#include <lol/util/JobSystem.hpp>
+
+namespace lol
+{
+	// Blobs larger than this are hashed in parallel, one chunk per task
+	static constexpr size_t ChunkSize = 4 * 1024 * 1024;
+
+	static inline uint64_t RotateLeft(uint64_t x, int r)
+	{
+		return (x << r) | (x >> (64 - r));
+	}
+
+	static inline uint64_t FinalMix(uint64_t k)
+	{
+		k ^= k >> 33;
+		k *= 0xff51afd7ed558ccdull;
+		k ^= k >> 33;
+		k *= 0xc4ceb9fe1a85ec53ull;
+		k ^= k >> 33;
+
+		return k;
+	}
+
+	std::string Hash128::ToString() const
+	{
+		static const char digits[] = "0123456789abcdef";
+
+		std::string result(32, '0');
+		for (int i = 0; i < 16; i++)
+		{
+			result[15 - i] = digits[(high >> (i * 4)) & 0xF];
+			result[31 - i] = digits[(low >> (i * 4)) & 0xF];
+		}
+
+		return result;
+	}
+
+	Hash128 HashBytes(const void* data, size_t size, uint64_t seed)
+	{
+		const uint8_t* bytes = (const uint8_t*)data;
+		const size_t blocks = size / 16;
+
+		const uint64_t c1 = 0x87c37b91114253d5ull;
+		const uint64_t c2 = 0x4cf5ad432745937full;
+
+		uint64_t h1 = seed;
+		uint64_t h2 = seed;
+
+		for (size_t i = 0; i < blocks; i++)
+		{
+			uint64_t k1, k2;
+			std::memcpy(&k1, bytes + i * 16, sizeof(uint64_t));
+			std::memcpy(&k2, bytes + i * 16 + 8, sizeof(uint64_t));
+
+			k1 *= c1; k1 = RotateLeft(k1, 31); k1 *= c2; h1 ^= k1;
+			h1 = RotateLeft(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+
+			k2 *= c2; k2 = RotateLeft(k2, 33); k2 *= c1; h2 ^= k2;
+			h2 = RotateLeft(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+		}
+
+		const uint8_t* tail = bytes + blocks * 16;
+		uint64_t k1 = 0;
+		uint64_t k2 = 0;
+
+		switch (size & 15)
+		{
+		case 15: k2 ^= (uint64_t)tail[14] << 48;	[[fallthrough]];
+		case 14: k2 ^= (uint64_t)tail[13] << 40;	[[fallthrough]];
+		case 13: k2 ^= (uint64_t)tail[12] << 32;	[[fallthrough]];
+		case 12: k2 ^= (uint64_t)tail[11] << 24;	[[fallthrough]];
+		case 11: k2 ^= (uint64_t)tail[10] << 16;	[[fallthrough]];
+		case 10: k2 ^= (uint64_t)tail[9] << 8;		[[fallthrough]];
+		case 9:
+			k2 ^= (uint64_t)tail[8];
+			k2 *= c2; k2 = RotateLeft(k2, 33); k2 *= c1; h2 ^= k2;
+			[[fallthrough]];
+
+		case 8: k1 ^= (uint64_t)tail[7] << 56;		[[fallthrough]];
+		case 7: k1 ^= (uint64_t)tail[6] << 48;		[[fallthrough]];
+		case 6: k1 ^= (uint64_t)tail[5] << 40;		[[fallthrough]];
+		case 5: k1 ^= (uint64_t)tail[4] << 32;		[[fallthrough]];
+		case 4: k1 ^= (uint64_t)tail[3] << 24;		[[fallthrough]];
+		case 3: k1 ^= (uint64_t)tail[2] << 16;		[[fallthrough]];
+		case 2: k1 ^= (uint64_t)tail[1] << 8;		[[fallthrough]];
+		case 1:
+			k1 ^= (uint64_t)tail[0];
+			k1 *= c1; k1 = RotateLeft(k1, 31); k1 *= c2; h1 ^= k1;
+			break;
+
+		default:
+			break;
+		}
+
+		h1 ^= size;
+		h2 ^= size;
+
+		h1 += h2;
+		h2 += h1;
+
+		h1 = FinalMix(h1);
+		h2 = FinalMix(h2);
+
+		h1 += h2;
+		h2 += h1;
+
+		return Hash128{ h1, h2 };
+	}
+
+	Hash128 HashCombine(const Hash128& first, const Hash128& second)
+	{
+		Hash128 hashes[2] = { first, second };
+		return HashBytes(hashes, sizeof(hashes));
+	}
+
+	Hash128 HashContent(const void* data, size_t size)
+	{
+		if (size <= ChunkSize)
+			return HashBytes(data, size);
+
+		const uint8_t* bytes = (const uint8_t*)data;
+		size_t chunks = (size + ChunkSize - 1) / ChunkSize;
+		std::vector<Hash128> hashes(chunks);
+
+		JobSystem::Default().ParallelFor(0, chunks, [&](size_t first, size_t last)
+		{
+			for (size_t chunk = first; chunk < last; chunk++)
+			{
+				size_t offset = chunk * ChunkSize;
+				hashes[chunk] = HashBytes(bytes + offset, std::min(ChunkSize, size - offset));
+			}
+		}, 1);
+
+		// The total size is used as the seed so that the chunking scheme can't collide with small blobs
+		return HashBytes(hashes.data(), hashes.size() * sizeof(Hash128), size);
+	}
+
+	Hash128 HashContent(const Image& image)
+	{
+		struct
+		{
+			uint32_t width, height;
+			uint32_t format, type;
+		} meta = {
+			image.GetDimensions().x, image.GetDimensions().y,
+			NATIVE(image.GetPixelFormat()), NATIVE(image.GetPixelType())
+		};
+
+		Hash128 metaHash = HashBytes(&meta, sizeof(meta));
+		if (image.GetPixels() == nullptr)
+			return metaHash;
+
+		size_t rowSize = image.GetDimensions().x * SizeOf(image.GetPixelFormat(), image.GetPixelType());
+		if (image.IsTightlyPacked())
+			return HashCombine(metaHash, HashContent(image.GetPixels(), rowSize * image.GetDimensions().y));
+
+		// Strip the padding at the end of each row, so the hash matches that of a tightly packed Image
+		std::vector<uint8_t> packed(rowSize * image.GetDimensions().y);
+		for (unsigned int y = 0; y < image.GetDimensions().y; y++)
+			std::memcpy(packed.data() + y * rowSize, image.GetRow(y), rowSize);
+
+		return HashCombine(metaHash, HashContent(packed.data(), packed.size()));
+	}
+
+	Hash128 HashContent(const std::vector<float>& vertices)
+	{
+		return HashContent(vertices.data(), vertices.size() * sizeof(float));
+	}
+
+	Hash128 HashContent(const std::vector<unsigned int>& indices)
+	{
+		return HashContent(indices.data(), indices.size() * sizeof(unsigned int));
+	}
+
+	Hash128 HashContent(const std::string& text)
+	{
+		return HashContent(text.data(), text.size());
+	}
+}
@@ -0,0 +1,185 @@
+#include <lol/util/HeadlessContext.hpp>
+
+#include <cstring>
+
+#include <glad/glad.h>
+
+#if defined(LOL_HEADLESS_OSMESA)
+	#include <GL/osmesa.h>
+#else
+	#include <EGL/egl.h>
+	#include <EGL/eglext.h>
+#endif
+
+#include <lol/util/DeletionQueue.hpp>
+#include <lol/util/Exceptions.hpp>
+
+namespace lol
+{
+#if defined(LOL_HEADLESS_OSMESA)
+
+	HeadlessContext::HeadlessContext(int major, int minor) :
+		display(nullptr), surface(nullptr), context(nullptr)
+	{
+		const int attributes[] = {
+			OSMESA_FORMAT, OSMESA_RGBA,
+			OSMESA_DEPTH_BITS, 24,
+			OSMESA_STENCIL_BITS, 8,
+			OSMESA_PROFILE, OSMESA_CORE_PROFILE,
+			OSMESA_CONTEXT_MAJOR_VERSION, major,
+			OSMESA_CONTEXT_MINOR_VERSION, minor,
+			0
+		};
+
+		context = OSMesaCreateContextAttribs(attributes, nullptr);
+		if (context == nullptr)
+			throw HeadlessContextException("OSMesaCreateContextAttribs() failed.");
+
+		// A single pixel is enough, everything is rendered into Framebuffers
+		colorBuffer.resize(4);
+		MakeCurrent();
+
+		if (!gladLoadGLLoader((GLADloadproc)OSMesaGetProcAddress))
+		{
+			OSMesaDestroyContext((OSMesaContext)context);
+			throw HeadlessContextException("The OpenGL functions couldn't be loaded.");
+		}
+	}
+
+	HeadlessContext::~HeadlessContext()
+	{
+		// Objects released while the context was alive still have to be deleted in it
+		DeletionQueue::Get().Flush();
+		OSMesaDestroyContext((OSMesaContext)context);
+	}
+
+	void HeadlessContext::MakeCurrent()
+	{
+		OSMesaMakeCurrent((OSMesaContext)context, colorBuffer.data(), GL_UNSIGNED_BYTE, 1, 1);
+	}
+
+#else
+
+	static bool HasEGLExtension(EGLDisplay display, const char* name)
+	{
+		const char* extensions = eglQueryString(display, EGL_EXTENSIONS);
+		if (extensions == nullptr)
+			return false;
+
+		// Make sure not to match a prefix of a longer name
+		size_t length = std::strlen(name);
+		for (const char* found = std::strstr(extensions, name); found != nullptr; found = std::strstr(found + length, name))
+		{
+			if ((found == extensions || found[-1] == ' ') && (found[length] == ' ' || found[length] == '\0'))
+				return true;
+		}
+
+		return false;
+	}
+
+	static EGLDisplay GetDisplay()
+	{
+		// Mesa's surfaceless platform doesn't need X11, Wayland or a GPU device node
+		if (HasEGLExtension(EGL_NO_DISPLAY, "EGL_MESA_platform_surfaceless"))
+		{
+			PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+			if (getPlatformDisplay != nullptr)
+			{
+				EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+				if (display != EGL_NO_DISPLAY && eglInitialize(display, nullptr, nullptr))
+					return display;
+			}
+		}
+
+		EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+		if (display != EGL_NO_DISPLAY && eglInitialize(display, nullptr, nullptr))
+			return display;
+
+		return EGL_NO_DISPLAY;
+	}
+
+	HeadlessContext::HeadlessContext(int major, int minor) :
+		display(EGL_NO_DISPLAY), surface(EGL_NO_SURFACE), context(EGL_NO_CONTEXT)
+	{
+		display = GetDisplay();
+		if (display == EGL_NO_DISPLAY)
+			throw HeadlessContextException("No EGL display is available.");
+
+		bool surfaceless = HasEGLExtension(display, "EGL_KHR_surfaceless_context");
+
+		const EGLint configAttributes[] = {
+			EGL_SURFACE_TYPE, surfaceless ? 0 : EGL_PBUFFER_BIT,
+			EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+			EGL_NONE
+		};
+
+		EGLConfig config;
+		EGLint configCount = 0;
+		if (!eglChooseConfig(display, configAttributes, &config, 1, &configCount) || configCount == 0)
+		{
+			eglTerminate(display);
+			throw HeadlessContextException("No EGL config supports desktop OpenGL.");
+		}
+
+		// Without surfaceless contexts there has to be some surface to make the context current with
+		if (!surfaceless)
+		{
+			const EGLint surfaceAttributes[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+			surface = eglCreatePbufferSurface(display, config, surfaceAttributes);
+			if (surface == EGL_NO_SURFACE)
+			{
+				eglTerminate(display);
+				throw HeadlessContextException("The pbuffer surface couldn't be created.");
+			}
+		}
+
+		const EGLint contextAttributes[] = {
+			EGL_CONTEXT_MAJOR_VERSION, major,
+			EGL_CONTEXT_MINOR_VERSION, minor,
+			EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+			EGL_NONE
+		};
+
+		eglBindAPI(EGL_OPENGL_API);
+		context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes);
+		if (context == EGL_NO_CONTEXT)
+		{
+			eglTerminate(display);
+			throw HeadlessContextException("OpenGL " + std::to_string(major) + "." + std::to_string(minor) + " core profile isn't supported.");
+		}
+
+		MakeCurrent();
+
+		if (!gladLoadGLLoader((GLADloadproc)eglGetProcAddress))
+		{
+			eglTerminate(display);
+			throw HeadlessContextException("The OpenGL functions couldn't be loaded.");
+		}
+	}
+
+	HeadlessContext::~HeadlessContext()
+	{
+		// Objects released while the context was alive still have to be deleted in it
+		DeletionQueue::Get().Flush();
+		eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+		eglDestroyContext(display, context);
+
+		if (surface != EGL_NO_SURFACE)
+			eglDestroySurface(display, surface);
+
+		eglTerminate(display);
+	}
+
+	void HeadlessContext::MakeCurrent()
+	{
+		eglMakeCurrent(display, surface, surface, context);
+	}
+
+#endif
+
+	std::string HeadlessContext::GetRenderer() const
+	{
+		const GLubyte* renderer = glGetString(GL_RENDERER);
+		return (renderer != nullptr) ? (const char*)renderer : "";
+	}
+}
@@ -1,45 +1,92 @@
 #include <lol/Image.hpp>
 
+#include <algorithm>
+#include <assert.h>
+
 #define STB_IMAGE_IMPLEMENTATION
 #include <stbi_image.h>
 
 namespace lol
 {
+	// Blocks are always aligned to at least a cache line, so rows can be processed with SIMD
+	static constexpr size_t BlockAlignment = 64;
+
 	Image::Image() :
-		size(0), pixels(nullptr), format(PixelFormat::RGB), type(PixelType::UByte)
+		size(0), pixels(nullptr), pitch(0), alignment(0), allocator(nullptr), format(PixelFormat::RGB), type(PixelType::UByte)
 	{
 	}
 
-	Image::Image(unsigned int width, unsigned int height, PixelFormat pixelFormat, PixelType pixelType) :
-		size(width, height), format(pixelFormat), type(pixelType)
+	Image::Image(unsigned int width, unsigned int height, PixelFormat pixelFormat, PixelType pixelType, size_t rowAlignment, ImageAllocator* allocator) :
+		size(width, height), allocator(allocator), format(pixelFormat), type(pixelType)
 	{
-		pixels = new uint8_t[width * height * SizeOf(pixelType)];
+		assert(rowAlignment > 0 && (rowAlignment & (rowAlignment - 1)) == 0 && "lol::Image::Image() rowAlignment must be a power of two");
+
+		if (this->allocator == nullptr)
+			this->allocator = &ImageAllocator::Default();
+
+		// The pitch needs to stay a multiple of the pixel size so OpenGL can step through the rows
+		size_t pixelSize = SizeOf(pixelFormat, pixelType);
+		pitch = (width * pixelSize + rowAlignment - 1) & ~(rowAlignment - 1);
+		while (pitch % pixelSize != 0)
+			pitch += rowAlignment;
+
+		alignment = std::max(rowAlignment, BlockAlignment);
+		pixels = (uint8_t*)this->allocator->Allocate(std::max<size_t>(pitch * height, 1), alignment);
 	}
 
-	Image::Image(const std::string& filepath)
+	Image::Image(const std::string& filepath) :
+		allocator(nullptr)
 	{
-		int width, height, channels;
+		int width = 0, height = 0, channels = 0;
 		pixels = stbi_load(filepath.c_str(), &width, &height, &channels, 0);
 
-		size = glm::uvec2(width, height);
-		type = PixelType::UByte;
-		switch (channels)
-		{
-		case 1:	format = PixelFormat::R;	break;
-		case 2:	format = PixelFormat::RG;	break;
-		case 3:	format = PixelFormat::RGB;	break;
-		case 4:	format = PixelFormat::RGBA; break;
-		default:
-			format = PixelFormat::RGB;
-			break;
-		}
+		FromLoaded(width, height, channels);
 	}
 
-	Image::Image(unsigned char* buffer, size_t len)
+	Image::Image(unsigned char* buffer, size_t len) :
+		allocator(nullptr)
 	{
-		int width, height, channels;
+		int width = 0, height = 0, channels = 0;
 		pixels = stbi_load_from_memory(buffer, len, &width, &height, &channels, 0);
 
+		FromLoaded(width, height, channels);
+	}
+
+	Image::Image(Image&& other) noexcept :
+		size(other.size), pixels(other.pixels), pitch(other.pitch), alignment(other.alignment), allocator(other.allocator), format(other.format), type(other.type)
+	{
+		other.pixels = nullptr;
+		other.Release();
+	}
+
+	Image& Image::operator=(Image&& other) noexcept
+	{
+		if (this == &other)
+			return *this;
+
+		Release();
+
+		size = other.size;
+		pixels = other.pixels;
+		pitch = other.pitch;
+		alignment = other.alignment;
+		allocator = other.allocator;
+		format = other.format;
+		type = other.type;
+
+		other.pixels = nullptr;
+		other.Release();
+
+		return *this;
+	}
+
+	Image::~Image()
+	{
+		Release();
+	}
+
+	void Image::FromLoaded(int width, int height, int channels)
+	{
 		size = glm::uvec2(width, height);
 		type = PixelType::UByte;
 		switch (channels)
@@ -52,11 +99,26 @@ namespace lol
 			format = PixelFormat::RGB;
 			break;
 		}
+
+		// stb_image always returns tightly packed rows
+		pitch = width * SizeOf(format, type);
+		alignment = 0;
 	}
 
-	Image::~Image()
+	void Image::Release()
 	{
-		if(pixels != nullptr)
-			stbi_image_free(pixels);
+		if (pixels != nullptr)
+		{
+			if (allocator != nullptr)
+				allocator->Deallocate(pixels, std::max<size_t>(pitch * size.y, 1), alignment);
+			else
+				stbi_image_free(pixels);
+		}
+
+		size = glm::uvec2(0);
+		pixels = nullptr;
+		pitch = 0;
+		alignment = 0;
+		allocator = nullptr;
 	}
-}
\ No newline at end of file
+}
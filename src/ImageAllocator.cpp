@@ -0,0 +1,96 @@
+#include <lol/util/ImageAllocator.hpp>
+
+#include <new>
+
+namespace lol
+{
+	/**
+	 * @brief Allocates directly from the heap
+	 */
+	class HeapAllocator : public ImageAllocator
+	{
+	public:
+		void* Allocate(size_t size, size_t alignment) override
+		{
+			return ::operator new(size, std::align_val_t(alignment));
+		}
+
+		void Deallocate(void* block, size_t size, size_t alignment) override
+		{
+			::operator delete(block, size, std::align_val_t(alignment));
+		}
+	};
+
+	ImageAllocator& ImageAllocator::Default()
+	{
+		static HeapAllocator allocator;
+		return allocator;
+	}
+
+
+	ImagePool::ImagePool(size_t capacity) :
+		capacity(capacity), cachedBytes(0)
+	{
+	}
+
+	ImagePool::~ImagePool()
+	{
+		Trim();
+	}
+
+	void* ImagePool::Allocate(size_t size, size_t alignment)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+
+			auto it = freeBlocks.find({ size, alignment });
+			if (it != freeBlocks.end() && !it->second.empty())
+			{
+				void* block = it->second.back();
+				it->second.pop_back();
+				cachedBytes -= size;
+
+				return block;
+			}
+		}
+
+		return Default().Allocate(size, alignment);
+	}
+
+	void ImagePool::Deallocate(void* block, size_t size, size_t alignment)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+
+			if (cachedBytes + size <= capacity)
+			{
+				freeBlocks[{ size, alignment }].push_back(block);
+				cachedBytes += size;
+
+				return;
+			}
+		}
+
+		Default().Deallocate(block, size, alignment);
+	}
+
+	void ImagePool::Trim()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		for (auto& [key, blocks] : freeBlocks)
+		{
+			for (void* block : blocks)
+				Default().Deallocate(block, key.first, key.second);
+		}
+
+		freeBlocks.clear();
+		cachedBytes = 0;
+	}
+
+	size_t ImagePool::GetCachedBytes()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return cachedBytes;
+	}
+}
@@ -0,0 +1,250 @@
+#include <lol/util/JobSystem.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace lol
+{
+	// Which job system and queue the current thread works for, if any
+	static thread_local const JobSystem* currentSystem = nullptr;
+	static thread_local size_t currentQueue = 0;
+
+	JobGroup::JobGroup() :
+		pending(0)
+	{
+	}
+
+	JobSystem::JobSystem(unsigned int workers) :
+		queuedJobs(0), stopping(false)
+	{
+		for (unsigned int i = 0; i < workers + 1; i++)
+			queues.push_back(std::make_unique<Queue>());
+
+		for (unsigned int i = 0; i < workers; i++)
+			threads.emplace_back(&JobSystem::WorkerLoop, this, i);
+	}
+
+	JobSystem::~JobSystem()
+	{
+		stopping = true;
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+		}
+		wakeup.notify_all();
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		// Without workers nobody might have picked up the last jobs
+		Job job;
+		while (TryPop(queues.size() - 1, job))
+			Execute(job);
+	}
+
+	JobSystem& JobSystem::Default()
+	{
+		static JobSystem system;
+		return system;
+	}
+
+	unsigned int JobSystem::DefaultWorkerCount()
+	{
+		unsigned int hardwareThreads = std::thread::hardware_concurrency();
+		return (hardwareThreads > 2) ? hardwareThreads - 1 : 1;
+	}
+
+	void JobSystem::Run(JobGroup& group, std::function<void()> job)
+	{
+		group.pending.fetch_add(1, std::memory_order_relaxed);
+
+		Queue& queue = *queues[QueueOfThisThread()];
+		{
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			queue.jobs.push_back(Job{ std::move(job), &group });
+		}
+
+		queuedJobs.fetch_add(1, std::memory_order_release);
+
+		// Taking the lock makes sure a worker can't miss the notification between checking for jobs and going to sleep
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+		}
+		wakeup.notify_one();
+	}
+
+	void JobSystem::Wait(JobGroup& group)
+	{
+		size_t queue = QueueOfThisThread();
+		while (!group.IsDone())
+		{
+			Job job;
+			if (TryPop(queue, job))
+				Execute(job);
+			else
+				std::this_thread::yield();
+		}
+
+		std::exception_ptr error;
+		{
+			std::lock_guard<std::mutex> lock(group.errorMutex);
+			error = std::exchange(group.error, nullptr);
+		}
+
+		if (error)
+			std::rethrow_exception(error);
+	}
+
+	void JobSystem::ParallelFor(size_t begin, size_t end, const std::function<void(size_t, size_t)>& body, size_t grain)
+	{
+		if (begin >= end)
+			return;
+
+		if (grain == 0)
+			grain = std::max<size_t>(1, (end - begin) / (8 * (threads.size() + 1)));
+
+		JobGroup group;
+		std::function<void(size_t, size_t)> split = [&](size_t first, size_t last)
+		{
+			// Hand out the upper half and keep working on the lower one, until the range is small enough
+			while (last - first > grain)
+			{
+				size_t middle = first + (last - first) / 2;
+				Run(group, [&split, middle, last]() { split(middle, last); });
+				last = middle;
+			}
+
+			body(first, last);
+		};
+
+		std::exception_ptr error;
+		try
+		{
+			split(begin, end);
+		}
+		catch (...)
+		{
+			error = std::current_exception();
+		}
+
+		// Jobs still reference split and body, so always wait for them
+		Wait(group);
+
+		if (error)
+			std::rethrow_exception(error);
+	}
+
+	void JobSystem::RunOnMainThread(std::function<void()> job)
+	{
+		std::lock_guard<std::mutex> lock(mainThreadMutex);
+		mainThreadJobs.push_back(std::move(job));
+	}
+
+	size_t JobSystem::ProcessMainThreadJobs(std::chrono::microseconds budget)
+	{
+		auto start = std::chrono::steady_clock::now();
+		size_t processed = 0;
+
+		do
+		{
+			std::function<void()> job;
+			{
+				std::lock_guard<std::mutex> lock(mainThreadMutex);
+				if (mainThreadJobs.empty())
+					break;
+
+				job = std::move(mainThreadJobs.front());
+				mainThreadJobs.pop_front();
+			}
+
+			job();
+			processed++;
+		} while (std::chrono::steady_clock::now() - start < budget);
+
+		return processed;
+	}
+
+	bool JobSystem::TryPop(size_t queue, Job& job)
+	{
+		if (queuedJobs.load(std::memory_order_acquire) == 0)
+			return false;
+
+		// Workers take their newest job first
+		if (queue < threads.size())
+		{
+			Queue& own = *queues[queue];
+			std::lock_guard<std::mutex> lock(own.mutex);
+			if (!own.jobs.empty())
+			{
+				job = std::move(own.jobs.back());
+				own.jobs.pop_back();
+				queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+
+				return true;
+			}
+		}
+
+		// Everyone else steals the oldest job, starting with the next queue so thieves spread out
+		for (size_t i = 1; i <= queues.size(); i++)
+		{
+			Queue& victim = *queues[(queue + i) % queues.size()];
+			std::lock_guard<std::mutex> lock(victim.mutex);
+			if (!victim.jobs.empty())
+			{
+				job = std::move(victim.jobs.front());
+				victim.jobs.pop_front();
+				queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void JobSystem::Execute(Job& job)
+	{
+		JobGroup* group = job.group;
+		try
+		{
+			job.function();
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(group->errorMutex);
+			if (!group->error)
+				group->error = std::current_exception();
+		}
+
+		job.function = nullptr;
+
+		// The group may be destroyed as soon as this hits 0, so it must be the last access
+		group->pending.fetch_sub(1, std::memory_order_release);
+	}
+
+	size_t JobSystem::QueueOfThisThread() const
+	{
+		return (currentSystem == this) ? currentQueue : queues.size() - 1;
+	}
+
+	void JobSystem::WorkerLoop(size_t index)
+	{
+		currentSystem = this;
+		currentQueue = index;
+
+		while (true)
+		{
+			Job job;
+			if (TryPop(index, job))
+			{
+				Execute(job);
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(sleepMutex);
+			wakeup.wait(lock, [this]() { return queuedJobs.load(std::memory_order_acquire) > 0 || stopping; });
+
+			if (stopping && queuedJobs.load(std::memory_order_acquire) == 0)
+				return;
+		}
+	}
+}
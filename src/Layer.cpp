@@ -14,4 +14,9 @@ namespace lol
 	{
 
 	}
+
+	void Layer::DependsOn(Layer& layer)
+	{
+		dependencies.push_back(&layer);
+	}
 }
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include <lol/LayerStack.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <unordered_map>
+
+#include <lol/util/JobSystem.hpp>
+#include <lol/util/Profiler.hpp>
+
+namespace lol
+{
+	LayerStack::LayerStack()
+	{
+	}
+
+	LayerStack::~LayerStack()
+	{
+		Clear();
+	}
+
+	void LayerStack::PushLayer(const std::shared_ptr<Layer>& layer)
+	{
+		layers.push_back(layer);
+		layer->OnAttach();
+	}
+
+	void LayerStack::RemoveLayer(const std::shared_ptr<Layer>& layer)
+	{
+		auto it = std::find(layers.begin(), layers.end(), layer);
+		if (it == layers.end())
+			return;
+
+		layer->OnDetach();
+		layers.erase(it);
+	}
+
+	void LayerStack::Clear()
+	{
+		while (!layers.empty())
+		{
+			layers.back()->OnDetach();
+			layers.pop_back();
+		}
+	}
+
+	void LayerStack::Update(float timestep)
+	{
+		LOL_PROFILE_SCOPE("LayerStack::Update");
+
+		// Dependencies can change at any time, but there are only ever a handful of layers
+		Schedule();
+
+		for (const std::vector<Layer*>& wave : waves)
+		{
+			JobGroup group;
+			for (size_t i = 1; i < wave.size(); i++)
+				JobSystem::Default().Run(group, [layer = wave[i], timestep]() { layer->OnUpdate(timestep); });
+
+			// The calling thread takes the first layer of each wave itself
+			std::exception_ptr error;
+			try
+			{
+				wave[0]->OnUpdate(timestep);
+			}
+			catch (...)
+			{
+				error = std::current_exception();
+			}
+
+			try
+			{
+				JobSystem::Default().Wait(group);
+			}
+			catch (...)
+			{
+				if (!error)
+					error = std::current_exception();
+			}
+
+			if (error)
+				std::rethrow_exception(error);
+		}
+	}
+
+	void LayerStack::Render(CameraBase& camera, float interpolation)
+	{
+		LOL_PROFILE_SCOPE("LayerStack::Render");
+
+		for (const std::shared_ptr<Layer>& layer : layers)
+			layer->OnRender(camera, interpolation);
+	}
+
+	void LayerStack::Schedule()
+	{
+		for (std::vector<Layer*>& wave : waves)
+			wave.clear();
+
+		std::unordered_map<Layer*, size_t> waveOf;
+		size_t scheduled = 0;
+
+		// Keep sweeping over the layers, placing every layer whose dependencies are placed already
+		while (scheduled < layers.size())
+		{
+			size_t before = scheduled;
+			for (const std::shared_ptr<Layer>& layer : layers)
+			{
+				if (waveOf.count(layer.get()))
+					continue;
+
+				size_t wave = 0;
+				bool ready = true;
+				for (Layer* dependency : layer->GetDependencies())
+				{
+					bool inStack = std::any_of(layers.begin(), layers.end(), [dependency](const std::shared_ptr<Layer>& other) { return other.get() == dependency; });
+					if (!inStack)
+						continue;
+
+					auto it = waveOf.find(dependency);
+					if (it == waveOf.end())
+					{
+						ready = false;
+						break;
+					}
+
+					wave = std::max(wave, it->second + 1);
+				}
+
+				if (!ready)
+					continue;
+
+				if (wave >= waves.size())
+					waves.resize(wave + 1);
+
+				waves[wave].push_back(layer.get());
+				waveOf[layer.get()] = wave;
+				scheduled++;
+			}
+
+			if (scheduled == before)
+			{
+				assert(false && "lol::LayerStack contains a dependency cycle");
+
+				// Update the remaining layers one after another, in stack order
+				for (const std::shared_ptr<Layer>& layer : layers)
+				{
+					if (waveOf.count(layer.get()))
+						continue;
+
+					waves.push_back({ layer.get() });
+					waveOf[layer.get()] = waves.size() - 1;
+					scheduled++;
+				}
+			}
+		}
+
+		waves.erase(std::remove_if(waves.begin(), waves.end(), [](const std::vector<Layer*>& wave) { return wave.empty(); }), waves.end());
+	}
+}
@@ -0,0 +1,106 @@
+#include <lol/util/MappedFile.hpp>
+
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+#include <lol/util/Exceptions.hpp>
+#include <lol/util/Profiler.hpp>
+
+namespace lol
+{
+#ifdef _WIN32
+	MappedFile::MappedFile(const std::string& path) :
+		data(nullptr), size(0), file(INVALID_HANDLE_VALUE), mapping(nullptr)
+	{
+		LOL_PROFILE_SCOPE("MappedFile::MappedFile");
+
+		file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			throw FileMappingException(path);
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file, &fileSize))
+		{
+			CloseHandle(file);
+			throw FileMappingException(path);
+		}
+
+		size = (size_t)fileSize.QuadPart;
+		if (size == 0)
+			return;
+
+		mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping != nullptr)
+			data = (const uint8_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+		if (data == nullptr)
+		{
+			if (mapping != nullptr)
+				CloseHandle(mapping);
+
+			CloseHandle(file);
+			throw FileMappingException(path);
+		}
+	}
+
+	MappedFile::~MappedFile()
+	{
+		if (data != nullptr)
+			UnmapViewOfFile(data);
+
+		if (mapping != nullptr)
+			CloseHandle(mapping);
+
+		CloseHandle(file);
+	}
+#else
+	MappedFile::MappedFile(const std::string& path) :
+		data(nullptr), size(0)
+	{
+		LOL_PROFILE_SCOPE("MappedFile::MappedFile");
+
+		int file = open(path.c_str(), O_RDONLY);
+		if (file < 0)
+			throw FileMappingException(path);
+
+		struct stat status;
+		if (fstat(file, &status) != 0)
+		{
+			close(file);
+			throw FileMappingException(path);
+		}
+
+		size = (size_t)status.st_size;
+		if (size == 0)
+		{
+			close(file);
+			return;
+		}
+
+		// The mapping keeps its own reference to the file
+		void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+		close(file);
+
+		if (mapped == MAP_FAILED)
+			throw FileMappingException(path);
+
+		// The file is read front to back by the upload, let the kernel read ahead
+		madvise(mapped, size, MADV_SEQUENTIAL);
+		madvise(mapped, size, MADV_WILLNEED);
+		data = (const uint8_t*)mapped;
+	}
+
+	MappedFile::~MappedFile()
+	{
+		if (data != nullptr)
+			munmap((void*)data, size);
+	}
+#endif
+}
@@ -0,0 +1,259 @@
+#include <lol/Mesh.hpp>
+
+#include <algorithm>
+#include <assert.h>
+#include <cstring>
+#include <fstream>
+
+#include <lol/VertexArrayObject.hpp>
+#include <lol/util/Exceptions.hpp>
+#include <lol/util/MappedFile.hpp>
+#include <lol/util/Profiler.hpp>
+#include <lol/util/RenderStats.hpp>
+
+namespace lol
+{
+	static uint64_t Align(uint64_t offset)
+	{
+		return (offset + MeshFileAlignment - 1) & ~(uint64_t)(MeshFileAlignment - 1);
+	}
+
+	/**
+	 * Check that a section lies within the file, without overflowing
+	 */
+	static bool Contains(size_t fileSize, uint64_t offset, uint64_t bytes)
+	{
+		return offset <= fileSize && bytes <= fileSize - offset;
+	}
+
+	static bool IsAttributeType(Type type)
+	{
+		switch (type)
+		{
+		case Type::Byte: case Type::UByte: case Type::Short: case Type::UShort: case Type::Int: case Type::UInt:
+		case Type::Half: case Type::Float: case Type::Double: case Type::Fixed: case Type::Int2101010: case Type::UInt2101010:
+			return true;
+
+		default:
+			return false;
+		}
+	}
+
+	/**
+	 * Get the largest of `count` indices, they might not be aligned within the file
+	 */
+	template<typename T>
+	static uint32_t MaxIndex(const uint8_t* data, uint32_t count)
+	{
+		uint32_t largest = 0;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			T index;
+			std::memcpy(&index, data + (size_t)i * sizeof(T), sizeof(T));
+			largest = std::max<uint32_t>(largest, index);
+		}
+
+		return largest;
+	}
+
+	Mesh::Mesh(const std::string& path, Usage usage) :
+		bounds{}, indexType(Type::UInt)
+	{
+		LOL_PROFILE_SCOPE("Mesh::Mesh");
+
+		MappedFile file(path);
+		const uint8_t* data = file.GetData();
+
+		MeshFileHeader header;
+		if (file.GetSize() < sizeof(header))
+			throw MeshFileException(path, "The file is too small for the header.");
+
+		std::memcpy(&header, data, sizeof(header));
+		if (header.magic != MeshFileMagic)
+			throw MeshFileException(path, "The file isn't a mesh file.");
+
+		if (header.version != MeshFileVersion)
+			throw MeshFileException(path, "Version " + std::to_string(header.version) + " isn't supported.");
+
+		indexType = (Type)header.indexType;
+		if (indexType != Type::UShort && indexType != Type::UInt)
+			throw MeshFileException(path, "The index type isn't supported.");
+
+		uint64_t tables = sizeof(header) + (uint64_t)header.attributeCount * sizeof(MeshFileAttribute) + (uint64_t)header.submeshCount * sizeof(MeshFileSubmesh);
+		if (header.attributeCount == 0 || !Contains(file.GetSize(), 0, tables))
+			throw MeshFileException(path, "The attribute and submesh tables are out of bounds.");
+
+		if (header.vertexBytes != (uint64_t)header.vertexCount * header.vertexStride || !Contains(file.GetSize(), header.vertexOffset, header.vertexBytes))
+			throw MeshFileException(path, "The vertices are out of bounds.");
+
+		if (header.indexBytes != (uint64_t)header.indexCount * SizeOf(indexType) || !Contains(file.GetSize(), header.indexOffset, header.indexBytes))
+			throw MeshFileException(path, "The indices are out of bounds.");
+
+		// Rebuild the layout and make sure it matches the one the vertices were written with
+		const uint8_t* cursor = data + sizeof(header);
+		std::vector<VertexAttribute> attributes;
+		std::vector<uint32_t> offsets;
+		for (uint32_t i = 0; i < header.attributeCount; i++, cursor += sizeof(MeshFileAttribute))
+		{
+			MeshFileAttribute attribute;
+			std::memcpy(&attribute, cursor, sizeof(attribute));
+			if (!IsAttributeType((Type)attribute.type))
+				throw MeshFileException(path, "Attribute " + std::to_string(i) + " has an unknown type.");
+
+			if (attribute.components < 1 || attribute.components > 4 || (IsPacked((Type)attribute.type) && attribute.components != 4))
+				throw MeshFileException(path, "Attribute " + std::to_string(i) + " has an invalid number of components.");
+
+			attributes.push_back(VertexAttribute((Type)attribute.type, attribute.components, attribute.normalized != 0));
+			offsets.push_back(attribute.offset);
+			dequantization.push_back(Dequantization{
+				glm::vec4(attribute.dequantizeScale[0], attribute.dequantizeScale[1], attribute.dequantizeScale[2], attribute.dequantizeScale[3]),
+				glm::vec4(attribute.dequantizeOffset[0], attribute.dequantizeOffset[1], attribute.dequantizeOffset[2], attribute.dequantizeOffset[3])
+			});
+		}
+
+		BufferLayout layout(attributes);
+		if ((uint32_t)layout.GetStride() != header.vertexStride)
+			throw MeshFileException(path, "The vertex stride doesn't match the attributes.");
+
+		for (size_t i = 0; i < offsets.size(); i++)
+		{
+			if (layout.GetLayout()[i].offset != offsets[i])
+				throw MeshFileException(path, "The attribute offsets don't match the attributes.");
+		}
+
+		submeshes.resize(header.submeshCount);
+		if (!submeshes.empty())
+			std::memcpy(submeshes.data(), cursor, submeshes.size() * sizeof(MeshFileSubmesh));
+
+		// Indices past the vertices would make the GPU read outside of the vertex buffer
+		const uint8_t* indices = data + header.indexOffset;
+		auto maxIndex = [&](uint32_t first, uint32_t count)
+		{
+			size_t size = SizeOf(indexType);
+			return indexType == Type::UShort ? MaxIndex<uint16_t>(indices + first * size, count) : MaxIndex<uint32_t>(indices + first * size, count);
+		};
+
+		if (header.indexCount > 0 && maxIndex(0, header.indexCount) >= header.vertexCount)
+			throw MeshFileException(path, "An index refers to a vertex that doesn't exist.");
+
+		for (const Submesh& submesh : submeshes)
+		{
+			if (submesh.firstIndex > header.indexCount || submesh.indexCount > header.indexCount - submesh.firstIndex)
+				throw MeshFileException(path, "A submesh is out of bounds.");
+
+			if (submesh.baseVertex < 0)
+				throw MeshFileException(path, "A submesh has a negative base vertex.");
+
+			if (submesh.indexCount > 0 && (uint64_t)maxIndex(submesh.firstIndex, submesh.indexCount) + (uint64_t)submesh.baseVertex >= header.vertexCount)
+				throw MeshFileException(path, "A submesh refers to a vertex that doesn't exist.");
+		}
+
+		bounds = header.bounds;
+
+		// Bind the VAO first, creating the element buffer attaches it to whichever VAO is bound
+		vao = std::make_shared<VertexArray>();
+		vao->Bind();
+
+		std::shared_ptr<VertexBuffer> vertexBuffer = std::make_shared<VertexBuffer>(data + header.vertexOffset, (size_t)header.vertexBytes, usage);
+		vertexBuffer->SetLayout(layout);
+		std::shared_ptr<ElementBuffer> elementBuffer = std::make_shared<ElementBuffer>(data + header.indexOffset, (size_t)header.indexCount, indexType, usage);
+
+		vao->SetVertexBuffer(vertexBuffer);
+		vao->SetElementBuffer(elementBuffer);
+		glBindVertexArray(0);
+	}
+
+	void Mesh::Write(const MeshData& mesh, const std::string& path)
+	{
+		LOL_PROFILE_SCOPE("Mesh::Write");
+
+		const BufferLayout& layout = mesh.vertices.layout;
+		Type indexType = mesh.vertices.vertexCount <= 0xFFFF ? Type::UShort : Type::UInt;
+
+		MeshFileHeader header{};
+		header.magic = MeshFileMagic;
+		header.version = MeshFileVersion;
+		header.attributeCount = (uint32_t)layout.GetLayout().size();
+		header.submeshCount = (uint32_t)mesh.submeshes.size();
+		header.indexType = NATIVE(indexType);
+		header.vertexStride = (uint32_t)layout.GetStride();
+		header.vertexCount = (uint32_t)mesh.vertices.vertexCount;
+		header.indexCount = (uint32_t)mesh.indices.size();
+		header.vertexOffset = Align(sizeof(header) + header.attributeCount * sizeof(MeshFileAttribute) + header.submeshCount * sizeof(MeshFileSubmesh));
+		header.vertexBytes = mesh.vertices.data.size();
+		header.indexOffset = Align(header.vertexOffset + header.vertexBytes);
+		header.indexBytes = mesh.indices.size() * SizeOf(indexType);
+		header.bounds = mesh.bounds;
+
+		assert(header.vertexBytes == (uint64_t)header.vertexCount * header.vertexStride && "lol::Mesh::Write() vertices don't match their layout");
+
+		std::ofstream file(path, std::ios::binary);
+		if (!file.is_open())
+			throw MeshFileException(path, "The file can't be opened for writing.");
+
+		file.write((const char*)&header, sizeof(header));
+
+		for (size_t i = 0; i < layout.GetLayout().size(); i++)
+		{
+			const VertexAttribute& vertexAttribute = layout.GetLayout()[i];
+			Dequantization parameters = i < mesh.vertices.dequantization.size() ? mesh.vertices.dequantization[i] : Dequantization{ glm::vec4(1.0f), glm::vec4(0.0f) };
+
+			MeshFileAttribute attribute{};
+			attribute.type = NATIVE(vertexAttribute.type);
+			attribute.components = (uint32_t)vertexAttribute.size;
+			attribute.normalized = vertexAttribute.normalized ? 1 : 0;
+			attribute.offset = (uint32_t)vertexAttribute.offset;
+			for (int c = 0; c < 4; c++)
+			{
+				attribute.dequantizeScale[c] = parameters.scale[c];
+				attribute.dequantizeOffset[c] = parameters.offset[c];
+			}
+
+			file.write((const char*)&attribute, sizeof(attribute));
+		}
+
+		if (!mesh.submeshes.empty())
+			file.write((const char*)mesh.submeshes.data(), mesh.submeshes.size() * sizeof(MeshFileSubmesh));
+
+		auto pad = [&file](uint64_t offset)
+		{
+			static const char zeros[MeshFileAlignment] = {};
+			file.write(zeros, offset - (uint64_t)file.tellp());
+		};
+
+		pad(header.vertexOffset);
+		file.write((const char*)mesh.vertices.data.data(), mesh.vertices.data.size());
+
+		pad(header.indexOffset);
+		if (indexType == Type::UShort)
+		{
+			std::vector<uint16_t> indices(mesh.indices.begin(), mesh.indices.end());
+			file.write((const char*)indices.data(), indices.size() * sizeof(uint16_t));
+		}
+		else
+		{
+			file.write((const char*)mesh.indices.data(), mesh.indices.size() * sizeof(uint32_t));
+		}
+
+		if (!file.good())
+			throw MeshFileException(path, "Writing the file failed.");
+	}
+
+	void Mesh::Draw(size_t submesh, DrawMode mode)
+	{
+		LOL_PROFILE_GPU_SCOPE("Mesh::Draw");
+
+		assert(submesh < submeshes.size() && "lol::Mesh::Draw() submesh index out of range");
+
+		const Submesh& range = submeshes[submesh];
+		vao->Bind();
+		glDrawElementsBaseVertex(NATIVE(mode), range.indexCount, NATIVE(indexType), (const void*)(range.firstIndex * SizeOf(indexType)), range.baseVertex);
+		RenderStats::Get().AddDraw(mode, range.indexCount);
+	}
+
+	void Mesh::Draw(DrawMode mode)
+	{
+		for (size_t i = 0; i < submeshes.size(); i++)
+			Draw(i, mode);
+	}
+}
@@ -0,0 +1,232 @@
+#include <lol/util/MeshConverter.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+#include <lol/util/Exceptions.hpp>
+#include <lol/util/Profiler.hpp>
+
+namespace lol
+{
+	/**
+	 * A corner of a face, indices into the positions, texture coordinates and normals
+	 */
+	struct ObjCorner
+	{
+		int position, uv, normal;
+
+		inline bool operator==(const ObjCorner& other) const { return position == other.position && uv == other.uv && normal == other.normal; }
+	};
+
+	struct ObjCornerHash
+	{
+		size_t operator()(const ObjCorner& corner) const
+		{
+			uint64_t hash = (uint64_t)(uint32_t)corner.position * 0x9E3779B97F4A7C15ull;
+			hash ^= (uint64_t)(uint32_t)corner.uv * 0xC2B2AE3D27D4EB4Full + (hash << 6) + (hash >> 2);
+			hash ^= (uint64_t)(uint32_t)corner.normal * 0x165667B19E3779F9ull + (hash << 6) + (hash >> 2);
+			return (size_t)hash;
+		}
+	};
+
+	/**
+	 * Turn a 1-based or negative (relative) OBJ index into a 0-based one, -1 if it is missing
+	 */
+	static int ResolveIndex(const std::string& token, size_t count, const std::string& name, size_t line)
+	{
+		if (token.empty())
+			return -1;
+
+		long index = std::strtol(token.c_str(), nullptr, 10);
+		if (index < 0)
+			index += (long)count;
+		else
+			index -= 1;
+
+		if (index < 0 || index >= (long)count)
+			throw MeshFileException(name, "Line " + std::to_string(line) + " refers to a vertex that doesn't exist.");
+
+		return (int)index;
+	}
+
+	/**
+	 * Grow a box given as minimum and maximum by a point
+	 */
+	static void Extend(glm::vec3& lower, glm::vec3& upper, const glm::vec3& point)
+	{
+		lower = glm::vec3(std::min(lower.x, point.x), std::min(lower.y, point.y), std::min(lower.z, point.z));
+		upper = glm::vec3(std::max(upper.x, point.x), std::max(upper.y, point.y), std::max(upper.z, point.z));
+	}
+
+	static BoundingBox ToBoundingBox(const glm::vec3& lower, const glm::vec3& upper)
+	{
+		if (lower.x > upper.x)
+			return BoundingBox{};
+
+		return BoundingBox{ lower.x, lower.y, lower.z, upper.x - lower.x, upper.y - lower.y, upper.z - lower.z };
+	}
+
+	MeshData ConvertOBJ(std::istream& stream, const MeshConvertOptions& options, const std::string& name)
+	{
+		LOL_PROFILE_SCOPE("ConvertOBJ");
+
+		std::vector<glm::vec3> positions, normals;
+		std::vector<glm::vec2> uvs;
+
+		// Triangulated corners, and where each submesh starts in them
+		std::vector<ObjCorner> corners;
+		std::vector<size_t> submeshStarts{ 0 };
+
+		std::string text, keyword;
+		std::vector<ObjCorner> face;
+		size_t line = 0;
+		while (std::getline(stream, text))
+		{
+			line++;
+
+			std::istringstream tokens(text);
+			if (!(tokens >> keyword) || keyword[0] == '#')
+				continue;
+
+			if (keyword == "v")
+			{
+				glm::vec3 position(0.0f);
+				tokens >> position.x >> position.y >> position.z;
+				positions.push_back(position);
+			}
+			else if (keyword == "vn")
+			{
+				glm::vec3 normal(0.0f);
+				tokens >> normal.x >> normal.y >> normal.z;
+				normals.push_back(normal);
+			}
+			else if (keyword == "vt")
+			{
+				glm::vec2 uv(0.0f);
+				tokens >> uv.x >> uv.y;
+				uvs.push_back(uv);
+			}
+			else if (keyword == "f")
+			{
+				face.clear();
+
+				std::string token;
+				while (tokens >> token)
+				{
+					// v, v/t, v//n or v/t/n
+					size_t first = token.find('/');
+					size_t second = first == std::string::npos ? std::string::npos : token.find('/', first + 1);
+
+					ObjCorner corner;
+					corner.position = ResolveIndex(token.substr(0, first), positions.size(), name, line);
+					corner.uv = first == std::string::npos ? -1 : ResolveIndex(token.substr(first + 1, second - first - 1), uvs.size(), name, line);
+					corner.normal = second == std::string::npos ? -1 : ResolveIndex(token.substr(second + 1), normals.size(), name, line);
+
+					if (corner.position < 0)
+						throw MeshFileException(name, "Line " + std::to_string(line) + " has a corner without a position.");
+
+					face.push_back(corner);
+				}
+
+				if (face.size() < 3)
+					throw MeshFileException(name, "Line " + std::to_string(line) + " has a face with fewer than 3 corners.");
+
+				for (size_t i = 2; i < face.size(); i++)
+				{
+					corners.push_back(face[0]);
+					corners.push_back(face[i - 1]);
+					corners.push_back(face[i]);
+				}
+			}
+			else if (keyword == "o" || keyword == "g" || keyword == "usemtl")
+			{
+				if (submeshStarts.back() != corners.size())
+					submeshStarts.push_back(corners.size());
+			}
+		}
+
+		submeshStarts.push_back(corners.size());
+
+		bool hasNormals = std::any_of(corners.begin(), corners.end(), [](const ObjCorner& corner) { return corner.normal >= 0; });
+		bool hasUVs = std::any_of(corners.begin(), corners.end(), [](const ObjCorner& corner) { return corner.uv >= 0; });
+
+		// Give every distinct corner one vertex
+		std::vector<float> vertices;
+		std::vector<uint32_t> indices;
+		std::unordered_map<ObjCorner, uint32_t, ObjCornerHash> vertexOf;
+		indices.reserve(corners.size());
+		for (const ObjCorner& corner : corners)
+		{
+			auto it = vertexOf.find(corner);
+			if (it != vertexOf.end())
+			{
+				indices.push_back(it->second);
+				continue;
+			}
+
+			uint32_t index = (uint32_t)vertexOf.size();
+			vertexOf.emplace(corner, index);
+			indices.push_back(index);
+
+			const glm::vec3& position = positions[corner.position];
+			vertices.insert(vertices.end(), { position.x, position.y, position.z });
+
+			if (hasNormals)
+			{
+				glm::vec3 normal = corner.normal >= 0 ? normals[corner.normal] : glm::vec3(0.0f);
+				vertices.insert(vertices.end(), { normal.x, normal.y, normal.z });
+			}
+
+			if (hasUVs)
+			{
+				glm::vec2 uv = corner.uv >= 0 ? uvs[corner.uv] : glm::vec2(0.0f);
+				vertices.insert(vertices.end(), { uv.x, uv.y });
+			}
+		}
+
+		std::vector<QuantizedAttribute> attributes{ { 3, options.quantize ? AttributeEncoding::Bounds16 : AttributeEncoding::Float } };
+		if (hasNormals)
+			attributes.push_back({ 3, options.quantize ? AttributeEncoding::Octahedral16 : AttributeEncoding::Float });
+
+		if (hasUVs)
+			attributes.push_back({ 2, options.quantize ? AttributeEncoding::Half : AttributeEncoding::Float });
+
+		MeshData mesh{ VertexQuantizer(attributes).Quantize(vertices), std::move(indices), {}, BoundingBox{} };
+
+		// Bounds of the original positions, the quantized ones lie within them
+		glm::vec3 meshLower(INFINITY), meshUpper(-INFINITY);
+		for (size_t s = 0; s + 1 < submeshStarts.size(); s++)
+		{
+			if (submeshStarts[s] == submeshStarts[s + 1])
+				continue;
+
+			Submesh submesh{ (uint32_t)submeshStarts[s], (uint32_t)(submeshStarts[s + 1] - submeshStarts[s]), 0, 0, BoundingBox{} };
+
+			glm::vec3 lower(INFINITY), upper(-INFINITY);
+			for (size_t i = submeshStarts[s]; i < submeshStarts[s + 1]; i++)
+				Extend(lower, upper, positions[corners[i].position]);
+
+			submesh.bounds = ToBoundingBox(lower, upper);
+			mesh.submeshes.push_back(submesh);
+
+			Extend(meshLower, meshUpper, lower);
+			Extend(meshLower, meshUpper, upper);
+		}
+
+		mesh.bounds = ToBoundingBox(meshLower, meshUpper);
+		return mesh;
+	}
+
+	MeshData ConvertOBJ(const std::string& path, const MeshConvertOptions& options)
+	{
+		std::ifstream file(path);
+		if (!file.is_open())
+			throw MeshFileException(path, "The file can't be opened.");
+
+		return ConvertOBJ(file, options, path);
+	}
+}
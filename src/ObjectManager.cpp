@@ -2,34 +2,112 @@
 
 namespace lol
 {
+    ObjectManager::ObjectManager()
+    {
+        // Make sure the job system is created first, so it is still alive when the destructor waits for it
+        JobSystem::Default();
+    }
+
+    ObjectManager::~ObjectManager()
+    {
+        // Running decodes use the members, they have to finish in the body, before any member is destroyed
+        JobSystem::Default().Wait(decodeJobs);
+    }
+
     std::shared_ptr<void> ObjectManager::Get(unsigned int id)
     {
-        auto it = objects.find(id);
+        std::shared_ptr<void> object = TryGet(id);
 
-        if(it == objects.end())
+        if(object == nullptr)
             throw ObjectNotFoundException(id);
 
+        return object;
+    }
+
+    std::shared_ptr<void> ObjectManager::TryGet(unsigned int id)
+    {
+        Shard& shard = GetShard(id);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+        auto it = shard.objects.find(id);
+        if(it == shard.objects.end())
+            return nullptr;
+
         return it->second;
     }
 
     void ObjectManager::Delete(unsigned int id)
     {
-        objects.erase(id);
+        Shard& shard = GetShard(id);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+        shard.objects.erase(id);
     }
 
     void ObjectManager::ClearUnused()
     {
-        for(std::map<unsigned int, std::shared_ptr<void>>::iterator it = objects.begin(); it != objects.end();)
+        for(Shard& shard : shards)
         {
-            if (it->second.unique())
-                it = objects.erase(it);
-            else
-                it++;
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+            for(auto it = shard.objects.begin(); it != shard.objects.end();)
+            {
+                if (it->second.use_count() == 1)
+                    it = shard.objects.erase(it);
+                else
+                    it++;
+            }
         }
     }
 
 	void ObjectManager::Clear()
     {
-        objects.clear();
+        for(Shard& shard : shards)
+        {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            shard.objects.clear();
+        }
+    }
+
+    size_t ObjectManager::ProcessUploads(std::chrono::microseconds budget)
+    {
+        auto start = std::chrono::steady_clock::now();
+        size_t processed = 0;
+
+        do
+        {
+            std::function<void()> upload;
+            {
+                std::lock_guard<std::mutex> lock(uploadMutex);
+                if(uploads.empty())
+                    break;
+
+                upload = std::move(uploads.front());
+                uploads.pop_front();
+            }
+
+            upload();
+            processed++;
+        } while(std::chrono::steady_clock::now() - start < budget);
+
+        return processed;
+    }
+
+    size_t ObjectManager::GetPendingLoadCount()
+    {
+        std::lock_guard<std::mutex> lock(loadMutex);
+        return loads.size();
+    }
+
+    void ObjectManager::QueueUpload(std::function<void()>&& upload)
+    {
+        std::lock_guard<std::mutex> lock(uploadMutex);
+        uploads.push_back(std::move(upload));
+    }
+
+    void ObjectManager::FinishLoad(unsigned int id)
+    {
+        std::lock_guard<std::mutex> lock(loadMutex);
+        loads.erase(id);
     }
 }
\ No newline at end of file
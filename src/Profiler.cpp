@@ -0,0 +1,239 @@
+#include <lol/util/Profiler.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+#include <glad/glad.h>
+
+namespace lol
+{
+	static thread_local void* currentThreadEvents = nullptr;
+
+	static void WriteEscaped(std::ostream& stream, const char* text)
+	{
+		for (; *text != '\0'; text++)
+		{
+			if (*text == '"' || *text == '\\')
+				stream << '\\';
+
+			stream << *text;
+		}
+	}
+
+	static void WriteEvent(std::ostream& stream, bool& first, const char* name, uint64_t start, uint64_t end, uint32_t thread)
+	{
+		if (!first)
+			stream << ",\n";
+		first = false;
+
+		stream << "{\"name\":\"";
+		WriteEscaped(stream, name);
+		stream << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread
+			<< ",\"ts\":" << (start / 1000) << '.' << (start % 1000 / 100)
+			<< ",\"dur\":" << ((end - start) / 1000) << '.' << ((end - start) % 1000 / 100) << "}";
+	}
+
+	static void WriteThreadName(std::ostream& stream, bool& first, const std::string& name, uint32_t thread)
+	{
+		if (!first)
+			stream << ",\n";
+		first = false;
+
+		stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread << ",\"args\":{\"name\":\"";
+		WriteEscaped(stream, name.c_str());
+		stream << "\"}}";
+	}
+
+	Profiler::Profiler() :
+		capturing(false), gpuFrame(0), gpuEventsWritten(0), frameStart(0)
+	{
+	}
+
+	Profiler& Profiler::Get()
+	{
+		static Profiler profiler;
+		return profiler;
+	}
+
+	void Profiler::BeginCapture()
+	{
+		capturing.store(true, std::memory_order_relaxed);
+	}
+
+	void Profiler::EndCapture()
+	{
+		capturing.store(false, std::memory_order_relaxed);
+	}
+
+	void Profiler::NewFrame()
+	{
+		uint64_t now = Now();
+		if (IsCapturing() && frameStart != 0)
+			RecordCpu("Frame", frameStart, now);
+
+		frameStart = now;
+
+		// The queries of the frame before the last one are reused now, read whatever results are ready
+		gpuFrame ^= 1;
+		GpuFrame& frame = gpuFrames[gpuFrame];
+		for (size_t i = 0; i < frame.used; i++)
+		{
+			// The end query finishes last, if it's available the start query is too
+			GLint available = GL_FALSE;
+			glGetQueryObjectiv(frame.queries[i * 2 + 1], GL_QUERY_RESULT_AVAILABLE, &available);
+			if (!available)
+				continue;
+
+			GLuint64 start, end;
+			glGetQueryObjectui64v(frame.queries[i * 2], GL_QUERY_RESULT, &start);
+			glGetQueryObjectui64v(frame.queries[i * 2 + 1], GL_QUERY_RESULT, &end);
+
+			RecordGpu(frame.names[i], start + frame.clockOffset, end + frame.clockOffset);
+		}
+
+		frame.used = 0;
+	}
+
+	void Profiler::SetThreadName(const std::string& name)
+	{
+		ThreadEvents& thread = GetThreadEvents();
+
+		std::lock_guard<std::mutex> lock(threadsMutex);
+		thread.name = name;
+	}
+
+	void Profiler::ExportChromeTrace(std::ostream& stream)
+	{
+		bool first = true;
+		stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+		{
+			std::lock_guard<std::mutex> lock(threadsMutex);
+			for (const std::unique_ptr<ThreadEvents>& thread : threads)
+			{
+				WriteThreadName(stream, first, thread->name, thread->id);
+
+				uint64_t written = thread->written.load(std::memory_order_acquire);
+				uint64_t count = std::min<uint64_t>(written, EventsPerThread);
+				for (uint64_t i = written - count; i < written; i++)
+				{
+					const Event& event = thread->events[i % EventsPerThread];
+					WriteEvent(stream, first, event.name, event.start, event.end, thread->id);
+				}
+			}
+		}
+
+		WriteThreadName(stream, first, "GPU", 0);
+
+		uint64_t count = std::min<uint64_t>(gpuEventsWritten, EventsPerThread);
+		for (uint64_t i = gpuEventsWritten - count; i < gpuEventsWritten; i++)
+		{
+			const Event& event = gpuEvents[i % EventsPerThread];
+			WriteEvent(stream, first, event.name, event.start, event.end, 0);
+		}
+
+		stream << "\n]}\n";
+	}
+
+	bool Profiler::ExportChromeTrace(const std::string& path)
+	{
+		std::ofstream file(path);
+		if (!file)
+			return false;
+
+		ExportChromeTrace(file);
+		return (bool)file;
+	}
+
+	void Profiler::ReleaseGpuResources()
+	{
+		for (GpuFrame& frame : gpuFrames)
+		{
+			if (!frame.queries.empty())
+				glDeleteQueries((GLsizei)frame.queries.size(), frame.queries.data());
+
+			frame.queries.clear();
+			frame.names.clear();
+			frame.used = 0;
+		}
+	}
+
+	uint64_t Profiler::Now()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	void Profiler::RecordCpu(const char* name, uint64_t start, uint64_t end)
+	{
+		ThreadEvents& thread = GetThreadEvents();
+
+		// Only this thread writes to its events, publishing the new count makes the event visible to ExportChromeTrace()
+		uint64_t written = thread.written.load(std::memory_order_relaxed);
+		thread.events[written % EventsPerThread] = Event{ name, start, end };
+		thread.written.store(written + 1, std::memory_order_release);
+	}
+
+	int Profiler::BeginGpu(const char* name)
+	{
+		if (!IsCapturing())
+			return -1;
+
+		GpuFrame& frame = gpuFrames[gpuFrame];
+		if (frame.used >= GpuScopesPerFrame)
+			return -1;
+
+		if (frame.used == 0)
+		{
+			// Doesn't wait for the GPU, it returns the time at which all previous commands reached it
+			GLint64 gpuNow;
+			glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+			frame.clockOffset = (int64_t)Now() - gpuNow;
+		}
+
+		if (frame.queries.size() < (frame.used + 1) * 2)
+		{
+			frame.queries.resize((frame.used + 1) * 2);
+			frame.names.resize(frame.used + 1);
+			glGenQueries(2, frame.queries.data() + frame.used * 2);
+		}
+
+		glQueryCounter(frame.queries[frame.used * 2], GL_TIMESTAMP);
+		frame.names[frame.used] = name;
+
+		return (int)frame.used++;
+	}
+
+	void Profiler::EndGpu(int handle)
+	{
+		glQueryCounter(gpuFrames[gpuFrame].queries[handle * 2 + 1], GL_TIMESTAMP);
+	}
+
+	Profiler::ThreadEvents& Profiler::GetThreadEvents()
+	{
+		if (currentThreadEvents != nullptr)
+			return *(ThreadEvents*)currentThreadEvents;
+
+		std::lock_guard<std::mutex> lock(threadsMutex);
+
+		std::unique_ptr<ThreadEvents> thread = std::make_unique<ThreadEvents>();
+		thread->id = (uint32_t)threads.size() + 1;
+		thread->name = "Thread " + std::to_string(thread->id);
+		thread->events.resize(EventsPerThread);
+		thread->written = 0;
+
+		currentThreadEvents = thread.get();
+		threads.push_back(std::move(thread));
+
+		return *threads.back();
+	}
+
+	void Profiler::RecordGpu(const char* name, uint64_t start, uint64_t end)
+	{
+		if (gpuEvents.empty())
+			gpuEvents.resize(EventsPerThread);
+
+		gpuEvents[gpuEventsWritten % EventsPerThread] = Event{ name, start, end };
+		gpuEventsWritten++;
+	}
+}
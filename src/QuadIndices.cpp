@@ -0,0 +1,42 @@
+#include <lol/util/QuadIndices.hpp>
+
+#include <memory>
+#include <vector>
+
+#include <lol/VertexArrayObject.hpp>
+#include <lol/buffers/ElementBuffer.hpp>
+
+namespace lol
+{
+	QuadIndices::QuadIndices() :
+		capacity(0)
+	{
+	}
+
+	void QuadIndices::Reserve(VertexArray& vao, size_t quadCount)
+	{
+		if (quadCount <= capacity)
+			return;
+
+		size_t grown = std::max<size_t>(capacity, 1);
+		while (grown < quadCount)
+			grown *= 2;
+
+		std::vector<unsigned int> indices(grown * 6);
+		for (size_t i = 0; i < grown; i++)
+		{
+			unsigned int vertex = (unsigned int)(i * 4);
+			indices[i * 6 + 0] = vertex + 0;
+			indices[i * 6 + 1] = vertex + 1;
+			indices[i * 6 + 2] = vertex + 2;
+			indices[i * 6 + 3] = vertex + 0;
+			indices[i * 6 + 4] = vertex + 2;
+			indices[i * 6 + 5] = vertex + 3;
+		}
+
+		// Creating the buffer binds it, which would change the element buffer of whatever VAO is bound
+		vao.Bind();
+		vao.SetElementBuffer(std::make_shared<ElementBuffer>(indices));
+		capacity = grown;
+	}
+}
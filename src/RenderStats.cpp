@@ -0,0 +1,107 @@
+#include <lol/util/RenderStats.hpp>
+
+#include <algorithm>
+
+namespace lol
+{
+	RenderStats::RenderStats() :
+		historySize(120), frame(0)
+	{
+		for (std::atomic<uint64_t>& counter : counters)
+			counter = 0;
+
+		for (std::atomic<int64_t>& memory : liveMemory)
+			memory = 0;
+	}
+
+	RenderStats& RenderStats::Get()
+	{
+		static RenderStats stats;
+		return stats;
+	}
+
+	void RenderStats::AddDraw(DrawMode mode, size_t vertices)
+	{
+		Add(RenderCounter::DrawCalls);
+		Add(RenderCounter::Primitives, CountPrimitives(mode, vertices));
+	}
+
+	void RenderStats::NewFrame()
+	{
+		FrameStats stats;
+		for (size_t i = 0; i < counters.size(); i++)
+			stats.counters[i] = counters[i].exchange(0, std::memory_order_relaxed);
+
+		for (size_t i = 0; i < liveMemory.size(); i++)
+			stats.liveMemory[i] = liveMemory[i].load(std::memory_order_relaxed);
+
+		std::lock_guard<std::mutex> lock(historyMutex);
+		stats.frame = frame++;
+
+		history.push_back(stats);
+		while (history.size() > historySize)
+			history.pop_front();
+	}
+
+	void RenderStats::SetHistorySize(size_t frames)
+	{
+		std::lock_guard<std::mutex> lock(historyMutex);
+		historySize = std::max<size_t>(frames, 1);
+
+		while (history.size() > historySize)
+			history.pop_front();
+	}
+
+	FrameStats RenderStats::GetLastFrame() const
+	{
+		std::lock_guard<std::mutex> lock(historyMutex);
+		if (history.empty())
+			return FrameStats{};
+
+		return history.back();
+	}
+
+	std::deque<FrameStats> RenderStats::GetHistory() const
+	{
+		std::lock_guard<std::mutex> lock(historyMutex);
+		return history;
+	}
+
+	double RenderStats::GetAverage(RenderCounter counter, size_t frames) const
+	{
+		std::lock_guard<std::mutex> lock(historyMutex);
+
+		frames = std::min(frames, history.size());
+		if (frames == 0)
+			return 0.0;
+
+		uint64_t sum = 0;
+		for (auto it = history.end() - frames; it != history.end(); it++)
+			sum += (*it)[counter];
+
+		return (double)sum / frames;
+	}
+
+	size_t RenderStats::CountPrimitives(DrawMode mode, size_t vertices)
+	{
+		switch (mode)
+		{
+		case DrawMode::Points:					return vertices;
+		case DrawMode::Lines:					return vertices / 2;
+		case DrawMode::LineStrip:				return (vertices >= 2) ? vertices - 1 : 0;
+		case DrawMode::LineLoop:				return (vertices >= 2) ? vertices : 0;
+		case DrawMode::LinesAdjacency:			return vertices / 4;
+		case DrawMode::LineStripAdjacency:		return (vertices >= 4) ? vertices - 3 : 0;
+		case DrawMode::Triangles:				return vertices / 3;
+		case DrawMode::TriangleStrip:
+		case DrawMode::TriangleFan:				return (vertices >= 3) ? vertices - 2 : 0;
+		case DrawMode::TrianglesAdjacency:		return vertices / 6;
+		case DrawMode::TriangleStripAdjacency:	return (vertices >= 6) ? (vertices - 4) / 2 : 0;
+
+		// The patch size is a context state, assume the default of 3
+		case DrawMode::Patches:					return vertices / 3;
+		}
+
+		return 0;
+	}
+}
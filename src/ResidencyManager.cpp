@@ -0,0 +1,184 @@
+#include <lol/util/ResidencyManager.hpp>
+
+#include <vector>
+#include <algorithm>
+
+#include <lol/Texture.hpp>
+#include <lol/Buffer.hpp>
+
+namespace lol
+{
+	ResidencyManager::ResidencyManager(size_t budget) :
+		budget(budget), residentBytes(0), bufferBytes(0), evictedBytes(0), frame(0)
+	{
+	}
+
+	ResidencyManager::~ResidencyManager()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for (auto& [texture, entry] : textures)
+			texture->residency = nullptr;
+
+		for (auto& [buffer, bytes] : buffers)
+			buffer->residency = nullptr;
+	}
+
+	void ResidencyManager::Track(Texture& texture)
+	{
+		if (texture.residency == this)
+			return;
+
+		// Outside of the lock, two managers swapping Textures must not wait on each other
+		if (texture.residency != nullptr)
+			texture.residency->Untrack(texture);
+
+		std::lock_guard<std::mutex> lock(mutex);
+		Entry entry{ texture.GetMemoryUsage(), frame };
+		textures.insert({ &texture, entry });
+		texture.residency = this;
+
+		if (texture.IsResident())
+			residentBytes += entry.bytes;
+		else
+			evictedBytes += entry.bytes;
+	}
+
+	void ResidencyManager::Track(Buffer& buffer)
+	{
+		if (buffer.residency == this)
+			return;
+
+		if (buffer.residency != nullptr)
+			buffer.residency->Untrack(buffer);
+
+		std::lock_guard<std::mutex> lock(mutex);
+		buffers.insert({ &buffer, buffer.GetSize() });
+		buffer.residency = this;
+
+		residentBytes += buffer.GetSize();
+		bufferBytes += buffer.GetSize();
+	}
+
+	void ResidencyManager::Untrack(Texture& texture)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = textures.find(&texture);
+		if (it == textures.end())
+			return;
+
+		if (texture.IsResident())
+			residentBytes -= it->second.bytes;
+		else
+			evictedBytes -= it->second.bytes;
+
+		textures.erase(it);
+		texture.residency = nullptr;
+	}
+
+	void ResidencyManager::Untrack(Buffer& buffer)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = buffers.find(&buffer);
+		if (it == buffers.end())
+			return;
+
+		residentBytes -= it->second;
+		bufferBytes -= it->second;
+
+		buffers.erase(it);
+		buffer.residency = nullptr;
+	}
+
+	void ResidencyManager::Touch(Texture& texture)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		// Inserting an entry here would leave it behind once the texture is destroyed
+		auto it = textures.find(&texture);
+		if (it == textures.end())
+			return;
+
+		Entry& entry = it->second;
+		entry.lastUsed = frame;
+
+		if (!texture.IsResident())
+		{
+			texture.Restore();
+
+			evictedBytes -= entry.bytes;
+			residentBytes += entry.bytes;
+		}
+	}
+
+	void ResidencyManager::NewFrame()
+	{
+		// Held while evicting, a Texture destroyed on another thread waits in Untrack() until it was evicted
+		std::lock_guard<std::mutex> lock(mutex);
+		frame++;
+
+		// Only Textures can be evicted, so only they are held to the budget
+		size_t textureBytes = residentBytes - bufferBytes;
+		if (textureBytes <= budget)
+			return;
+
+		// Collect everything that wasn't needed last frame, oldest first
+		std::vector<std::pair<Texture*, Entry*>> candidates;
+		for (auto& [texture, entry] : textures)
+		{
+			if (texture->IsResident() && entry.lastUsed + 1 < frame)
+				candidates.push_back({ texture, &entry });
+		}
+
+		std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+			return a.second->lastUsed < b.second->lastUsed;
+		});
+
+		for (auto& [texture, entry] : candidates)
+		{
+			if (textureBytes <= budget)
+				break;
+
+			texture->Evict();
+
+			textureBytes -= entry->bytes;
+			residentBytes -= entry->bytes;
+			evictedBytes += entry->bytes;
+		}
+	}
+
+	void ResidencyManager::SetBudget(size_t budget)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		this->budget = budget;
+	}
+
+	size_t ResidencyManager::GetBudget() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return budget;
+	}
+
+	size_t ResidencyManager::GetResidentBytes() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return residentBytes;
+	}
+
+	size_t ResidencyManager::GetBufferBytes() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return bufferBytes;
+	}
+
+	size_t ResidencyManager::GetEvictedBytes() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return evictedBytes;
+	}
+
+	uint64_t ResidencyManager::GetFrame() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return frame;
+	}
+}
@@ -5,79 +5,180 @@
 #include <glm/gtc/type_ptr.hpp>
 #include <glad/glad.h>	
 
+#include <lol/util/Capabilities.hpp>
+#include <lol/util/DeletionQueue.hpp>
+#include <lol/util/Profiler.hpp>
+#include <lol/util/RenderStats.hpp>
+
 #define IMPLEMENT_UNIFORM_FUNCTION(type, func) \
 inline 
 
 namespace lol
 {
 
-	Shader::Shader(const std::string& vertexShader, const std::string& fragmentShader) :
-		id(0)
+	// From GL_KHR_parallel_shader_compile, which glad wasn't generated with
+	static constexpr GLenum GL_COMPLETION_STATUS_KHR = 0x91B1;
+
+	static bool PrintCompileErrors(GLuint shaderID, const char* name)
 	{
 		GLint success;
 		GLchar infoLog[512];
 
-		GLuint vertexShaderID = glCreateShader(GL_VERTEX_SHADER);
-		const char* vertexShaderSource = vertexShader.c_str();
-		glShaderSource(vertexShaderID, 1, &vertexShaderSource, NULL);
-		glCompileShader(vertexShaderID);
-
-		glGetShaderiv(vertexShaderID, GL_COMPILE_STATUS, &success);
+		glGetShaderiv(shaderID, GL_COMPILE_STATUS, &success);
 		if (!success)
 		{
-			glGetShaderInfoLog(vertexShaderID, 512, NULL, infoLog);
-			std::cerr << "Vertex shader creation failed: \n" << infoLog << std::endl;
+			glGetShaderInfoLog(shaderID, 512, NULL, infoLog);
+			std::cerr << name << " shader creation failed: \n" << infoLog << std::endl;
+		}
 
-			glDeleteShader(vertexShaderID);
-			return;
+		return !success;
+	}
+
+	Shader::Shader() :
+		id(0), vertexShaderID(0), fragmentShaderID(0), status(ShaderStatus::Failed)
+	{
+	}
+
+	Shader::Shader(const std::string& vertexShader, const std::string& fragmentShader, CompileMode mode) :
+		Shader()
+	{
+		Submit(vertexShader, fragmentShader, false);
+		if (mode == CompileMode::Immediate)
+			Finish();
+	}
+
+	ShaderStatus Shader::GetStatus()
+	{
+		if (status != ShaderStatus::Pending)
+			return status;
+
+		static const bool parallelCompile = HasExtension("GL_KHR_parallel_shader_compile");
+		if (parallelCompile)
+		{
+			GLint completed = GL_FALSE;
+			glGetProgramiv(id, GL_COMPLETION_STATUS_KHR, &completed);
+			if (!completed)
+				return status;
 		}
 
-		GLuint fragmentShaderID = glCreateShader(GL_FRAGMENT_SHADER);
+		Finish();
+		return status;
+	}
+
+	bool Shader::Compile(const std::string& vertexShader, const std::string& fragmentShader, bool retrievable)
+	{
+		Submit(vertexShader, fragmentShader, retrievable);
+		Finish();
+
+		return status == ShaderStatus::Ready;
+	}
+
+	void Shader::Submit(const std::string& vertexShader, const std::string& fragmentShader, bool retrievable)
+	{
+		LOL_PROFILE_SCOPE("Shader::Submit");
+
+		// Nothing in here may query compilation results, as that would force the driver to finish compiling
+		vertexShaderID = glCreateShader(GL_VERTEX_SHADER);
+		const char* vertexShaderSource = vertexShader.c_str();
+		glShaderSource(vertexShaderID, 1, &vertexShaderSource, NULL);
+		glCompileShader(vertexShaderID);
+
+		fragmentShaderID = glCreateShader(GL_FRAGMENT_SHADER);
 		const char* fragmentShaderSource = fragmentShader.c_str();
 		glShaderSource(fragmentShaderID, 1, &fragmentShaderSource, NULL);
 		glCompileShader(fragmentShaderID);
 
-		glGetShaderiv(fragmentShaderID, GL_COMPILE_STATUS, &success);
-		if (!success)
-		{
-			glGetShaderInfoLog(fragmentShaderID, 512, NULL, infoLog);
-			std::cerr << "Fragment shader creation failed: \n" << infoLog << std::endl;
-
-			glDeleteShader(fragmentShaderID);
-			glDeleteShader(vertexShaderID);
-			return;
-		}
-
 		id = glCreateProgram();
+		if (retrievable)
+			glProgramParameteri(id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
 		glAttachShader(id, vertexShaderID);
 		glAttachShader(id, fragmentShaderID);
 		glLinkProgram(id);
 
+		status = ShaderStatus::Pending;
+	}
+
+	void Shader::Finish()
+	{
+		LOL_PROFILE_SCOPE("Shader::Finish");
+
+		GLint success;
+		GLchar infoLog[512];
+
 		glGetProgramiv(id, GL_LINK_STATUS, &success);
 		if (!success)
 		{
-			glGetProgramInfoLog(fragmentShaderID, 512, NULL, infoLog);
-			std::cerr << "Shader program linking failed: \n" << infoLog << std::endl;
+			// Prefer the compiler's errors, the linker only complains about the stages being broken
+			bool compileFailed = PrintCompileErrors(vertexShaderID, "Vertex");
+			compileFailed |= PrintCompileErrors(fragmentShaderID, "Fragment");
 
-			glDeleteShader(fragmentShaderID);
-			glDeleteShader(vertexShaderID);
+			if (!compileFailed)
+			{
+				glGetProgramInfoLog(id, 512, NULL, infoLog);
+				std::cerr << "Shader program linking failed: \n" << infoLog << std::endl;
+			}
 
+			glDeleteProgram(id);
 			id = 0;
-
-			return;
 		}
 
 		glDeleteShader(fragmentShaderID);
 		glDeleteShader(vertexShaderID);
+		fragmentShaderID = 0;
+		vertexShaderID = 0;
+
+		status = success ? ShaderStatus::Ready : ShaderStatus::Failed;
+	}
+
+	bool Shader::LoadBinary(unsigned int binaryFormat, const std::vector<uint8_t>& binary)
+	{
+		LOL_PROFILE_SCOPE("Shader::LoadBinary");
+
+		id = glCreateProgram();
+		glProgramBinary(id, binaryFormat, binary.data(), (GLsizei)binary.size());
+
+		// Drivers reject binaries created by other drivers (or versions) by failing the link
+		GLint success;
+		glGetProgramiv(id, GL_LINK_STATUS, &success);
+		if (!success)
+		{
+			glDeleteProgram(id);
+			id = 0;
+
+			return false;
+		}
+
+		status = ShaderStatus::Ready;
+		return true;
+	}
+
+	std::vector<uint8_t> Shader::GetBinary(unsigned int& binaryFormat) const
+	{
+		GLint length = 0;
+		glGetProgramiv(id, GL_PROGRAM_BINARY_LENGTH, &length);
+		if (length <= 0)
+			return {};
+
+		std::vector<uint8_t> binary(length);
+		GLenum format = 0;
+		glGetProgramBinary(id, length, &length, &format, binary.data());
+		binary.resize(length);
+
+		binaryFormat = format;
+		return binary;
 	}
 
 	Shader::~Shader()
 	{
-		glDeleteProgram(id);
+		DeletionQueue::Get().Release(ObjectType::Shader, fragmentShaderID);
+		DeletionQueue::Get().Release(ObjectType::Shader, vertexShaderID);
+		DeletionQueue::Get().Release(ObjectType::Program, id);
 	}
 
 	void Shader::Bind()
 	{
+		RenderStats::Get().Add(RenderCounter::ShaderBinds);
 		glUseProgram(id);
 	}
 
@@ -86,12 +187,18 @@ namespace lol
 		glUseProgram(0);
 	}
 
+	int Shader::GetUniformLocation(const std::string& name)
+	{
+		return glGetUniformLocation(id, name.c_str());
+	}
+
 	void Shader::SetUniform(const std::string& name, int value)
 	{
 		GLint location = glGetUniformLocation(id, name.c_str());
 		if (location == -1)
 			return;
 
+		RenderStats::Get().Add(RenderCounter::UniformUpdates);
 		glUniform1i(location, value);
 	}
 
@@ -101,6 +208,7 @@ namespace lol
 		if (location == -1)
 			return;
 
+		RenderStats::Get().Add(RenderCounter::UniformUpdates);
 		glUniform1f(location, value);
 	}
 
@@ -110,6 +218,7 @@ namespace lol
 		if (location == -1)
 			return;
 
+		RenderStats::Get().Add(RenderCounter::UniformUpdates);
 		glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
 	}
 
@@ -119,6 +228,7 @@ namespace lol
 		if (location == -1)
 			return;
 
+		RenderStats::Get().Add(RenderCounter::UniformUpdates);
 		glUniform2fv(location, 1, glm::value_ptr(value));
 	}
 
@@ -128,6 +238,7 @@ namespace lol
 		if (location == -1)
 			return;
 
+		RenderStats::Get().Add(RenderCounter::UniformUpdates);
 		glUniform4fv(location, 1, glm::value_ptr(value));
 	}
 
@@ -0,0 +1,170 @@
+#include <lol/util/ShaderCache.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include <glad/glad.h>
+
+#include <lol/Shader.hpp>
+#include <lol/util/ShaderPreprocessor.hpp>
+#include <lol/util/Profiler.hpp>
+
+namespace lol
+{
+	/**
+	 * @brief Header in front of every program binary on disk
+	 */
+	struct BinaryHeader
+	{
+		char magic[4];
+		uint32_t version;
+		Hash128 key;			///< Guards against renamed or truncated files
+		Hash128 checksum;		///< Hash of the binary that follows
+		uint32_t binaryFormat;
+		uint32_t reserved;
+		uint64_t size;
+	};
+
+	static constexpr char BinaryMagic[4] = { 'L', 'O', 'L', 'P' };
+	static constexpr uint32_t BinaryVersion = 1;
+
+	static std::string GetDriverString(GLenum name)
+	{
+		const GLubyte* string = glGetString(name);
+		return (string != nullptr) ? (const char*)string : "";
+	}
+
+	ShaderCache::ShaderCache(const std::string& directory) :
+		directory(directory), supported(false), hits(0), misses(0), rejected(0)
+	{
+		GLint formats = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+		supported = (formats > 0);
+
+		driverHash = HashContent(GetDriverString(GL_VENDOR) + "\n" + GetDriverString(GL_RENDERER) + "\n" + GetDriverString(GL_VERSION));
+
+		std::error_code error;
+		std::filesystem::create_directories(directory, error);
+	}
+
+	std::shared_ptr<Shader> ShaderCache::Load(const std::string& vertexShader, const std::string& fragmentShader, const std::vector<std::string>& defines)
+	{
+		LOL_PROFILE_SCOPE("ShaderCache::Load");
+
+		std::string vertexSource = ShaderPreprocessor::InjectDefines(vertexShader, defines);
+		std::string fragmentSource = ShaderPreprocessor::InjectDefines(fragmentShader, defines);
+
+		Hash128 key = HashCombine(driverHash, HashCombine(HashContent(vertexSource), HashContent(fragmentSource)));
+
+		std::shared_ptr<Shader> shader(new Shader());
+		if (supported)
+		{
+			unsigned int binaryFormat;
+			std::vector<uint8_t> binary;
+
+			if (ReadBinary(key, binaryFormat, binary))
+			{
+				if (shader->LoadBinary(binaryFormat, binary))
+				{
+					hits++;
+					return shader;
+				}
+
+				rejected++;
+			}
+		}
+
+		misses++;
+		if (!shader->Compile(vertexSource, fragmentSource, supported))
+			return shader;
+
+		if (supported)
+		{
+			unsigned int binaryFormat = 0;
+			std::vector<uint8_t> binary = shader->GetBinary(binaryFormat);
+			if (!binary.empty())
+				WriteBinary(key, binaryFormat, binary);
+		}
+
+		return shader;
+	}
+
+	void ShaderCache::Clear()
+	{
+		std::error_code error;
+		for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directory, error))
+		{
+			if (entry.path().extension() == ".bin")
+				std::filesystem::remove(entry.path(), error);
+		}
+	}
+
+	std::string ShaderCache::PathOf(const Hash128& key) const
+	{
+		return (std::filesystem::path(directory) / (key.ToString() + ".bin")).string();
+	}
+
+	bool ShaderCache::ReadBinary(const Hash128& key, unsigned int& binaryFormat, std::vector<uint8_t>& binary) const
+	{
+		std::string path = PathOf(key);
+		std::error_code error;
+		uintmax_t fileSize = std::filesystem::file_size(path, error);
+		if (error || fileSize < sizeof(BinaryHeader))
+			return false;
+
+		std::ifstream file(path, std::ios::binary);
+		if (!file)
+			return false;
+
+		BinaryHeader header;
+		if (!file.read((char*)&header, sizeof(header)))
+			return false;
+
+		if (std::memcmp(header.magic, BinaryMagic, sizeof(BinaryMagic)) != 0 || header.version != BinaryVersion || header.key != key)
+			return false;
+
+		if (header.size != fileSize - sizeof(BinaryHeader))
+			return false;
+
+		binary.resize(header.size);
+		if (!file.read((char*)binary.data(), binary.size()))
+			return false;
+
+		if (HashBytes(binary.data(), binary.size()) != header.checksum)
+			return false;
+
+		binaryFormat = header.binaryFormat;
+		return true;
+	}
+
+	void ShaderCache::WriteBinary(const Hash128& key, unsigned int binaryFormat, const std::vector<uint8_t>& binary) const
+	{
+		BinaryHeader header = {};
+		std::memcpy(header.magic, BinaryMagic, sizeof(BinaryMagic));
+		header.version = BinaryVersion;
+		header.key = key;
+		header.checksum = HashBytes(binary.data(), binary.size());
+		header.binaryFormat = binaryFormat;
+		header.size = binary.size();
+
+		// Write to a temporary file first, so a crash never leaves a half written binary behind
+		std::string path = PathOf(key);
+		std::string temporary = path + ".tmp";
+		{
+			std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+			if (!file)
+				return;
+
+			file.write((const char*)&header, sizeof(header));
+			file.write((const char*)binary.data(), binary.size());
+			if (!file)
+				return;
+		}
+
+		std::error_code error;
+		std::filesystem::rename(temporary, path, error);
+		if (error)
+			std::filesystem::remove(temporary, error);
+	}
+}
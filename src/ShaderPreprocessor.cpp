@@ -0,0 +1,151 @@
+#include <lol/util/ShaderPreprocessor.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include <lol/util/Exceptions.hpp>
+
+namespace lol
+{
+	/**
+	 * @brief Extract the file name from an #include line
+	 *
+	 * @return `false` if the line isn't an #include directive
+	 */
+	static bool ParseInclude(const std::string& line, std::string& name)
+	{
+		size_t pos = line.find_first_not_of(" \t");
+		if (pos == std::string::npos || line[pos] != '#')
+			return false;
+
+		pos = line.find_first_not_of(" \t", pos + 1);
+		if (pos == std::string::npos || line.compare(pos, 7, "include") != 0)
+			return false;
+
+		size_t open = line.find_first_of("\"<", pos + 7);
+		if (open == std::string::npos)
+			return false;
+
+		size_t close = line.find(line[open] == '"' ? '"' : '>', open + 1);
+		if (close == std::string::npos)
+			return false;
+
+		name = line.substr(open + 1, close - open - 1);
+		return true;
+	}
+
+	ShaderPreprocessor::ShaderPreprocessor()
+	{
+	}
+
+	void ShaderPreprocessor::AddIncludePath(const std::string& directory)
+	{
+		includePaths.push_back(directory);
+	}
+
+	void ShaderPreprocessor::AddSource(const std::string& name, const std::string& source)
+	{
+		sources[name] = source;
+	}
+
+	std::string ShaderPreprocessor::Process(const std::string& source, const std::vector<std::string>& defines) const
+	{
+		std::vector<std::string> included;
+		std::string output;
+		output.reserve(source.size());
+
+		Expand(source, 0, included, output);
+		return InjectDefines(output, defines);
+	}
+
+	std::string ShaderPreprocessor::InjectDefines(const std::string& source, const std::vector<std::string>& defines)
+	{
+		if (defines.empty())
+			return source;
+
+		std::string block;
+		for (const std::string& define : defines)
+			block += "#define " + define + "\n";
+
+		size_t version = source.find("#version");
+		if (version == std::string::npos)
+			return block + "#line 1\n" + source;
+
+		size_t lineEnd = source.find('\n', version);
+		if (lineEnd == std::string::npos)
+			return source + "\n" + block;
+
+		// Restore the line numbering so compiler errors still point at the right lines
+		size_t line = 2 + std::count(source.begin(), source.begin() + version, '\n');
+		return source.substr(0, lineEnd + 1) + block + "#line " + std::to_string(line) + "\n" + source.substr(lineEnd + 1);
+	}
+
+	void ShaderPreprocessor::Expand(const std::string& source, size_t fileIndex, std::vector<std::string>& included, std::string& output) const
+	{
+		std::istringstream stream(source);
+		std::string line;
+		size_t lineNumber = 0;
+		bool inComment = false;
+
+		while (std::getline(stream, line))
+		{
+			lineNumber++;
+
+			// Directives inside block comments must be ignored
+			bool startedInComment = inComment;
+			for (size_t pos = 0; pos < line.size(); pos++)
+			{
+				if (!inComment && line.compare(pos, 2, "//") == 0)
+					break;
+
+				if (!inComment && line.compare(pos, 2, "/*") == 0)
+					inComment = true, pos++;
+				else if (inComment && line.compare(pos, 2, "*/") == 0)
+					inComment = false, pos++;
+			}
+
+			std::string name;
+			if (startedInComment || !ParseInclude(line, name))
+			{
+				output += line;
+				output += '\n';
+				continue;
+			}
+
+			if (std::find(included.begin(), included.end(), name) != included.end())
+			{
+				output += '\n';		// Keeps the line numbering intact
+				continue;
+			}
+
+			included.push_back(name);
+			std::string content = Load(name);
+
+			output += "#line 1 " + std::to_string(included.size()) + "\n";
+			Expand(content, included.size(), included, output);
+			output += "#line " + std::to_string(lineNumber + 1) + " " + std::to_string(fileIndex) + "\n";
+		}
+	}
+
+	std::string ShaderPreprocessor::Load(const std::string& name) const
+	{
+		auto it = sources.find(name);
+		if (it != sources.end())
+			return it->second;
+
+		for (const std::string& directory : includePaths)
+		{
+			std::ifstream file(std::filesystem::path(directory) / name);
+			if (!file)
+				continue;
+
+			std::stringstream content;
+			content << file.rdbuf();
+			return content.str();
+		}
+
+		throw ShaderIncludeException(name);
+	}
+}
@@ -0,0 +1,72 @@
+#include <lol/util/ShaderVariants.hpp>
+
+#include <cassert>
+
+#include <lol/util/ShaderCache.hpp>
+#include <lol/util/ShaderPreprocessor.hpp>
+
+namespace lol
+{
+	ShaderVariants::ShaderVariants(const std::string& vertexShader, const std::string& fragmentShader, const std::vector<std::string>& features, const ShaderPreprocessor* preprocessor) :
+		vertexShader(vertexShader), fragmentShader(fragmentShader), features(features), featureMask(0), cache(nullptr), mode(CompileMode::Deferred)
+	{
+		assert(features.size() <= 64 && "lol::ShaderVariants supports at most 64 features");
+
+		featureMask = (features.size() >= 64) ? ~0ull : ((1ull << features.size()) - 1);
+
+		if (preprocessor != nullptr)
+		{
+			this->vertexShader = preprocessor->Process(vertexShader);
+			this->fragmentShader = preprocessor->Process(fragmentShader);
+		}
+	}
+
+	std::shared_ptr<Shader> ShaderVariants::Get(uint64_t features)
+	{
+		features &= featureMask;
+
+		auto it = variants.find(features);
+		if (it != variants.end())
+			return it->second;
+
+		std::vector<std::string> defines;
+		for (size_t i = 0; i < this->features.size(); i++)
+		{
+			if (features & (1ull << i))
+				defines.push_back(this->features[i]);
+		}
+
+		std::shared_ptr<Shader> shader;
+		if (cache != nullptr)
+		{
+			shader = cache->Load(vertexShader, fragmentShader, defines);
+		}
+		else
+		{
+			shader = std::make_shared<Shader>(
+				ShaderPreprocessor::InjectDefines(vertexShader, defines),
+				ShaderPreprocessor::InjectDefines(fragmentShader, defines),
+				mode
+			);
+		}
+
+		variants.emplace(features, shader);
+		return shader;
+	}
+
+	uint64_t ShaderVariants::FeatureBit(const std::string& name) const
+	{
+		for (size_t i = 0; i < features.size(); i++)
+		{
+			if (features[i] == name)
+				return 1ull << i;
+		}
+
+		return 0;
+	}
+
+	void ShaderVariants::Clear()
+	{
+		variants.clear();
+	}
+}
@@ -0,0 +1,107 @@
+#include <lol/util/SkylinePacker.hpp>
+
+#include <limits>
+#include <algorithm>
+
+namespace lol
+{
+	SkylinePacker::SkylinePacker(unsigned int width, unsigned int height) :
+		size(width, height), usedArea(0)
+	{
+		Clear();
+	}
+
+	bool SkylinePacker::Insert(unsigned int width, unsigned int height, glm::uvec2& position)
+	{
+		size_t bestIndex = skyline.size();
+		unsigned int bestTop = std::numeric_limits<unsigned int>::max();
+		unsigned int bestWidth = std::numeric_limits<unsigned int>::max();
+
+		// Find the spot where the upper edge of the rectangle is the lowest,
+		// break ties by choosing the narrowest segment to reduce fragmentation
+		for (size_t i = 0; i < skyline.size(); i++)
+		{
+			unsigned int y;
+			if (!Fits(i, width, height, y))
+				continue;
+
+			if (y + height < bestTop || (y + height == bestTop && skyline[i].width < bestWidth))
+			{
+				bestIndex = i;
+				bestTop = y + height;
+				bestWidth = skyline[i].width;
+				position = glm::uvec2(skyline[i].x, y);
+			}
+		}
+
+		if (bestIndex == skyline.size())
+			return false;
+
+		skyline.insert(skyline.begin() + bestIndex, Node{ position.x, position.y + height, width });
+
+		// Shrink or remove the segments that are now covered by the new one
+		for (size_t i = bestIndex + 1; i < skyline.size();)
+		{
+			Node& previous = skyline[i - 1];
+			Node& node = skyline[i];
+
+			if (node.x >= previous.x + previous.width)
+				break;
+
+			unsigned int shrink = previous.x + previous.width - node.x;
+			if (node.width > shrink)
+			{
+				node.x += shrink;
+				node.width -= shrink;
+				break;
+			}
+
+			skyline.erase(skyline.begin() + i);
+		}
+
+		// Merge neighbouring segments of the same height
+		for (size_t i = 0; i + 1 < skyline.size();)
+		{
+			if (skyline[i].y == skyline[i + 1].y)
+			{
+				skyline[i].width += skyline[i + 1].width;
+				skyline.erase(skyline.begin() + i + 1);
+			}
+			else
+				i++;
+		}
+
+		usedArea += (size_t)width * height;
+		return true;
+	}
+
+	void SkylinePacker::Clear()
+	{
+		skyline.clear();
+		skyline.push_back(Node{ 0, 0, size.x });
+		usedArea = 0;
+	}
+
+	bool SkylinePacker::Fits(size_t index, unsigned int width, unsigned int height, unsigned int& y) const
+	{
+		if (skyline[index].x + width > size.x)
+			return false;
+
+		y = 0;
+		unsigned int remaining = width;
+		for (size_t i = index; remaining > 0; i++)
+		{
+			// Ran off the right edge of the area
+			if (i >= skyline.size())
+				return false;
+
+			y = std::max(y, skyline[i].y);
+			if (y + height > size.y)
+				return false;
+
+			remaining -= std::min(remaining, skyline[i].width);
+		}
+
+		return true;
+	}
+}
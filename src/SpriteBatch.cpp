@@ -0,0 +1,269 @@
+#include <lol/SpriteBatch.hpp>
+
+#include <algorithm>
+#include <assert.h>
+#include <cmath>
+
+#include <glad/glad.h>
+
+#include <lol/Camera.hpp>
+#include <lol/Shader.hpp>
+#include <lol/Texture.hpp>
+#include <lol/TextureArrayPool.hpp>
+#include <lol/TextureAtlas.hpp>
+#include <lol/VertexArrayObject.hpp>
+#include <lol/buffers/VertexBuffer.hpp>
+#include <lol/util/JobSystem.hpp>
+#include <lol/util/Profiler.hpp>
+#include <lol/util/RenderStats.hpp>
+
+namespace lol
+{
+	static const char* spriteVertexShader = R"(
+#version 330 core
+layout (location = 0) in vec2 position;
+layout (location = 1) in vec2 uv;
+layout (location = 2) in vec4 color;
+
+uniform mat4 viewProjection;
+
+out vec2 fragmentUV;
+out vec4 fragmentColor;
+
+void main()
+{
+	fragmentUV = uv;
+	fragmentColor = color;
+	gl_Position = viewProjection * vec4(position, 0.0, 1.0);
+}
+)";
+
+	static const char* spriteFragmentShader = R"(
+#version 330 core
+in vec2 fragmentUV;
+in vec4 fragmentColor;
+
+uniform sampler2D sprite;
+
+out vec4 result;
+
+void main()
+{
+	result = texture(sprite, fragmentUV) * fragmentColor;
+}
+)";
+
+	static const char* spriteArrayVertexShader = R"(
+#version 330 core
+layout (location = 0) in vec2 position;
+layout (location = 1) in vec2 uv;
+layout (location = 2) in vec4 color;
+layout (location = 3) in float arrayLayer;
+
+uniform mat4 viewProjection;
+
+out vec3 fragmentUV;
+out vec4 fragmentColor;
+
+void main()
+{
+	fragmentUV = vec3(uv, arrayLayer);
+	fragmentColor = color;
+	gl_Position = viewProjection * vec4(position, 0.0, 1.0);
+}
+)";
+
+	static const char* spriteArrayFragmentShader = R"(
+#version 330 core
+in vec3 fragmentUV;
+in vec4 fragmentColor;
+
+uniform sampler2DArray sprite;
+
+out vec4 result;
+
+void main()
+{
+	result = texture(sprite, fragmentUV) * fragmentColor;
+}
+)";
+
+	// Corners of a quad, in the order the indices expect them
+	static const glm::vec2 corners[4] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+
+	SpriteBatch::SpriteBatch(const std::shared_ptr<Shader>& shader, const std::shared_ptr<Shader>& arrayShader) :
+		shader(shader), arrayShader(arrayShader), viewProjection(1.0f), drawCount(0)
+	{
+		if (this->shader == nullptr)
+			this->shader = std::make_shared<Shader>(spriteVertexShader, spriteFragmentShader);
+
+		vertexBuffer = std::make_shared<VertexBuffer>(sizeof(Vertex) * 4);
+		vertexBuffer->SetLayout({
+			VertexAttribute(Type::Float, 2, false),
+			VertexAttribute(Type::Float, 2, false),
+			VertexAttribute(Type::UByte, 4, true),
+			VertexAttribute(Type::Float, 1, false)
+		});
+
+		vao = std::make_shared<VertexArray>();
+		vao->SetVertexBuffer(vertexBuffer);
+		quadIndices.Reserve(*vao, 1024);
+		glBindVertexArray(0);
+	}
+
+	SpriteBatch::~SpriteBatch()
+	{
+	}
+
+	void SpriteBatch::Begin(const CameraBase& camera)
+	{
+		viewProjection = camera.GetProjection() * camera.GetView();
+
+		sprites.clear();
+		spriteTextures.clear();
+		spriteArrayLayers.clear();
+		textures.clear();
+		textureIndices.clear();
+	}
+
+	void SpriteBatch::Draw(Texture2D& texture, const Sprite& sprite)
+	{
+		Add(texture, false, sprite, 0);
+	}
+
+	void SpriteBatch::Draw(const TextureAtlas& atlas, const AtlasRegion& region, Sprite sprite)
+	{
+		if (region.IsEmpty())
+			return;
+
+		sprite.uv = region.uv;
+		Draw(*atlas.GetPage(region.page), sprite);
+	}
+
+	void SpriteBatch::Draw(const TextureLayer& layer, const Sprite& sprite)
+	{
+		assert(layer.layer < layer.texture->GetLayerCount() && "lol::SpriteBatch::Draw() layer is out of range");
+		Add(*layer.texture, true, sprite, layer.layer);
+	}
+
+	void SpriteBatch::Add(Texture& texture, bool array, const Sprite& sprite, unsigned int arrayLayer)
+	{
+		// Consecutive sprites usually share a texture, that's cheaper to check than the map
+		uint16_t index;
+		if (!textures.empty() && textures[spriteTextures.back()].texture == &texture)
+		{
+			index = spriteTextures.back();
+		}
+		else
+		{
+			auto it = textureIndices.find(&texture);
+			if (it == textureIndices.end())
+			{
+				assert(textures.size() <= UINT16_MAX && "lol::SpriteBatch::Draw() too many textures in one batch");
+				it = textureIndices.insert({ &texture, (uint16_t)textures.size() }).first;
+				textures.push_back(BatchTexture{ &texture, array });
+			}
+
+			index = it->second;
+		}
+
+		sprites.push_back(sprite);
+		spriteTextures.push_back(index);
+		spriteArrayLayers.push_back(arrayLayer);
+	}
+
+	void SpriteBatch::End()
+	{
+		LOL_PROFILE_SCOPE("SpriteBatch::End");
+
+		drawCount = 0;
+		if (sprites.empty())
+			return;
+
+		// Sorting by layer, then texture, then the order the sprites were added in
+		size_t count = sprites.size();
+		keys.resize(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			uint64_t layer = (uint64_t)(std::min(std::max(sprites[i].layer, -32768), 32767) + 32768);
+			keys[i] = (layer << 48) | ((uint64_t)spriteTextures[i] << 32) | (uint64_t)i;
+		}
+
+		std::sort(keys.begin(), keys.end());
+
+		vertices.resize(count * 4);
+		JobSystem::Default().ParallelFor(0, count, [this](size_t first, size_t last)
+		{
+			for (size_t i = first; i < last; i++)
+			{
+				size_t index = keys[i] & 0xFFFFFFFF;
+				const Sprite& sprite = sprites[index];
+				float arrayLayer = (float)spriteArrayLayers[index];
+
+				float cosine = std::cos(sprite.rotation);
+				float sine = std::sin(sprite.rotation);
+				uint8_t color[4] = { ToUNorm8(sprite.color.x), ToUNorm8(sprite.color.y), ToUNorm8(sprite.color.z), ToUNorm8(sprite.color.w) };
+
+				for (int corner = 0; corner < 4; corner++)
+				{
+					glm::vec2 local = (corners[corner] - sprite.origin) * sprite.size;
+
+					Vertex& vertex = vertices[i * 4 + corner];
+					vertex.position = sprite.position + glm::vec2(local.x * cosine - local.y * sine, local.x * sine + local.y * cosine);
+					vertex.uv = glm::vec2(sprite.uv.x + corners[corner].x * sprite.uv.w, sprite.uv.y + corners[corner].y * sprite.uv.h);
+					std::copy(color, color + 4, vertex.color);
+					vertex.arrayLayer = arrayLayer;
+				}
+			}
+		}, 4096);
+
+		// Orphaning the old storage, so the draws of the previous frame don't have to finish first
+		vertexBuffer->SetData(vertices.data(), vertices.size() * sizeof(Vertex));
+
+		glActiveTexture(GL_TEXTURE0);
+
+		// Find the runs of sprites sharing layer and texture, each is one draw call
+		std::vector<std::pair<size_t, size_t>> runs;
+		size_t longestRun = 0;
+		for (size_t first = 0; first < count; )
+		{
+			uint64_t group = keys[first] >> 32;
+			size_t last = first + 1;
+			while (last < count && (keys[last] >> 32) == group)
+				last++;
+
+			runs.push_back({ first, last });
+			longestRun = std::max(longestRun, last - first);
+			first = last;
+		}
+
+		quadIndices.Reserve(*vao, longestRun);
+		vao->Bind();
+
+		// Sprites on Texture2DArrays need the array shader, switch only when the kind of texture changes
+		Shader* boundShader = nullptr;
+		for (const auto& [first, last] : runs)
+		{
+			const BatchTexture& texture = textures[(keys[first] >> 32) & 0xFFFF];
+			if (texture.array && arrayShader == nullptr)
+				arrayShader = std::make_shared<Shader>(spriteArrayVertexShader, spriteArrayFragmentShader);
+
+			Shader* runShader = texture.array ? arrayShader.get() : shader.get();
+			if (runShader != boundShader)
+			{
+				runShader->Bind();
+				runShader->SetUniform("viewProjection", viewProjection);
+				runShader->SetUniform("sprite", 0);
+				boundShader = runShader;
+			}
+
+			texture.texture->Bind();
+
+			GLsizei indices = (GLsizei)((last - first) * 6);
+			glDrawElementsBaseVertex(GL_TRIANGLES, indices, GL_UNSIGNED_INT, nullptr, (GLint)(first * 4));
+			RenderStats::Get().AddDraw(DrawMode::Triangles, indices);
+		}
+
+		drawCount = runs.size();
+	}
+}
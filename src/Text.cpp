@@ -0,0 +1,372 @@
+#include <lol/Text.hpp>
+
+#include <algorithm>
+#include <atomic>
+
+#include <glad/glad.h>
+
+#include <lol/Camera.hpp>
+#include <lol/GlyphCache.hpp>
+#include <lol/Shader.hpp>
+#include <lol/Texture.hpp>
+#include <lol/VertexArrayObject.hpp>
+#include <lol/buffers/VertexBuffer.hpp>
+#include <lol/util/Profiler.hpp>
+#include <lol/util/RenderStats.hpp>
+
+namespace lol
+{
+	static const char* textVertexShader = R"(
+#version 330 core
+layout (location = 0) in vec2 position;
+layout (location = 1) in vec2 uv;
+layout (location = 2) in vec4 color;
+
+uniform mat4 viewProjection;
+
+out vec2 fragmentUV;
+out vec4 fragmentColor;
+
+void main()
+{
+	fragmentUV = uv;
+	fragmentColor = color;
+	gl_Position = viewProjection * vec4(position, 0.0, 1.0);
+}
+)";
+
+	static const char* textFragmentShader = R"(
+#version 330 core
+in vec2 fragmentUV;
+in vec4 fragmentColor;
+
+uniform sampler2D glyphs;
+
+out vec4 result;
+
+void main()
+{
+	// Anti-alias the outline over about one pixel on screen, whatever size the text is drawn at
+	float distance = texture(glyphs, fragmentUV).r;
+	float width = max(fwidth(distance) * 0.5, 0.0001);
+	float alpha = smoothstep(0.5 - width, 0.5 + width, distance);
+
+	result = vec4(fragmentColor.rgb, fragmentColor.a * alpha);
+}
+)";
+
+	static std::atomic<uint64_t> nextRevision(1);
+
+	/**
+	 * Decode the UTF-8 sequence starting at `index` and move `index` past it.
+	 * Malformed sequences become U+FFFD.
+	 */
+	static uint32_t DecodeUTF8(const std::string& string, size_t& index)
+	{
+		uint8_t lead = (uint8_t)string[index++];
+		if (lead < 0x80)
+			return lead;
+
+		int length;
+		uint32_t codepoint;
+		if ((lead & 0xE0) == 0xC0)		{ length = 1; codepoint = lead & 0x1F; }
+		else if ((lead & 0xF0) == 0xE0)	{ length = 2; codepoint = lead & 0x0F; }
+		else if ((lead & 0xF8) == 0xF0)	{ length = 3; codepoint = lead & 0x07; }
+		else
+			return 0xFFFD;
+
+		for (int i = 0; i < length; i++)
+		{
+			if (index >= string.size() || ((uint8_t)string[index] & 0xC0) != 0x80)
+				return 0xFFFD;
+
+			codepoint = (codepoint << 6) | ((uint8_t)string[index++] & 0x3F);
+		}
+
+		return codepoint;
+	}
+
+	Text::Text(const std::shared_ptr<GlyphCache>& font, const std::string& string, float size) :
+		font(font), string(string), position(0.0f), size(size), color(1.0f), laidOut(false), bounds{ 0.0f, 0.0f, 0.0f, 0.0f }
+	{
+		Changed();
+	}
+
+	void Text::SetString(const std::string& string)
+	{
+		if (string == this->string)
+			return;
+
+		this->string = string;
+		laidOut = false;
+		Changed();
+	}
+
+	void Text::SetPosition(const glm::vec2& position)
+	{
+		this->position = position;
+		Changed();
+	}
+
+	void Text::SetSize(float size)
+	{
+		this->size = size;
+		Changed();
+	}
+
+	void Text::SetColor(const glm::vec4& color)
+	{
+		this->color = color;
+		Changed();
+	}
+
+	bool Text::Update()
+	{
+		bool stale = !laidOut;
+		for (const Run& run : runs)
+			stale = stale || font->GetGeneration(run.page) != run.generation;
+
+		if (stale)
+		{
+			Layout();
+			Changed();
+			return true;
+		}
+
+		for (const Run& run : runs)
+			font->Touch(run.page);
+
+		return false;
+	}
+
+	Rect Text::GetBounds()
+	{
+		Update();
+
+		float scale = size / font->GetSize();
+		return Rect{ position.x + bounds.x * scale, position.y + bounds.y * scale, bounds.w * scale, bounds.h * scale };
+	}
+
+	void Text::Layout()
+	{
+		LOL_PROFILE_SCOPE("Text::Layout");
+
+		struct Placed
+		{
+			unsigned int page;
+			Quad quad;
+		};
+
+		std::vector<Placed> placed;
+		placed.reserve(string.size());
+
+		glm::vec2 pen(0.0f);
+		uint32_t previous = 0;
+		for (size_t index = 0; index < string.size(); )
+		{
+			uint32_t codepoint = DecodeUTF8(string, index);
+			if (codepoint == '\n')
+			{
+				pen = glm::vec2(0.0f, pen.y - font->GetLineHeight());
+				previous = 0;
+				continue;
+			}
+
+			if (previous != 0)
+				pen.x += font->GetKerning(previous, codepoint);
+
+			// Glyphs that are looked up are touched, so a later glyph never clears the page of an earlier one
+			const Glyph& glyph = font->GetGlyph(codepoint);
+			if (!glyph.empty)
+				placed.push_back({ glyph.page, Quad{ Rect{ pen.x + glyph.bounds.x, pen.y + glyph.bounds.y, glyph.bounds.w, glyph.bounds.h }, glyph.uv } });
+
+			pen.x += glyph.advance;
+			previous = codepoint;
+		}
+
+		std::stable_sort(placed.begin(), placed.end(), [](const Placed& a, const Placed& b) { return a.page < b.page; });
+
+		quads.clear();
+		runs.clear();
+		glm::vec2 lower(0.0f), upper(0.0f);
+		for (size_t i = 0; i < placed.size(); i++)
+		{
+			if (runs.empty() || runs.back().page != placed[i].page)
+				runs.push_back(Run{ placed[i].page, font->GetGeneration(placed[i].page), i, 0 });
+
+			runs.back().count++;
+			quads.push_back(placed[i].quad);
+
+			// The bounds are those of the outlines, without the border of the distance fields
+			const Rect& quad = placed[i].quad.bounds;
+			float spread = (float)font->GetSpread();
+			glm::vec2 quadLower(quad.x + spread, quad.y + spread);
+			glm::vec2 quadUpper(quad.x + quad.w - spread, quad.y + quad.h - spread);
+			lower = (i == 0) ? quadLower : glm::min(lower, quadLower);
+			upper = (i == 0) ? quadUpper : glm::max(upper, quadUpper);
+		}
+
+		bounds = Rect{ lower.x, lower.y, upper.x - lower.x, upper.y - lower.y };
+		laidOut = true;
+	}
+
+	void Text::Changed()
+	{
+		revision = nextRevision.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	TextRenderer::TextRenderer(const std::shared_ptr<Shader>& shader) :
+		shader(shader), viewProjection(1.0f), rebuilt(false)
+	{
+		if (this->shader == nullptr)
+			this->shader = std::make_shared<Shader>(textVertexShader, textFragmentShader);
+
+		vertexBuffer = std::make_shared<VertexBuffer>(sizeof(Vertex) * 4);
+		vertexBuffer->SetLayout({
+			VertexAttribute(Type::Float, 2, false),
+			VertexAttribute(Type::Float, 2, false),
+			VertexAttribute(Type::UByte, 4, true)
+		});
+
+		vao = std::make_shared<VertexArray>();
+		vao->SetVertexBuffer(vertexBuffer);
+		quadIndices.Reserve(*vao, 1024);
+		glBindVertexArray(0);
+	}
+
+	TextRenderer::~TextRenderer()
+	{
+	}
+
+	void TextRenderer::Begin(const CameraBase& camera)
+	{
+		viewProjection = camera.GetProjection() * camera.GetView();
+		entries.clear();
+		fonts.clear();
+	}
+
+	void TextRenderer::Draw(Text& text)
+	{
+		// Start a new frame on each font before its first text is laid out, pages touched from here on are kept until End()
+		GlyphCache* font = text.GetFont().get();
+		if (std::find(fonts.begin(), fonts.end(), font) == fonts.end())
+		{
+			font->NewFrame();
+			fonts.push_back(font);
+		}
+
+		text.Update();
+		entries.push_back(Entry{ &text, text.GetRevision() });
+	}
+
+	void TextRenderer::End()
+	{
+		LOL_PROFILE_SCOPE("TextRenderer::End");
+
+		rebuilt = (entries != built);
+		if (rebuilt)
+		{
+			Rebuild();
+			std::swap(entries, built);
+		}
+
+		for (size_t i = 0; i < batches.size(); i++)
+		{
+			if (i == 0 || batches[i].font != batches[i - 1].font)
+				batches[i].font->UpdateMipmaps();
+		}
+
+		if (batches.empty())
+			return;
+
+		shader->Bind();
+		shader->SetUniform("viewProjection", viewProjection);
+		shader->SetUniform("glyphs", 0);
+		glActiveTexture(GL_TEXTURE0);
+		vao->Bind();
+
+		for (const Batch& batch : batches)
+		{
+			batch.font->GetPage(batch.page)->Bind();
+
+			GLsizei indices = (GLsizei)(batch.count * 6);
+			glDrawElementsBaseVertex(GL_TRIANGLES, indices, GL_UNSIGNED_INT, nullptr, (GLint)(batch.first * 4));
+			RenderStats::Get().AddDraw(DrawMode::Triangles, indices);
+		}
+	}
+
+	void TextRenderer::Rebuild()
+	{
+		LOL_PROFILE_SCOPE("TextRenderer::Rebuild");
+
+		// Count the quads of every page first, so each text can write straight into its batch
+		batches.clear();
+		auto findBatch = [this](GlyphCache* font, unsigned int page) -> Batch&
+		{
+			for (Batch& batch : batches)
+			{
+				if (batch.font == font && batch.page == page)
+					return batch;
+			}
+
+			batches.push_back(Batch{ font, page, 0, 0 });
+			return batches.back();
+		};
+
+		size_t total = 0;
+		for (const Entry& entry : entries)
+		{
+			for (const Text::Run& run : entry.text->runs)
+				findBatch(entry.text->font.get(), run.page).count += run.count;
+
+			total += entry.text->quads.size();
+		}
+
+		std::sort(batches.begin(), batches.end(), [](const Batch& a, const Batch& b) {
+			return a.font < b.font || (a.font == b.font && a.page < b.page);
+		});
+
+		size_t first = 0, largest = 0;
+		for (Batch& batch : batches)
+		{
+			batch.first = first;
+			first += batch.count;
+			largest = std::max(largest, batch.count);
+
+			// Used as the write position while filling in the vertices
+			batch.count = 0;
+		}
+
+		vertices.resize(total * 4);
+		for (const Entry& entry : entries)
+		{
+			const Text& text = *entry.text;
+			float scale = text.size / text.font->GetSize();
+			uint8_t color[4] = { ToUNorm8(text.color.x), ToUNorm8(text.color.y), ToUNorm8(text.color.z), ToUNorm8(text.color.w) };
+
+			for (const Text::Run& run : text.runs)
+			{
+				Batch& batch = findBatch(text.font.get(), run.page);
+				Vertex* vertex = &vertices[(batch.first + batch.count) * 4];
+				batch.count += run.count;
+
+				for (size_t i = run.first; i < run.first + run.count; i++)
+				{
+					const Rect& bounds = text.quads[i].bounds;
+					const Rect& uv = text.quads[i].uv;
+
+					glm::vec2 lower = text.position + glm::vec2(bounds.x, bounds.y) * scale;
+					glm::vec2 upper = text.position + glm::vec2(bounds.x + bounds.w, bounds.y + bounds.h) * scale;
+
+					*vertex++ = Vertex{ lower, glm::vec2(uv.x, uv.y), { color[0], color[1], color[2], color[3] } };
+					*vertex++ = Vertex{ glm::vec2(upper.x, lower.y), glm::vec2(uv.x + uv.w, uv.y), { color[0], color[1], color[2], color[3] } };
+					*vertex++ = Vertex{ upper, glm::vec2(uv.x + uv.w, uv.y + uv.h), { color[0], color[1], color[2], color[3] } };
+					*vertex++ = Vertex{ glm::vec2(lower.x, upper.y), glm::vec2(uv.x, uv.y + uv.h), { color[0], color[1], color[2], color[3] } };
+				}
+			}
+		}
+
+		vertexBuffer->SetData(vertices.data(), vertices.size() * sizeof(Vertex));
+		quadIndices.Reserve(*vao, largest);
+	}
+}
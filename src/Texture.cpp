@@ -1,44 +1,124 @@
 #include <lol/Texture.hpp>
 
+#include <algorithm>
+
 #include <glad/glad.h>
 
 #include <lol/Image.hpp>
+#include <lol/util/Capabilities.hpp>
+#include <lol/util/DeletionQueue.hpp>
+#include <lol/util/Profiler.hpp>
+#include <lol/util/RenderStats.hpp>
+#include <lol/util/ResidencyManager.hpp>
 
 namespace lol
 {
+	/**
+	 * Create a texture object, the bind-to-edit path leaves it bound
+	 */
+	static GLuint CreateTexture(TargetTexture target)
+	{
+		GLuint id = 0;
+		if (UsesDirectStateAccess())
+		{
+			glCreateTextures(NATIVE(target), 1, &id);
+		}
+		else
+		{
+			glGenTextures(1, &id);
+			glBindTexture(NATIVE(target), id);
+		}
+
+		return id;
+	}
+
+	/**
+	 * Set a parameter of a texture, which has to be bound unless direct state access is used
+	 */
+	static void SetParameter(GLuint id, TargetTexture target, GLenum name, GLint value)
+	{
+		if (UsesDirectStateAccess())
+			glTextureParameteri(id, name, value);
+		else
+			glTexParameteri(NATIVE(target), name, value);
+	}
+
 	Texture::Texture(TargetTexture target) :
-		id(0), target(target)
+		id(0), target(target), extent(0), format(TextureFormat::RGB), pixelFormat(PixelFormat::RGB), pixelType(PixelType::UByte),
+		wrap{ TextureWrap::Repeat, TextureWrap::Repeat, TextureWrap::Repeat }, borderColor(0.0f),
+		memoryUsage(0), resident(true), residency(nullptr)
 	{
-		glGenTextures(1, &id);
-		glBindTexture(NATIVE(target), id);
+		id = CreateTexture(target);
 
-		glTexParameteri(NATIVE(target), GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-		glTexParameteri(NATIVE(target), GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		SetParameter(id, target, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		SetParameter(id, target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 	}
 
 	Texture::~Texture()
 	{
-		glDeleteTextures(1, &id);
+		if (residency != nullptr)
+			residency->Untrack(*this);
+
+		if (resident)
+			RenderStats::Get().AddMemory(RenderMemory::Texture, -(int64_t)memoryUsage);
+
+		DeletionQueue::Get().Release(ObjectType::Texture, id);
 	}
 
 	void Texture::SetWrap(TextureWrap s, TextureWrap t, TextureWrap r)
 	{
-		glBindTexture(NATIVE(target), id);
-		glTexParameteri(NATIVE(target), GL_TEXTURE_WRAP_S, NATIVE(s));
-		glTexParameteri(NATIVE(target), GL_TEXTURE_WRAP_T, NATIVE(t));
-		glTexParameteri(NATIVE(target), GL_TEXTURE_WRAP_R, NATIVE(r));
+		wrap[0] = s;
+		wrap[1] = t;
+		wrap[2] = r;
+
+		// An evicted texture gets its parameters in Restore()
+		if (UsesDirectStateAccess() && !resident)
+			return;
+
+		if (!UsesDirectStateAccess())
+			Bind();
+
+		SetParameter(id, target, GL_TEXTURE_WRAP_S, NATIVE(s));
+		SetParameter(id, target, GL_TEXTURE_WRAP_T, NATIVE(t));
+		SetParameter(id, target, GL_TEXTURE_WRAP_R, NATIVE(r));
 	}
 
 	void Texture::SetBorderColor(float r, float g, float b, float a)
 	{
-		glBindTexture(NATIVE(target), id);
+		borderColor = glm::vec4(r, g, b, a);
 
-		glm::vec4 color(r, g, b, a);
-		glTexParameterfv(NATIVE(target), GL_TEXTURE_BORDER_COLOR, &color[0]);
+		if (UsesDirectStateAccess())
+		{
+			if (resident)
+				glTextureParameterfv(id, GL_TEXTURE_BORDER_COLOR, &borderColor[0]);
+
+			return;
+		}
+
+		Bind();
+		glTexParameterfv(NATIVE(target), GL_TEXTURE_BORDER_COLOR, &borderColor[0]);
+	}
+
+	void Texture::GenerateMipmaps()
+	{
+		if (UsesDirectStateAccess())
+		{
+			// Restore() generates the mipmaps of an evicted texture
+			if (resident)
+				glGenerateTextureMipmap(id);
+
+			return;
+		}
+
+		Bind();
+		glGenerateMipmap(NATIVE(target));
 	}
 
 	void Texture::Bind()
 	{
+		MakeResident();
+
+		RenderStats::Get().Add(RenderCounter::TextureBinds);
 		glBindTexture(NATIVE(target), id);
 	}
 
@@ -47,28 +127,335 @@ namespace lol
 		glBindTexture(NATIVE(target), 0);
 	}
 
+	void Texture::Allocate(const void* data, size_t pitch)
+	{
+		LOL_PROFILE_SCOPE("Texture::Allocate");
+		LOL_PROFILE_GPU_SCOPE("Texture::Allocate");
+
+		// Mutable storage can only be specified through a binding, even with direct state access.
+		// Immutable storage (glTextureStorage*) can't be resized without changing the ID.
+		glBindTexture(NATIVE(target), id);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, (GLint)(pitch / SizeOf(pixelFormat, pixelType)));
+
+		switch (target)
+		{
+		case TargetTexture::Texture1D:
+			glTexImage1D(NATIVE(target), 0, NATIVE(format), extent.x, 0, NATIVE(pixelFormat), NATIVE(pixelType), data);
+			break;
+
+		case TargetTexture::Texture2D:
+		case TargetTexture::Array1D:
+		case TargetTexture::Rectangle:
+			glTexImage2D(NATIVE(target), 0, NATIVE(format), extent.x, extent.y, 0, NATIVE(pixelFormat), NATIVE(pixelType), data);
+			break;
+
+		case TargetTexture::Texture3D:
+		case TargetTexture::Array2D:
+			glTexImage3D(NATIVE(target), 0, NATIVE(format), extent.x, extent.y, extent.z, 0, NATIVE(pixelFormat), NATIVE(pixelType), data);
+			break;
+
+		default:
+			assert(false && "lol::Texture::Allocate() does not support this target");
+			break;
+		}
+
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+		// Depth and stencil textures can't have mipmaps generated, limiting them to the base level keeps them complete
+		bool mipmapped = (pixelFormat != PixelFormat::DepthComponent && pixelFormat != PixelFormat::DepthStencil && pixelFormat != PixelFormat::StencilIndex);
+		if (mipmapped)
+			glGenerateMipmap(NATIVE(target));
+		else
+			glTexParameteri(NATIVE(target), GL_TEXTURE_MAX_LEVEL, 0);
+
+		// A full mipmap chain adds roughly a third to the size of the base level
+		size_t baseLevel = (size_t)extent.x * extent.y * extent.z * SizeOf(pixelFormat, pixelType);
+		size_t previousUsage = resident ? memoryUsage : 0;
+		memoryUsage = mipmapped ? baseLevel + baseLevel / 3 : baseLevel;
+
+		if (data != nullptr)
+			RenderStats::Get().Add(RenderCounter::TextureUploadBytes, baseLevel);
+
+		// Restore() calls this while the texture isn't resident, its memory was already given back in Evict()
+		RenderStats::Get().AddMemory(RenderMemory::Texture, (int64_t)memoryUsage - (int64_t)previousUsage);
+	}
+
+	void Texture::Reallocate(const glm::uvec3& newExtent)
+	{
+		// Restores the texture first if it was evicted, its old contents don't matter but the ID has to exist
+		Bind();
+
+		// The manager remembers the size the texture had when it was tracked
+		ResidencyManager* manager = residency;
+		if (manager != nullptr)
+			manager->Untrack(*this);
+
+		extent = newExtent;
+		Allocate(nullptr);
+
+		if (manager != nullptr)
+			manager->Track(*this);
+	}
+
+	void Texture::Evict()
+	{
+		if (!resident)
+			return;
+
+		evicted.resize((size_t)extent.x * extent.y * extent.z * SizeOf(pixelFormat, pixelType));
+
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		if (UsesDirectStateAccess())
+		{
+			glGetTextureImage(id, 0, NATIVE(pixelFormat), NATIVE(pixelType), (GLsizei)evicted.size(), evicted.data());
+		}
+		else
+		{
+			glBindTexture(NATIVE(target), id);
+			glGetTexImage(NATIVE(target), 0, NATIVE(pixelFormat), NATIVE(pixelType), evicted.data());
+		}
+		glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+		// Draws recorded before the eviction may still use it
+		DeletionQueue::Get().Release(ObjectType::Texture, id);
+		id = 0;
+		resident = false;
+
+		RenderStats::Get().AddMemory(RenderMemory::Texture, -(int64_t)memoryUsage);
+	}
+
+	void Texture::Restore()
+	{
+		if (resident)
+			return;
+
+		id = CreateTexture(target);
+
+		SetParameter(id, target, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		SetParameter(id, target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		SetParameter(id, target, GL_TEXTURE_WRAP_S, NATIVE(wrap[0]));
+		SetParameter(id, target, GL_TEXTURE_WRAP_T, NATIVE(wrap[1]));
+		SetParameter(id, target, GL_TEXTURE_WRAP_R, NATIVE(wrap[2]));
+		if (UsesDirectStateAccess())
+			glTextureParameterfv(id, GL_TEXTURE_BORDER_COLOR, &borderColor[0]);
+		else
+			glTexParameterfv(NATIVE(target), GL_TEXTURE_BORDER_COLOR, &borderColor[0]);
+
+		Allocate(evicted.data());
+
+		evicted.clear();
+		evicted.shrink_to_fit();
+		resident = true;
+	}
+
+	void Texture::MakeResident()
+	{
+		if (residency != nullptr)
+			residency->Touch(*this);
+		else if (!resident)
+			Restore();
+	}
+
 
 	Texture2D::Texture2D(const Image& image, TextureFormat texFormat) :
 		Texture(TargetTexture::Texture2D)
 	{
-		glm::uvec2 imageSize = image.GetDimensions();
-		uint8_t* pixels = image.GetPixels();
-		glTexImage2D(NATIVE(target), 0, NATIVE(texFormat), imageSize.x, imageSize.y, 0, NATIVE(image.GetPixelFormat()), NATIVE(image.GetPixelType()), pixels);
-		glGenerateMipmap(NATIVE(target));
+		extent = glm::uvec3(image.GetDimensions(), 1);
+		format = texFormat;
+		pixelFormat = image.GetPixelFormat();
+		pixelType = image.GetPixelType();
+
+		Allocate(image.GetPixels(), image.GetPitch());
+	}
+
+	Texture2D::Texture2D(unsigned int width, unsigned int height, TextureFormat texFormat, PixelFormat pixFormat, PixelType pixType) :
+		Texture(TargetTexture::Texture2D)
+	{
+		extent = glm::uvec3(width, height, 1);
+		format = texFormat;
+		pixelFormat = pixFormat;
+		pixelType = pixType;
+
+		Allocate(nullptr);
+	}
+
+	void Texture2D::Update(unsigned int x, unsigned int y, unsigned int width, unsigned int height, const void* data, PixelFormat pixFormat, PixelType pixType, size_t pitch)
+	{
+		if (UsesDirectStateAccess())
+			MakeResident();
+		else
+			Bind();
+
+		// The row length is given explicitly, so the default alignment of 4 isn't needed
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, (GLint)(pitch / SizeOf(pixFormat, pixType)));
+		if (UsesDirectStateAccess())
+			glTextureSubImage2D(id, 0, x, y, width, height, NATIVE(pixFormat), NATIVE(pixType), data);
+		else
+			glTexSubImage2D(NATIVE(target), 0, x, y, width, height, NATIVE(pixFormat), NATIVE(pixType), data);
+		RenderStats::Get().Add(RenderCounter::TextureUploadBytes, (size_t)width * height * SizeOf(pixFormat, pixType));
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	}
+
+	void Texture2D::Update(unsigned int x, unsigned int y, const Image& image)
+	{
+		const glm::uvec2& imageSize = image.GetDimensions();
+		Update(x, y, imageSize.x, imageSize.y, image.GetPixels(), image.GetPixelFormat(), image.GetPixelType(), image.GetPitch());
+	}
+
+	void Texture2D::Resize(unsigned int width, unsigned int height)
+	{
+		if (extent.x == width && extent.y == height)
+			return;
+
+		Reallocate(glm::uvec3(width, height, 1));
 	}
 
 
 	Texture1D::Texture1D(unsigned int width, const void* data, PixelFormat pixFormat, PixelType pixType, TextureFormat texFormat) :
 		Texture(TargetTexture::Texture1D)
 	{
-		glTexImage1D(NATIVE(target), 0, NATIVE(texFormat), width, 0, NATIVE(pixFormat), NATIVE(pixType), data);
-		glGenerateMipmap(NATIVE(target));
+		extent = glm::uvec3(width, 1, 1);
+		format = texFormat;
+		pixelFormat = pixFormat;
+		pixelType = pixType;
+
+		Allocate(data);
 	}
 
 	Texture1D::Texture1D(const Image& image, TextureFormat texFormat) :
 		Texture(TargetTexture::Texture1D)
 	{
-		glTexImage1D(NATIVE(target), 0, NATIVE(texFormat), image.GetDimensions().x, 0, NATIVE(image.GetPixelFormat()), NATIVE(image.GetPixelType()), image.GetPixels());
-		glGenerateMipmap(NATIVE(target));
+		extent = glm::uvec3(image.GetDimensions().x, 1, 1);
+		format = texFormat;
+		pixelFormat = image.GetPixelFormat();
+		pixelType = image.GetPixelType();
+
+		Allocate(image.GetPixels());
+	}
+
+
+	TextureArray::TextureArray(TargetTexture target, unsigned int layers) :
+		Texture(target), layers(layers)
+	{
+		// Hand out the lowest layers first
+		freeLayers.reserve(layers);
+		for (unsigned int layer = layers; layer > 0; layer--)
+			freeLayers.push_back(layer - 1);
+	}
+
+	int TextureArray::AllocateLayer()
+	{
+		if (freeLayers.empty())
+			return -1;
+
+		unsigned int layer = freeLayers.back();
+		freeLayers.pop_back();
+
+		return layer;
+	}
+
+	void TextureArray::FreeLayer(unsigned int layer)
+	{
+		assert(layer < layers && "lol::TextureArray::FreeLayer() layer is out of range");
+		assert(std::find(freeLayers.begin(), freeLayers.end(), layer) == freeLayers.end() && "lol::TextureArray::FreeLayer() layer was already freed");
+		freeLayers.push_back(layer);
+	}
+
+
+	Texture2DArray::Texture2DArray(unsigned int width, unsigned int height, unsigned int layers, TextureFormat texFormat, PixelFormat pixFormat, PixelType pixType) :
+		TextureArray(TargetTexture::Array2D, layers)
+	{
+		extent = glm::uvec3(width, height, layers);
+		format = texFormat;
+		pixelFormat = pixFormat;
+		pixelType = pixType;
+
+		Allocate(nullptr);
+	}
+
+	void Texture2DArray::SetLayer(unsigned int layer, const void* data, PixelFormat pixFormat, PixelType pixType)
+	{
+		if (UsesDirectStateAccess())
+			MakeResident();
+		else
+			Bind();
+
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		if (UsesDirectStateAccess())
+			glTextureSubImage3D(id, 0, 0, 0, layer, extent.x, extent.y, 1, NATIVE(pixFormat), NATIVE(pixType), data);
+		else
+			glTexSubImage3D(NATIVE(target), 0, 0, 0, layer, extent.x, extent.y, 1, NATIVE(pixFormat), NATIVE(pixType), data);
+		RenderStats::Get().Add(RenderCounter::TextureUploadBytes, (size_t)extent.x * extent.y * SizeOf(pixFormat, pixType));
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	}
+
+	void Texture2DArray::SetLayer(unsigned int layer, const Image& image)
+	{
+		const glm::uvec2& imageSize = image.GetDimensions();
+		glm::uvec2 region = glm::min(imageSize, GetDimensions());
+
+		if (UsesDirectStateAccess())
+			MakeResident();
+		else
+			Bind();
+
+		// The image may be wider than the layer or have padded rows, so the row length has to be given explicitly
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, (GLint)(image.GetPitch() / SizeOf(image.GetPixelFormat(), image.GetPixelType())));
+		if (UsesDirectStateAccess())
+			glTextureSubImage3D(id, 0, 0, 0, layer, region.x, region.y, 1, NATIVE(image.GetPixelFormat()), NATIVE(image.GetPixelType()), image.GetPixels());
+		else
+			glTexSubImage3D(NATIVE(target), 0, 0, 0, layer, region.x, region.y, 1, NATIVE(image.GetPixelFormat()), NATIVE(image.GetPixelType()), image.GetPixels());
+		RenderStats::Get().Add(RenderCounter::TextureUploadBytes, (size_t)region.x * region.y * SizeOf(image.GetPixelFormat(), image.GetPixelType()));
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	}
+
+
+	Texture1DArray::Texture1DArray(unsigned int width, unsigned int layers, TextureFormat texFormat, PixelFormat pixFormat, PixelType pixType) :
+		TextureArray(TargetTexture::Array1D, layers)
+	{
+		extent = glm::uvec3(width, layers, 1);
+		format = texFormat;
+		pixelFormat = pixFormat;
+		pixelType = pixType;
+
+		Allocate(nullptr);
+	}
+
+	void Texture1DArray::SetLayer(unsigned int layer, const void* data, PixelFormat pixFormat, PixelType pixType)
+	{
+		if (UsesDirectStateAccess())
+		{
+			MakeResident();
+			glTextureSubImage2D(id, 0, 0, layer, extent.x, 1, NATIVE(pixFormat), NATIVE(pixType), data);
+		}
+		else
+		{
+			Bind();
+			glTexSubImage2D(NATIVE(target), 0, 0, layer, extent.x, 1, NATIVE(pixFormat), NATIVE(pixType), data);
+		}
+		RenderStats::Get().Add(RenderCounter::TextureUploadBytes, (size_t)extent.x * SizeOf(pixFormat, pixType));
+	}
+
+	void Texture1DArray::SetLayer(unsigned int layer, const Image& image)
+	{
+		unsigned int width = std::min(image.GetDimensions().x, extent.x);
+
+		if (UsesDirectStateAccess())
+		{
+			MakeResident();
+			glTextureSubImage2D(id, 0, 0, layer, width, 1, NATIVE(image.GetPixelFormat()), NATIVE(image.GetPixelType()), image.GetPixels());
+		}
+		else
+		{
+			Bind();
+			glTexSubImage2D(NATIVE(target), 0, 0, layer, width, 1, NATIVE(image.GetPixelFormat()), NATIVE(image.GetPixelType()), image.GetPixels());
+		}
+		RenderStats::Get().Add(RenderCounter::TextureUploadBytes, (size_t)width * SizeOf(image.GetPixelFormat(), image.GetPixelType()));
 	}
-}
\ No newline at end of file
+}
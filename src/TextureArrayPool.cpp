@@ -0,0 +1,78 @@
+#include <lol/TextureArrayPool.hpp>
+
+#include <assert.h>
+
+#include <lol/Image.hpp>
+
+namespace lol
+{
+	TextureArrayPool::TextureArrayPool(unsigned int layersPerArray) :
+		layersPerArray(layersPerArray)
+	{
+		assert(layersPerArray > 0 && "lol::TextureArrayPool::TextureArrayPool() arrays need at least one layer");
+	}
+
+	TextureLayer TextureArrayPool::Insert(const Image& image, TextureFormat texFormat)
+	{
+		const glm::uvec2& imageSize = image.GetDimensions();
+		std::vector<Entry>& candidates = arrays[Key(imageSize.x, imageSize.y, texFormat)];
+
+		int layer = -1;
+		Entry* entry = nullptr;
+		for (Entry& candidate : candidates)
+		{
+			layer = candidate.texture->AllocateLayer();
+			if (layer != -1)
+			{
+				entry = &candidate;
+				break;
+			}
+		}
+
+		// All arrays of this size and format are full
+		if (entry == nullptr)
+		{
+			candidates.push_back(Entry{
+				std::make_shared<Texture2DArray>(imageSize.x, imageSize.y, layersPerArray, texFormat, image.GetPixelFormat(), image.GetPixelType()),
+				false
+			});
+
+			entry = &candidates.back();
+			layer = entry->texture->AllocateLayer();
+		}
+
+		entry->texture->SetLayer(layer, image);
+		entry->dirty = true;
+
+		return TextureLayer{ entry->texture, (unsigned int)layer };
+	}
+
+	void TextureArrayPool::Remove(const TextureLayer& layer)
+	{
+		layer.texture->FreeLayer(layer.layer);
+	}
+
+	void TextureArrayPool::UpdateMipmaps()
+	{
+		for (auto& [key, entries] : arrays)
+		{
+			for (Entry& entry : entries)
+			{
+				if (!entry.dirty)
+					continue;
+
+				entry.texture->GenerateMipmaps();
+				entry.dirty = false;
+			}
+		}
+	}
+
+	size_t TextureArrayPool::GetArrayCount() const
+	{
+		size_t count = 0;
+		for (const auto& [key, entries] : arrays)
+			count += entries.size();
+
+		return count;
+	}
+}
@@ -0,0 +1,113 @@
+#include <lol/TextureAtlas.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <cstring>
+
+#include <lol/Image.hpp>
+#include <lol/util/Exceptions.hpp>
+
+namespace lol
+{
+	TextureAtlas::TextureAtlas(unsigned int width, unsigned int height, unsigned int padding, TextureFormat texFormat) :
+		pageSize(width, height), padding(padding), format(texFormat)
+	{
+	}
+
+	AtlasRegion TextureAtlas::Insert(const Image& image)
+	{
+		const glm::uvec2& imageSize = image.GetDimensions();
+		if (imageSize.x == 0 || imageSize.y == 0)
+			return AtlasRegion{ AtlasRegion::NoPage, Rect{ 0.0f, 0.0f, 0.0f, 0.0f }, Rect{ 0.0f, 0.0f, 0.0f, 0.0f } };
+
+		glm::uvec2 paddedSize = imageSize + glm::uvec2(2 * padding);
+		if (paddedSize.x > pageSize.x || paddedSize.y > pageSize.y)
+			throw ImageTooLargeException(imageSize.x, imageSize.y);
+
+		glm::uvec2 position;
+		size_t pageIndex = 0;
+		for (; pageIndex < pages.size(); pageIndex++)
+		{
+			if (pages[pageIndex].packer.Insert(paddedSize.x, paddedSize.y, position))
+				break;
+		}
+
+		// No existing page had enough space left
+		if (pageIndex == pages.size())
+		{
+			pages.push_back(Page{
+				std::make_shared<Texture2D>(pageSize.x, pageSize.y, format, PixelFormat::RGBA, PixelType::UByte),
+				SkylinePacker(pageSize.x, pageSize.y),
+				false
+			});
+
+			pages.back().texture->SetWrap(TextureWrap::ClampToEdge, TextureWrap::ClampToEdge);
+			pages.back().packer.Insert(paddedSize.x, paddedSize.y, position);
+		}
+
+		Upload(pages[pageIndex], position, image);
+
+		Rect bounds{ (float)(position.x + padding), (float)(position.y + padding), (float)imageSize.x, (float)imageSize.y };
+		Rect uv{ bounds.x / pageSize.x, bounds.y / pageSize.y, bounds.w / pageSize.x, bounds.h / pageSize.y };
+
+		return AtlasRegion{ (unsigned int)pageIndex, bounds, uv };
+	}
+
+	std::vector<AtlasRegion> TextureAtlas::Insert(const std::vector<const Image*>& images)
+	{
+		std::vector<size_t> order(images.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [&images](size_t a, size_t b) {
+			return images[a]->GetDimensions().y > images[b]->GetDimensions().y;
+		});
+
+		std::vector<AtlasRegion> regions(images.size());
+		for (size_t index : order)
+			regions[index] = Insert(*images[index]);
+
+		UpdateMipmaps();
+		return regions;
+	}
+
+	void TextureAtlas::UpdateMipmaps()
+	{
+		for (Page& page : pages)
+		{
+			if (!page.dirty)
+				continue;
+
+			page.texture->GenerateMipmaps();
+			page.dirty = false;
+		}
+	}
+
+	void TextureAtlas::Upload(Page& page, const glm::uvec2& position, const Image& image)
+	{
+		const glm::uvec2& imageSize = image.GetDimensions();
+		glm::uvec2 paddedSize = imageSize + glm::uvec2(2 * padding);
+
+		size_t pixelSize = SizeOf(image.GetPixelFormat(), image.GetPixelType());
+		size_t rowSize = imageSize.x * pixelSize;
+		size_t paddedRowSize = paddedSize.x * pixelSize;
+		scratch.resize(paddedRowSize * paddedSize.y);
+
+		// Extrude the edge pixels of the image into the gutter
+		for (unsigned int y = 0; y < paddedSize.y; y++)
+		{
+			unsigned int sourceY = std::min(std::max(y, padding) - padding, imageSize.y - 1);
+			const uint8_t* source = image.GetRow(sourceY);
+			uint8_t* destination = scratch.data() + y * paddedRowSize;
+
+			for (unsigned int x = 0; x < padding; x++)
+			{
+				std::memcpy(destination + x * pixelSize, source, pixelSize);
+				std::memcpy(destination + (padding + imageSize.x + x) * pixelSize, source + rowSize - pixelSize, pixelSize);
+			}
+
+			std::memcpy(destination + padding * pixelSize, source, rowSize);
+		}
+
+		page.texture->Update(position.x, position.y, paddedSize.x, paddedSize.y, scratch.data(), image.GetPixelFormat(), image.GetPixelType());
+		page.dirty = true;
+	}
+}
@@ -3,31 +3,77 @@
 #include <assert.h>
 #include <glad/glad.h>
 
+#include <lol/util/Capabilities.hpp>
+#include <lol/util/DeletionQueue.hpp>
+#include <lol/util/RenderStats.hpp>
+
 namespace lol
 {
-
-	VertexArray::VertexArray()
+	/**
+	 * Create a VAO. glGenVertexArrays() only reserves a name, the object only exists once
+	 * it was bound, and direct state access calls fail on names without an object. Binding
+	 * it once keeps it usable if direct state access is turned on later.
+	 */
+	static GLuint CreateVertexArray()
 	{
+		GLuint id = 0;
+		if (UsesDirectStateAccess())
+		{
+			glCreateVertexArrays(1, &id);
+			return id;
+		}
+
+		GLint previous = 0;
+		glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &previous);
+
 		glGenVertexArrays(1, &id);
+		glBindVertexArray(id);
+		glBindVertexArray((GLuint)previous);
+		return id;
 	}
 
-	VertexArray::VertexArray(const std::shared_ptr<VertexBuffer>& vertexBuffer, const std::shared_ptr<ElementBuffer>& elementBuffer) :
-		id(0)
+	VertexArray::VertexArray() :
+		id(CreateVertexArray())
 	{
-		glGenVertexArrays(1, &id);
+	}
 
+	VertexArray::VertexArray(const std::shared_ptr<VertexBuffer>& vertexBuffer, const std::shared_ptr<ElementBuffer>& elementBuffer) :
+		id(CreateVertexArray())
+	{
 		SetVertexBuffer(vertexBuffer);
 		SetElementBuffer(elementBuffer);
 
-		glBindVertexArray(0);
+		// Only the bind-to-edit path left the VAO bound
+		if (!UsesDirectStateAccess())
+			glBindVertexArray(0);
 	}
 	VertexArray::~VertexArray()
 	{
-		glDeleteVertexArrays(1, &id);
+		DeletionQueue::Get().Release(ObjectType::VertexArray, id);
 	}
 
 	void VertexArray::SetVertexBuffer(const std::shared_ptr<VertexBuffer>& buffer)
 	{
+		if (UsesDirectStateAccess())
+		{
+			// All attributes are read from binding point 0
+			const BufferLayout& layout = buffer->GetLayout();
+			glVertexArrayVertexBuffer(id, 0, buffer->id, 0, layout.GetStride());
+
+			unsigned int index = 0;
+			for (const VertexAttribute& attribute : layout)
+			{
+				glEnableVertexArrayAttrib(id, index);
+				glVertexArrayAttribFormat(id, index, attribute.size, NATIVE(attribute.type), attribute.normalized, (GLuint)attribute.offset);
+				glVertexArrayAttribBinding(id, index, 0);
+
+				index++;
+			}
+
+			vertexBuffer = buffer;
+			return;
+		}
+
 		glBindVertexArray(id);
 		buffer->Bind();
 
@@ -47,6 +93,13 @@ namespace lol
 
 	void VertexArray::SetElementBuffer(const std::shared_ptr<ElementBuffer>& buffer)
 	{
+		if (UsesDirectStateAccess())
+		{
+			glVertexArrayElementBuffer(id, buffer->id);
+			elementBuffer = buffer;
+			return;
+		}
+
 		glBindVertexArray(id);
 		buffer->Bind();
 
@@ -55,6 +108,7 @@ namespace lol
 
 	void VertexArray::Bind()
 	{
+		RenderStats::Get().Add(RenderCounter::VertexArrayBinds);
 		glBindVertexArray(id);
 	}
 
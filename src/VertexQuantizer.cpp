@@ -0,0 +1,260 @@
+#include <lol/util/VertexQuantizer.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <lol/util/Profiler.hpp>
+
+namespace lol
+{
+	static const char* dequantizeSource = R"(
+vec4 lolDequantize(vec4 value, vec4 scale, vec4 offset)
+{
+	return offset + scale * value;
+}
+
+vec3 lolOctahedralDecode(vec2 value)
+{
+	vec3 normal = vec3(value, 1.0 - abs(value.x) - abs(value.y));
+	if (normal.z < 0.0)
+		normal.xy = (1.0 - abs(normal.yx)) * vec2(normal.x >= 0.0 ? 1.0 : -1.0, normal.y >= 0.0 ? 1.0 : -1.0);
+
+	return normalize(normal);
+}
+)";
+
+	/**
+	 * Convert a float to a half float, rounding to nearest even
+	 */
+	static uint16_t ToHalf(float value)
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+
+		uint32_t sign = (bits >> 16) & 0x8000;
+		uint32_t exponent = (bits >> 23) & 0xFF;
+		uint32_t mantissa = bits & 0x7FFFFF;
+
+		// Infinity and NaN
+		if (exponent == 0xFF)
+			return (uint16_t)(sign | 0x7C00 | (mantissa ? 0x200 : 0));
+
+		int halfExponent = (int)exponent - 127 + 15;
+		if (halfExponent >= 31)
+			return (uint16_t)(sign | 0x7C00);
+
+		uint32_t half, remainder, halfway;
+		if (halfExponent <= 0)
+		{
+			// Too small for a normal half, becomes a subnormal or zero
+			if (halfExponent < -10)
+				return (uint16_t)sign;
+
+			mantissa |= 0x800000;
+			uint32_t shift = (uint32_t)(14 - halfExponent);
+			half = mantissa >> shift;
+			remainder = mantissa & ((1u << shift) - 1);
+			halfway = 1u << (shift - 1);
+		}
+		else
+		{
+			half = ((uint32_t)halfExponent << 10) | (mantissa >> 13);
+			remainder = mantissa & 0x1FFF;
+			halfway = 0x1000;
+		}
+
+		// A carry out of the mantissa correctly increases the exponent
+		if (remainder > halfway || (remainder == halfway && (half & 1)))
+			half++;
+
+		return (uint16_t)(sign | half);
+	}
+
+	static uint32_t ToUNorm(float value, uint32_t max)
+	{
+		return (uint32_t)std::lround(std::min(std::max(value, 0.0f), 1.0f) * max);
+	}
+
+	template<typename T>
+	static void Write(uint8_t*& destination, T value)
+	{
+		std::memcpy(destination, &value, sizeof(T));
+		destination += sizeof(T);
+	}
+
+	VertexQuantizer::VertexQuantizer(const std::initializer_list<QuantizedAttribute>& attributes) :
+		VertexQuantizer(std::vector<QuantizedAttribute>(attributes))
+	{ }
+
+	VertexQuantizer::VertexQuantizer(const std::vector<QuantizedAttribute>& attributes) :
+		attributes(attributes), sourceStride(0)
+	{
+		for (const QuantizedAttribute& attribute : this->attributes)
+		{
+			assert(attribute.components >= 1 && attribute.components <= 4 && "lol::VertexQuantizer attributes need 1 to 4 components");
+			assert((attribute.encoding != AttributeEncoding::Octahedral16 || attribute.components == 3) && "lol::VertexQuantizer Octahedral16 needs 3 components");
+			assert((attribute.encoding != AttributeEncoding::Packed1010102 || attribute.components >= 3) && "lol::VertexQuantizer Packed1010102 needs 3 or 4 components");
+
+			sourceStride += attribute.components;
+		}
+	}
+
+	QuantizedVertices VertexQuantizer::Quantize(const std::vector<float>& vertices) const
+	{
+		LOL_PROFILE_SCOPE("VertexQuantizer::Quantize");
+
+		assert(sourceStride > 0 && vertices.size() % sourceStride == 0 && "lol::VertexQuantizer::Quantize() vertices don't match the attributes");
+		size_t count = vertices.size() / sourceStride;
+
+		// Components that are only there for padding, reading as 0 or 1 after dequantization
+		auto padding = [](unsigned int component) { return component == 3 ? 1.0f : 0.0f; };
+
+		std::vector<VertexAttribute> layout;
+		std::vector<Dequantization> dequantization;
+		std::vector<unsigned int> components;		// Components written per attribute, including padding
+		unsigned int offset = 0;
+		for (const QuantizedAttribute& attribute : attributes)
+		{
+			Dequantization parameters{ glm::vec4(1.0f), glm::vec4(0.0f) };
+			unsigned int written = attribute.components;
+
+			switch (attribute.encoding)
+			{
+			case AttributeEncoding::Float:
+				layout.push_back(VertexAttribute(Type::Float, written, false));
+				break;
+
+			case AttributeEncoding::Bounds16:
+			{
+				glm::vec4 lower(0.0f), upper(0.0f);
+				for (unsigned int c = 0; c < attribute.components; c++)
+				{
+					lower[c] = upper[c] = count > 0 ? vertices[offset + c] : 0.0f;
+					for (size_t i = 1; i < count; i++)
+					{
+						lower[c] = std::min(lower[c], vertices[i * sourceStride + offset + c]);
+						upper[c] = std::max(upper[c], vertices[i * sourceStride + offset + c]);
+					}
+
+					parameters.scale[c] = upper[c] - lower[c];
+					parameters.offset[c] = lower[c];
+				}
+
+				written = (attribute.components + 1) & ~1u;
+				layout.push_back(VertexAttribute(Type::UShort, written, true));
+				break;
+			}
+
+			case AttributeEncoding::Octahedral16:
+				written = 2;
+				layout.push_back(VertexAttribute(Type::Short, written, true));
+				break;
+
+			// The unsigned type is normalized to [0, 1] by every OpenGL version, the signed one
+			// isn't, so the components are stored as unsigned and mapped back to [-1, 1] here
+			case AttributeEncoding::Packed1010102:
+				written = 4;
+				parameters = Dequantization{ glm::vec4(2.0f), glm::vec4(-1.0f) };
+				layout.push_back(VertexAttribute(Type::UInt2101010, written, true));
+				break;
+
+			case AttributeEncoding::Half:
+				written = (attribute.components + 1) & ~1u;
+				layout.push_back(VertexAttribute(Type::Half, written, false));
+				break;
+
+			case AttributeEncoding::UNorm8:
+				written = 4;
+				layout.push_back(VertexAttribute(Type::UByte, written, true));
+				break;
+			}
+
+			dequantization.push_back(parameters);
+			components.push_back(written);
+			offset += attribute.components;
+		}
+
+		QuantizedVertices result{ {}, BufferLayout(layout), dequantization, count };
+		result.data.resize(count * result.layout.GetStride());
+
+		uint8_t* destination = result.data.data();
+		for (size_t i = 0; i < count; i++)
+		{
+			const float* source = vertices.data() + i * sourceStride;
+			for (size_t a = 0; a < attributes.size(); a++)
+			{
+				const QuantizedAttribute& attribute = attributes[a];
+				const Dequantization& parameters = result.dequantization[a];
+
+				switch (attribute.encoding)
+				{
+				case AttributeEncoding::Float:
+					for (unsigned int c = 0; c < attribute.components; c++)
+						Write<float>(destination, source[c]);
+					break;
+
+				case AttributeEncoding::Bounds16:
+					for (unsigned int c = 0; c < components[a]; c++)
+					{
+						if (c >= attribute.components)
+							Write<uint16_t>(destination, (uint16_t)ToUNorm(padding(c), 0xFFFF));
+						else if (parameters.scale[c] == 0.0f)
+							Write<uint16_t>(destination, 0);
+						else
+							Write<uint16_t>(destination, (uint16_t)ToUNorm((source[c] - parameters.offset[c]) / parameters.scale[c], 0xFFFF));
+					}
+					break;
+
+				case AttributeEncoding::Octahedral16:
+				{
+					// Project onto the octahedron and fold the lower half over the upper one
+					float length = std::abs(source[0]) + std::abs(source[1]) + std::abs(source[2]);
+					glm::vec2 folded = length > 0.0f ? glm::vec2(source[0], source[1]) / length : glm::vec2(0.0f);
+					if (source[2] < 0.0f)
+					{
+						folded = glm::vec2(
+							(1.0f - std::abs(folded.y)) * (folded.x >= 0.0f ? 1.0f : -1.0f),
+							(1.0f - std::abs(folded.x)) * (folded.y >= 0.0f ? 1.0f : -1.0f)
+						);
+					}
+
+					Write<int16_t>(destination, (int16_t)std::lround(std::min(std::max(folded.x, -1.0f), 1.0f) * 32767.0f));
+					Write<int16_t>(destination, (int16_t)std::lround(std::min(std::max(folded.y, -1.0f), 1.0f) * 32767.0f));
+					break;
+				}
+
+				case AttributeEncoding::Packed1010102:
+				{
+					uint32_t packed = 0;
+					for (unsigned int c = 0; c < 3; c++)
+						packed |= ToUNorm(source[c] * 0.5f + 0.5f, 1023) << (c * 10);
+
+					uint32_t sign = (attribute.components < 4 || source[3] >= 0.0f) ? 3 : 0;
+					Write<uint32_t>(destination, packed | (sign << 30));
+					break;
+				}
+
+				case AttributeEncoding::Half:
+					for (unsigned int c = 0; c < components[a]; c++)
+						Write<uint16_t>(destination, ToHalf(c < attribute.components ? source[c] : padding(c)));
+					break;
+
+				case AttributeEncoding::UNorm8:
+					for (unsigned int c = 0; c < components[a]; c++)
+						Write<uint8_t>(destination, (uint8_t)ToUNorm(c < attribute.components ? source[c] : padding(c), 0xFF));
+					break;
+				}
+
+				source += attribute.components;
+			}
+		}
+
+		return result;
+	}
+
+	const char* VertexQuantizer::GetShaderSource()
+	{
+		return dequantizeSource;
+	}
+}
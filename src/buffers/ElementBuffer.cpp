@@ -1,10 +1,24 @@
 #include <lol/buffers/ElementBuffer.hpp>
 
+#include <lol/util/Profiler.hpp>
+
 namespace lol
 {
 	ElementBuffer::ElementBuffer(const std::vector<unsigned int>& elements, Usage usage) :
-		Buffer(BufferType::ElementArray), count(elements.size())
+		Buffer(BufferType::ElementArray), count(elements.size()), indexType(Type::UInt)
 	{
-		glBufferData(NATIVE(type), elements.size() * sizeof(unsigned int), elements.data(), NATIVE(usage));
+		LOL_PROFILE_SCOPE("ElementBuffer::ElementBuffer");
+
+		Reallocate(elements.data(), elements.size() * sizeof(unsigned int), usage);
+	}
+
+	ElementBuffer::ElementBuffer(const void* data, size_t count, Type indexType, Usage usage) :
+		Buffer(BufferType::ElementArray), count(count), indexType(indexType)
+	{
+		LOL_PROFILE_SCOPE("ElementBuffer::ElementBuffer");
+
+		assert((indexType == Type::UByte || indexType == Type::UShort || indexType == Type::UInt) && "lol::ElementBuffer indices have to be unsigned integers");
+
+		Reallocate(data, count * SizeOf(indexType), usage);
 	}
 }
\ No newline at end of file
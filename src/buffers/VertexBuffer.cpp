@@ -1,5 +1,7 @@
 #include <lol/buffers/VertexBuffer.hpp>
 
+#include <lol/util/Profiler.hpp>
+
 namespace lol
 {
 	BufferLayout::BufferLayout(const std::initializer_list<VertexAttribute>& attributes) :
@@ -9,7 +11,17 @@ namespace lol
 		for (VertexAttribute& attribute : layout)
 		{
 			attribute.offset += stride;
-			stride += (attribute.size * SizeOf(attribute.type));
+			stride += (int)attribute.GetBytes();
+		}
+	}
+
+	BufferLayout::BufferLayout(const std::vector<VertexAttribute>& attributes) :
+		layout(attributes), stride(0)
+	{
+		for (VertexAttribute& attribute : layout)
+		{
+			attribute.offset += stride;
+			stride += (int)attribute.GetBytes();
 		}
 	}
 
@@ -17,6 +29,27 @@ namespace lol
 	VertexBuffer::VertexBuffer(const std::vector<float>& data, Usage usage) :
 		Buffer(BufferType::Array), layout{}
 	{
-		glBufferData(NATIVE(type), data.size() * sizeof(float), data.data(), NATIVE(usage));
+		LOL_PROFILE_SCOPE("VertexBuffer::VertexBuffer");
+
+		Reallocate(data.data(), data.size() * sizeof(float), usage);
+	}
+
+	VertexBuffer::VertexBuffer(size_t bytes, Usage usage) :
+		Buffer(BufferType::Array), layout{}
+	{
+		Reallocate(nullptr, bytes, usage);
+	}
+
+	VertexBuffer::VertexBuffer(const void* data, size_t bytes, Usage usage) :
+		Buffer(BufferType::Array), layout{}
+	{
+		LOL_PROFILE_SCOPE("VertexBuffer::VertexBuffer");
+
+		Reallocate(data, bytes, usage);
+	}
+
+	void VertexBuffer::SetData(const void* data, size_t bytes, Usage usage)
+	{
+		Reallocate(data, bytes, usage);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,217 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <lol/util/Exceptions.hpp>
+#include <lol/util/Hash.hpp>
+#include <lol/util/MeshConverter.hpp>
+#include <lol/util/ObjectPool.hpp>
+#include <lol/util/RenderStats.hpp>
+#include <lol/util/SkylinePacker.hpp>
+#include <lol/util/VertexQuantizer.hpp>
+
+// Known-answer tests for the parts of lol that don't need an OpenGL context.
+// Unlike assert() the checks stay active in release builds, and every failure is reported.
+static int failures = 0;
+
+#define CHECK(condition) \
+	do { if (!(condition)) { std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); failures++; } } while (false)
+
+template<typename T>
+static T ReadAt(const std::vector<uint8_t>& data, size_t offset)
+{
+	T value;
+	std::memcpy(&value, data.data() + offset, sizeof(T));
+	return value;
+}
+
+// Reference values of MurmurHash3_x64_128, low is h1 and high is h2
+static void TestHash()
+{
+	CHECK(lol::HashBytes("", 0) == (lol::Hash128{ 0, 0 }));
+	CHECK(lol::HashBytes("hello", 5) == (lol::Hash128{ 0xcbd8a7b341bd9b02ull, 0x5b1e906a48ae1d19ull }));
+
+	// 43 bytes: two full blocks and a tail longer than 8 bytes
+	const std::string fox = "The quick brown fox jumps over the lazy dog";
+	CHECK(lol::HashBytes(fox.data(), fox.size()) == (lol::Hash128{ 0xe34bbc7bbc071b6cull, 0x7a433ca9c49a9347ull }));
+	CHECK(lol::HashBytes(fox.data(), fox.size(), 42) == (lol::Hash128{ 0x740dcf93fe0bd5d7ull, 0xc4546cf4ec705c8full }));
+
+	CHECK((lol::Hash128{ 0x0123456789abcdefull, 0xfedcba9876543210ull }).ToString() == "fedcba98765432100123456789abcdef");
+	CHECK(lol::HashCombine(lol::HashBytes("a", 1), lol::HashBytes("b", 1)) != lol::HashCombine(lol::HashBytes("b", 1), lol::HashBytes("a", 1)));
+}
+
+static void TestHalf()
+{
+	lol::VertexQuantizer quantizer({ { 2, lol::AttributeEncoding::Half } });
+	lol::QuantizedVertices result = quantizer.Quantize({
+		1.0f, -2.0f,
+		0.1f, 1.0f / 3.0f,
+		65504.0f, 65520.0f,			// Largest half, and the first value that rounds to infinity
+		5.9604645e-8f, 1e-8f,		// Smallest subnormal half, and a value that rounds to zero
+		-0.0f, 1.00048828125f		// Exactly halfway between 1 and the next half, rounds to even
+	});
+
+	const uint16_t expected[] = { 0x3C00, 0xC000, 0x2E66, 0x3555, 0x7BFF, 0x7C00, 0x0001, 0x0000, 0x8000, 0x3C00 };
+	CHECK(result.layout.GetStride() == 4);
+	CHECK(result.data.size() == sizeof(expected));
+	for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]) && i * 2 < result.data.size(); i++)
+		CHECK(ReadAt<uint16_t>(result.data, i * 2) == expected[i]);
+}
+
+static void TestOctahedral()
+{
+	lol::VertexQuantizer quantizer({ { 3, lol::AttributeEncoding::Octahedral16 } });
+	lol::QuantizedVertices result = quantizer.Quantize({
+		0.0f, 0.0f, 1.0f,
+		1.0f, 0.0f, 0.0f,
+		0.0f, -1.0f, 0.0f,
+		0.0f, 0.0f, -1.0f			// The lower pole folds into the corner
+	});
+
+	const int16_t expected[] = { 0, 0, 32767, 0, 0, -32767, 32767, 32767 };
+	CHECK(result.layout.GetStride() == 4);
+	CHECK(result.data.size() == sizeof(expected));
+	for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]) && i * 2 < result.data.size(); i++)
+		CHECK(ReadAt<int16_t>(result.data, i * 2) == expected[i]);
+}
+
+static void TestQuantizerLayout()
+{
+	lol::VertexQuantizer quantizer({
+		{ 3, lol::AttributeEncoding::Bounds16 },
+		{ 4, lol::AttributeEncoding::Packed1010102 },
+		{ 3, lol::AttributeEncoding::UNorm8 }
+	});
+	CHECK(quantizer.GetSourceStride() == 10);
+
+	lol::QuantizedVertices result = quantizer.Quantize({
+		0.0f, 0.0f, 0.0f, 	1.0f, 0.0f, -1.0f, 1.0f, 	1.0f, 0.5f, 0.0f,
+		2.0f, 4.0f, -1.0f, 	0.0f, 1.0f, 0.0f, -1.0f, 	0.0f, 0.0f, 1.0f
+	});
+
+	CHECK(result.vertexCount == 2);
+	CHECK(result.layout.GetStride() == 16);
+	CHECK(result.data.size() == 32);
+
+	// Positions span their bounding box, the padded w reads as 1
+	CHECK(result.dequantization[0].scale == glm::vec4(2.0f, 4.0f, 1.0f, 1.0f));
+	CHECK(result.dequantization[0].offset == glm::vec4(0.0f, 0.0f, -1.0f, 0.0f));
+	CHECK(ReadAt<uint16_t>(result.data, 0) == 0 && ReadAt<uint16_t>(result.data, 2) == 0);
+	CHECK(ReadAt<uint16_t>(result.data, 4) == 0xFFFF && ReadAt<uint16_t>(result.data, 6) == 0xFFFF);
+	CHECK(ReadAt<uint16_t>(result.data, 16) == 0xFFFF && ReadAt<uint16_t>(result.data, 18) == 0xFFFF);
+	CHECK(ReadAt<uint16_t>(result.data, 20) == 0);
+
+	// 1 -> 1023, 0 -> 512 (511.5 rounded away from zero), -1 -> 0, positive sign -> 3
+	CHECK(ReadAt<uint32_t>(result.data, 8) == (1023u | (512u << 10) | (0u << 20) | (3u << 30)));
+	CHECK(ReadAt<uint32_t>(result.data, 24) == (512u | (1023u << 10) | (512u << 20) | (0u << 30)));
+	CHECK(result.dequantization[1].scale == glm::vec4(2.0f) && result.dequantization[1].offset == glm::vec4(-1.0f));
+
+	const uint8_t color[] = { 255, 128, 0, 255 };
+	CHECK(std::memcmp(result.data.data() + 12, color, 4) == 0);
+}
+
+static void TestSkylinePacker()
+{
+	lol::SkylinePacker packer(10, 10);
+	glm::uvec2 position;
+
+	CHECK(packer.Insert(6, 4, position) && position == glm::uvec2(0, 0));
+	CHECK(packer.Insert(4, 6, position) && position == glm::uvec2(6, 0));
+	CHECK(packer.Insert(6, 6, position) && position == glm::uvec2(0, 4));
+	CHECK(packer.Insert(4, 4, position) && position == glm::uvec2(6, 6));
+	CHECK(!packer.Insert(1, 1, position));
+	CHECK(!packer.Insert(11, 1, position));
+}
+
+static void TestObjectPool()
+{
+	lol::ObjectPool<int> pool;
+
+	lol::Handle<int> first = pool.Create(1);
+	CHECK(first.index == 0 && first.generation == 1);
+	CHECK(pool.Resolve(first) != nullptr && *pool.Resolve(first) == 1);
+
+	CHECK(pool.Destroy(first));
+	CHECK(!pool.Destroy(first));
+	CHECK(pool.Resolve(first) == nullptr);
+
+	// The slot is reused with the next generation, so the old Handle stays dead
+	lol::Handle<int> second = pool.Create(2);
+	CHECK(second.index == 0 && second.generation == 2);
+	CHECK(!pool.IsValid(first) && pool.IsValid(second));
+
+	lol::Handle<int> third = pool.Create(3);
+	std::shared_ptr<int> locked = pool.Lock(third);
+	pool.Clear();
+	CHECK(pool.Size() == 0 && !pool.IsValid(second) && !pool.IsValid(third));
+	CHECK(locked != nullptr && *locked == 3);
+
+	CHECK(!lol::Handle<int>{} && !pool.IsValid(lol::Handle<int>{}));
+}
+
+static void TestCountPrimitives()
+{
+	CHECK(lol::RenderStats::CountPrimitives(lol::DrawMode::Points, 7) == 7);
+	CHECK(lol::RenderStats::CountPrimitives(lol::DrawMode::Lines, 5) == 2);
+	CHECK(lol::RenderStats::CountPrimitives(lol::DrawMode::LineStrip, 4) == 3);
+	CHECK(lol::RenderStats::CountPrimitives(lol::DrawMode::LineLoop, 4) == 4);
+	CHECK(lol::RenderStats::CountPrimitives(lol::DrawMode::Triangles, 7) == 2);
+	CHECK(lol::RenderStats::CountPrimitives(lol::DrawMode::TriangleStrip, 5) == 3);
+	CHECK(lol::RenderStats::CountPrimitives(lol::DrawMode::TriangleFan, 5) == 3);
+	CHECK(lol::RenderStats::CountPrimitives(lol::DrawMode::TriangleStrip, 2) == 0);
+}
+
+static void TestConvertOBJ()
+{
+	std::istringstream obj(
+		"# two quads in two groups, sharing an edge\n"
+		"v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nv 2 0 0\nv 2 1 0\n"
+		"g left\nf 1 2 3 4\n"
+		"g right\nf 2 5 6 -4\n"
+	);
+
+	lol::MeshData mesh = lol::ConvertOBJ(obj, lol::MeshConvertOptions{ false });
+
+	// Fans of (0 1 2 3) and (1 4 5 2), the shared corners are only stored once
+	const std::vector<uint32_t> indices = { 0, 1, 2, 0, 2, 3, 1, 4, 5, 1, 5, 2 };
+	CHECK(mesh.indices == indices);
+	CHECK(mesh.vertices.vertexCount == 6);
+	CHECK(mesh.vertices.layout.GetStride() == 12);
+
+	CHECK(mesh.submeshes.size() == 2);
+	if (mesh.submeshes.size() == 2)
+	{
+		CHECK(mesh.submeshes[0].firstIndex == 0 && mesh.submeshes[0].indexCount == 6);
+		CHECK(mesh.submeshes[1].firstIndex == 6 && mesh.submeshes[1].indexCount == 6);
+		CHECK(mesh.submeshes[1].bounds.x == 1.0f && mesh.submeshes[1].bounds.w == 1.0f);
+	}
+
+	CHECK(mesh.bounds.x == 0.0f && mesh.bounds.w == 2.0f && mesh.bounds.h == 1.0f && mesh.bounds.d == 0.0f);
+	CHECK(ReadAt<float>(mesh.vertices.data, 4 * 12) == 2.0f);
+
+	std::istringstream broken("v 0 0 0\nf 1 2 3\n");
+	bool threw = false;
+	try { lol::ConvertOBJ(broken, lol::MeshConvertOptions{}); }
+	catch (const lol::MeshFileException&) { threw = true; }
+	CHECK(threw);
+}
+
+int main()
+{
+	TestHash();
+	TestHalf();
+	TestOctahedral();
+	TestQuantizerLayout();
+	TestSkylinePacker();
+	TestObjectPool();
+	TestCountPrimitives();
+	TestConvertOBJ();
+
+	if (failures > 0)
+		std::fprintf(stderr, "%d checks failed\n", failures);
+
+	return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,145 @@
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include <lol/lol.hpp>
+#include <lol/util/HeadlessContext.hpp>
+
+// Regression tests that render into a HeadlessContext, e.g. with llvmpipe.
+// Unlike assert() the checks stay active in release builds, and every failure is reported.
+static int failures = 0;
+
+#define CHECK(condition) \
+	do { if (!(condition)) { std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); failures++; } } while (false)
+
+static const char* vertexShader = R"(
+#version 330 core
+layout (location = 0) in vec2 position;
+uniform vec2 offset;
+void main() { gl_Position = vec4(position + offset, 0.0, 1.0); }
+)";
+
+static const char* greenShader = "#version 330 core\nout vec4 color;\nvoid main() { color = vec4(0.0, 1.0, 0.0, 1.0); }\n";
+static const char* blueShader = "#version 330 core\nout vec4 color;\nvoid main() { color = vec4(0.0, 0.0, 1.0, 1.0); }\n";
+static const char* brokenShader = "#version 330 core\nout vec4 color;\nvoid main() { color = undeclared; }\n";
+
+/**
+ * A Drawable that records an offset uniform, or nothing at all
+ */
+class Quad : public lol::Drawable
+{
+public:
+	Quad(const std::shared_ptr<lol::Shader>& shader, const std::shared_ptr<lol::VertexArray>& vao, bool withUniforms) :
+		withUniforms(withUniforms)
+	{
+		this->shader = shader;
+		this->vao = vao;
+	}
+
+	void PreRecord(lol::CommandBuffer& commands, const lol::CameraBase& camera) override
+	{
+		if (withUniforms)
+			commands.SetUniform(0, glm::vec2(0.0f));
+	}
+
+private:
+	bool withUniforms;
+};
+
+/**
+ * A quad spanning [left, right] horizontally and the whole height
+ */
+static std::shared_ptr<lol::VertexArray> MakeQuad(float left, float right)
+{
+	auto vertices = std::make_shared<lol::VertexBuffer>(std::vector<float>{ left, -1.0f, right, -1.0f, right, 1.0f, left, 1.0f });
+	vertices->SetLayout({ lol::VertexAttribute(lol::Type::Float, 2, false) });
+
+	return std::make_shared<lol::VertexArray>(vertices, std::make_shared<lol::ElementBuffer>(std::vector<unsigned int>{ 0, 1, 2, 0, 2, 3 }));
+}
+
+static uint32_t ReadPixel(int x, int y)
+{
+	uint8_t pixel[4];
+	glReadPixels(x, y, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+	return ((uint32_t)pixel[0] << 16) | ((uint32_t)pixel[1] << 8) | pixel[2];
+}
+
+static void Clear()
+{
+	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT);
+}
+
+// A Drawable whose shader isn't ready records the VAO bind that the next Drawable relies on
+static void TestSharedVertexArrayAfterPendingShader()
+{
+	auto left = MakeQuad(-1.0f, 0.0f);
+	auto right = MakeQuad(0.0f, 1.0f);
+	auto pending = std::make_shared<lol::Shader>(vertexShader, brokenShader);
+	auto ready = std::make_shared<lol::Shader>(vertexShader, greenShader);
+
+	lol::Drawable::SetFallbackShader(nullptr);
+	Quad skipped(pending, left, false);
+	Quad drawn(ready, left, false);
+
+	lol::OrthogonalCamera camera;
+	lol::CommandBuffer commands;
+	skipped.Record(commands, camera);
+	drawn.Record(commands, camera);
+
+	Clear();
+	right->Bind();
+	commands.Execute();
+
+	CHECK(ReadPixel(16, 32) == 0x00FF00);
+	CHECK(ReadPixel(48, 32) == 0x000000);
+}
+
+// The fallback can't take the recorded uniforms, so only Drawables without any are drawn with it
+static void TestFallbackSkipsUniforms()
+{
+	auto left = MakeQuad(-1.0f, 0.0f);
+	auto right = MakeQuad(0.0f, 1.0f);
+	auto pending = std::make_shared<lol::Shader>(vertexShader, brokenShader);
+	auto fallback = std::make_shared<lol::Shader>(vertexShader, blueShader);
+
+	lol::Drawable::SetFallbackShader(fallback);
+	Quad withUniforms(pending, left, true);
+	Quad withoutUniforms(pending, right, false);
+
+	lol::OrthogonalCamera camera;
+	lol::CommandBuffer uniformCommands, plainCommands;
+	withUniforms.Record(uniformCommands, camera);
+	withoutUniforms.Record(plainCommands, camera);
+
+	Clear();
+	uniformCommands.Execute();
+	plainCommands.Execute();
+
+	CHECK(ReadPixel(16, 32) == 0x000000);
+	CHECK(ReadPixel(48, 32) == 0x0000FF);
+
+	lol::Drawable::SetFallbackShader(nullptr);
+}
+
+int main()
+{
+	lol::HeadlessContext context(3, 3);
+	{
+		lol::Framebuffer framebuffer(64, 64);
+		framebuffer.Attach(lol::FramebufferAttachment::Color0, std::make_shared<lol::Renderbuffer>(64, 64, lol::TextureFormat::RGBA8));
+		framebuffer.Bind();
+		glViewport(0, 0, 64, 64);
+
+		TestSharedVertexArrayAfterPendingShader();
+		TestFallbackSkipsUniforms();
+
+		CHECK(glGetError() == GL_NO_ERROR);
+	}
+
+	if (failures > 0)
+		std::fprintf(stderr, "%d checks failed\n", failures);
+
+	return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,49 @@
+#include <cstring>
+#include <iostream>
+
+#include <lol/Mesh.hpp>
+#include <lol/util/MeshConverter.hpp>
+
+/**
+ * Converts a Wavefront OBJ file into a mesh file that lol::Mesh can load
+ *
+ * Usage: lol_meshconvert [--no-quantize] input.obj output.lolmesh
+ */
+int main(int argc, char** argv)
+{
+	lol::MeshConvertOptions options;
+	const char* paths[2] = { nullptr, nullptr };
+	int pathCount = 0;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "--no-quantize") == 0)
+			options.quantize = false;
+		else if (pathCount < 2)
+			paths[pathCount++] = argv[i];
+		else
+			pathCount++;
+	}
+
+	if (pathCount != 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " [--no-quantize] input.obj output.lolmesh" << std::endl;
+		return 1;
+	}
+
+	try
+	{
+		lol::MeshData mesh = lol::ConvertOBJ(std::string(paths[0]), options);
+		lol::Mesh::Write(mesh, paths[1]);
+
+		std::cout << paths[1] << ": " << mesh.vertices.vertexCount << " vertices of " << mesh.vertices.layout.GetStride() << " bytes, "
+			<< mesh.indices.size() << " indices, " << mesh.submeshes.size() << " submeshes" << std::endl;
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}